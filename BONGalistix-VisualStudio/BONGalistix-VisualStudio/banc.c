@@ -0,0 +1,1105 @@
+// -------------------------------------------
+/*
+librairie banc.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Bancs d'essai des structures et fonctions de la simulation.
+Note: les prototypes des fonctions se trouvent dans le fichier banc.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// mesure du temps coul
+#include <SDL_timer.h>
+// rendu logiciel des fonctions graph_* (banc du rendu)
+#include "graph_logiciel.h"
+
+#include "geometrie.h"
+#include "simulation.h"
+#include "grille.h"
+#include "bvh.h"
+#include "murs_simd.h"
+#include "vol_analytique.h"
+#include "banc.h"
+
+static unsigned int graine_banc=BANC_GRAINE;   // tat du gnrateur de nombres alatoires
+
+// ---------------------------------------------
+// requte de recherche du premier mur crois
+// ---------------------------------------------
+typedef struct {
+    double x0,y0,x1,y1;     // segment de trajectoire
+} t_requete_banc;
+
+// ---------------------------------------------
+/* fonction: banc_graine
+    Description:    fixe la graine du gnrateur de nombres alatoires des bancs d'essai.
+                    Le gnrateur est propre aux bancs pour que les niveaux gnrs soient
+                    les mmes sur toutes les plateformes.
+    Paramtre(s):   graine  nouvelle graine
+    Retour:         aucun
+*/
+void banc_graine(unsigned int graine)
+{
+    graine_banc=graine;
+}
+
+// ---------------------------------------------
+/* fonction: banc_hasard
+    Description:    nombre entier alatoire (gnrateur congruentiel linaire)
+    Paramtre(s):   min,max     bornes du nombre  tirer (inclusives)
+    Retour:         un nombre entier entre min et max
+    Ex. d'utilisation:
+                    x=banc_hasard(0,399);
+*/
+int banc_hasard(int min, int max)
+{
+    graine_banc=graine_banc*1664525u+1013904223u;
+    return min+(int)((graine_banc>>8)%(unsigned int)(max-min+1));
+}
+
+// ---------------------------------------------
+/* fonction: generer_murs
+    Description:    gnre un tableau de murs horizontaux et verticaux dans une zone carre
+                    (0,0)-(cote,cote). Les 4 premiers murs sont le contour de la zone,
+                    comme dans les fichiers de niveau, les autres sont placs au hasard.
+    Paramtre(s):   nb_murs     nb de murs  gnrer (au moins 4)
+                    cote        ct de la zone de jeu
+    Retour:         le tableau de murs allou ( librer avec free), NULL en cas d'erreur
+    Ex. d'utilisation:
+                    int (*tab_murs)[COL_TABSEG]=generer_murs(1000,632);
+*/
+int (*generer_murs(int nb_murs, int cote))[COL_TABSEG]
+{
+    int (*tab_murs)[COL_TABSEG];
+    int i,longueur;
+
+    if (nb_murs<4) return NULL;
+    tab_murs=(int (*)[COL_TABSEG])malloc(nb_murs*sizeof(*tab_murs));
+    if (tab_murs==NULL) return NULL;
+
+    // contour
+    tab_murs[0][X0]=0;    tab_murs[0][Y0]=0;    tab_murs[0][X1]=cote; tab_murs[0][Y1]=0;
+    tab_murs[1][X0]=cote; tab_murs[1][Y0]=0;    tab_murs[1][X1]=cote; tab_murs[1][Y1]=cote;
+    tab_murs[2][X0]=cote; tab_murs[2][Y0]=cote; tab_murs[2][X1]=0;    tab_murs[2][Y1]=cote;
+    tab_murs[3][X0]=0;    tab_murs[3][Y0]=cote; tab_murs[3][X1]=0;    tab_murs[3][Y1]=0;
+
+    for (i=4;i<nb_murs;i++){
+        longueur=banc_hasard(BANC_LONGUEUR_MIN_MUR,BANC_LONGUEUR_MAX_MUR);
+        tab_murs[i][X0]=banc_hasard(1,cote-longueur-1);
+        tab_murs[i][Y0]=banc_hasard(1,cote-longueur-1);
+        if (banc_hasard(0,1)){
+            tab_murs[i][X1]=tab_murs[i][X0]+longueur;
+            tab_murs[i][Y1]=tab_murs[i][Y0];
+        }
+        else{
+            tab_murs[i][X1]=tab_murs[i][X0];
+            tab_murs[i][Y1]=tab_murs[i][Y0]+longueur;
+        }
+    }
+    return tab_murs;
+}
+
+// ---------------------------------------------
+/* fonction: compiler_murs
+    Description:    compile chaque mur comme au chargement d'un niveau (voir compiler_segment)
+    Paramtre(s):   tab_murs,nb_murs    murs du niveau gnr
+    Retour:         le tableau des murs compils allou ( librer avec free), NULL en cas d'erreur
+*/
+static t_segment_compile* compiler_murs(int tab_murs[][COL_TABSEG], int nb_murs)
+{
+    t_segment_compile* tab_compiles=(t_segment_compile*)malloc(nb_murs*sizeof(t_segment_compile));
+    int i;
+
+    if (tab_compiles==NULL) return NULL;
+    for (i=0;i<nb_murs;i++){
+        compiler_segment(tab_murs[i][X0],tab_murs[i][Y0],tab_murs[i][X1],tab_murs[i][Y1],&tab_compiles[i]);
+    }
+    return tab_compiles;
+}
+
+// ---------------------------------------------
+/* fonction: premier_mur_lineaire
+    Description:    recherche de rfrence du premier mur crois: tous les murs sont tests
+    Paramtre(s):   tab_compiles,nb_murs    murs compils du niveau gnr
+                    r                       segment de trajectoire
+                    xr,yr                   adresses o placer le point d'impact
+    Retour:         l'indice du mur crois, -1 si aucun mur n'est crois
+*/
+static int premier_mur_lineaire(t_segment_compile tab_compiles[], int nb_murs,
+                                t_requete_banc* r, double* xr, double* yr)
+{
+    double xi,yi,d,d_min=HUGE_VAL;
+    int i,mur=-1;
+
+    for (i=0;i<nb_murs;i++){
+        if (intersection_segment_compile(r->x0,r->y0,r->x1,r->y1,&tab_compiles[i],&xi,&yi)){
+            d=(xi-r->x0)*(xi-r->x0)+(yi-r->y0)*(yi-r->y0);
+            if (d<d_min){
+                d_min=d;
+                mur=i;
+                *xr=xi;
+                *yr=yi;
+            }
+        }
+    }
+    return mur;
+}
+
+// ---------------------------------------------
+/* fonction: generer_requetes
+    Description:    gnre des segments de trajectoire de dpart alatoire dans la zone de jeu
+    Paramtre(s):   tab_requetes    tableau  remplir
+                    nb_requetes     nb de segments  gnrer
+                    cote            ct de la zone de jeu
+                    longueur        longueur maximum des segments selon chaque axe
+    Retour:         aucun
+*/
+static void generer_requetes(t_requete_banc tab_requetes[], int nb_requetes, int cote, int longueur)
+{
+    int i;
+    for (i=0;i<nb_requetes;i++){
+        tab_requetes[i].x0=banc_hasard(100,100*(cote-1))/100.0;
+        tab_requetes[i].y0=banc_hasard(100,100*(cote-1))/100.0;
+        tab_requetes[i].x1=tab_requetes[i].x0+banc_hasard(-100*longueur,100*longueur)/100.0;
+        tab_requetes[i].y1=tab_requetes[i].y0+banc_hasard(-100*longueur,100*longueur)/100.0;
+    }
+}
+
+// ---------------------------------------------
+/* fonction: temps_ns
+    Description:    temps coul depuis une mesure du compteur, en nanosecondes par opration
+    Paramtre(s):   debut   valeur du compteur au dbut de la mesure
+                    nb      nb d'oprations mesures
+    Retour:         le temps moyen d'une opration (ns)
+*/
+static double temps_ns(Uint64 debut, int nb)
+{
+    return 1e9*(double)(SDL_GetPerformanceCounter()-debut)/SDL_GetPerformanceFrequency()/nb;
+}
+
+// ---------------------------------------------
+/* fonction: mesurer_requetes
+    Description:    mesure le temps moyen de recherche du premier mur crois pour une srie
+                    de segments, avec l'index demand, et compte les rsultats diffrents
+                    de ceux de la recherche de rfrence (si fournis)
+    Paramtre(s):   index_murs          INDEX_MURS_AUCUN, INDEX_MURS_GRILLE ou INDEX_MURS_BVH
+                    grille,bvh          index des murs
+                    tab_compiles        murs compils du niveau gnr
+                    nb_murs             nb de murs
+                    tab_requetes        segments  chercher
+                    nb_requetes         nb de segments
+                    tab_reference       murs trouvs par la recherche de rfrence (NULL: aucune comparaison)
+                    tab_trouves         tableau  remplir avec les murs trouvs (NULL accept)
+                    nb_differences      adresse o ajouter le nb de rsultats diffrents
+    Retour:         le temps moyen d'une recherche (ns)
+*/
+static double mesurer_requetes(int index_murs, t_grille* grille, t_bvh* bvh,
+                               t_segment_compile tab_compiles[], int nb_murs,
+                               t_requete_banc tab_requetes[], int nb_requetes,
+                               int tab_reference[], int tab_trouves[], int* nb_differences)
+{
+    Uint64 debut;
+    double xr,yr,ns;
+    int i,mur;
+    t_requete_banc* r;
+
+    debut=SDL_GetPerformanceCounter();
+    for (i=0;i<nb_requetes;i++){
+        r=&tab_requetes[i];
+        if (index_murs==INDEX_MURS_GRILLE) mur=grille_premier_mur(grille,tab_compiles,r->x0,r->y0,r->x1,r->y1,&xr,&yr);
+        else if (index_murs==INDEX_MURS_BVH) mur=bvh_premier_mur(bvh,tab_compiles,r->x0,r->y0,r->x1,r->y1,&xr,&yr);
+        else mur=premier_mur_lineaire(tab_compiles,nb_murs,r,&xr,&yr);
+        if (tab_trouves!=NULL) tab_trouves[i]=mur;
+    }
+    ns=temps_ns(debut,nb_requetes);
+
+    if (tab_reference!=NULL && tab_trouves!=NULL){
+        for (i=0;i<nb_requetes;i++){
+            if (tab_trouves[i]!=tab_reference[i]) (*nb_differences)++;
+        }
+    }
+    return ns;
+}
+
+// ---------------------------------------------
+/* fonction: banc_index_murs
+    Description:    compare les index spatiaux des murs (grille uniforme et arbre) sur un
+                    niveau gnr de nb_murs murs:
+                    - temps de construction, nb de noeuds, profondeur et cot estim
+                      (heuristique des surfaces) de l'arbre
+                    - temps moyen de recherche du premier mur crois pour des segments
+                      courts (un pas de simulation) et longs (un quart de la zone)
+                    - temps moyen de recherche des murs touchant un rectangle de la taille
+                      de la fentre
+                    La recherche sans index sert de rfrence pour vrifier les rsultats;
+                    elle est limite  une partie des requtes quand le niveau est grand.
+    Paramtre(s):   nb_murs     nb de murs du niveau gnr
+    Retour:         le nb de rsultats diffrents de la rfrence (0 si tout concorde),
+                    -1 en cas d'erreur d'allocation
+    Ex. d'utilisation:
+                    banc_index_murs(10000);
+*/
+int banc_index_murs(int nb_murs)
+{
+    int cote=(int)(BANC_ESPACE_PAR_MUR*sqrt((double)nb_murs));
+    int (*tab_murs)[COL_TABSEG];
+    t_segment_compile* tab_compiles=NULL;
+    t_requete_banc* tab_requetes=NULL;
+    int* tab_reference=NULL;
+    int* tab_trouves=NULL;
+    int* tab_visibles=NULL;
+    t_grille* grille=NULL;
+    t_bvh* bvh=NULL;
+    Uint64 debut;
+    double ms_grille,ms_bvh,ns_lin,ns_grille,ns_bvh;
+    int nb_lin,nb_differences=0,type,longueur,i,j,x,y,nb_bvh,nb_lin_rect;
+
+    banc_graine(BANC_GRAINE+nb_murs);
+    tab_murs=generer_murs(nb_murs,cote);
+    tab_requetes=(t_requete_banc*)malloc(BANC_NB_REQUETES*sizeof(t_requete_banc));
+    tab_reference=(int*)malloc(BANC_NB_REQUETES*sizeof(int));
+    tab_trouves=(int*)malloc(BANC_NB_REQUETES*sizeof(int));
+    tab_visibles=(int*)malloc(nb_murs*sizeof(int));
+    if (tab_murs!=NULL) tab_compiles=compiler_murs(tab_murs,nb_murs);
+    if (tab_compiles!=NULL){
+        // construction
+        debut=SDL_GetPerformanceCounter();
+        grille=construire_grille(tab_murs,nb_murs);
+        ms_grille=temps_ns(debut,1000000);
+        debut=SDL_GetPerformanceCounter();
+        bvh=construire_bvh(tab_murs,nb_murs);
+        ms_bvh=temps_ns(debut,1000000);
+    }
+    if (grille==NULL || bvh==NULL || tab_requetes==NULL || tab_reference==NULL ||
+        tab_trouves==NULL || tab_visibles==NULL){
+        printf("%d murs: memoire insuffisante\n",nb_murs);
+        liberer_grille(grille);
+        liberer_bvh(bvh);
+        free(tab_murs);
+        free(tab_compiles);
+        free(tab_requetes);
+        free(tab_reference);
+        free(tab_trouves);
+        free(tab_visibles);
+        return -1;
+    }
+
+    printf("%d murs (zone de %dx%d):\n",nb_murs,cote,cote);
+    printf("  construction: grille %8.3lf ms (%dx%d cases), arbre %8.3lf ms\n",
+           ms_grille,grille->nb_col,grille->nb_lig,ms_bvh);
+    printf("  arbre: %d noeuds, profondeur %d, cout estime %.1lf tests (%d sans index)\n",
+           bvh->nb_noeuds,profondeur_bvh(bvh),cout_bvh(bvh),nb_murs);
+
+    // recherche du premier mur crois: segments courts puis longs
+    nb_lin=(int)fmin(BANC_NB_REQUETES,BANC_TESTS_LINEAIRES/nb_murs);
+    for (type=0;type<2;type++){
+        longueur=(type==0)?(int)(V_INITIALE_MAX*DELTAT):cote/4;
+        generer_requetes(tab_requetes,BANC_NB_REQUETES,cote,longueur);
+        ns_lin=mesurer_requetes(INDEX_MURS_AUCUN,grille,bvh,tab_compiles,nb_murs,
+                                tab_requetes,nb_lin,NULL,tab_reference,&nb_differences);
+        ns_grille=mesurer_requetes(INDEX_MURS_GRILLE,grille,bvh,tab_compiles,nb_murs,
+                                   tab_requetes,BANC_NB_REQUETES,NULL,tab_trouves,&nb_differences);
+        mesurer_requetes(INDEX_MURS_GRILLE,grille,bvh,tab_compiles,nb_murs,
+                         tab_requetes,nb_lin,tab_reference,tab_trouves,&nb_differences);
+        ns_bvh=mesurer_requetes(INDEX_MURS_BVH,grille,bvh,tab_compiles,nb_murs,
+                                tab_requetes,BANC_NB_REQUETES,NULL,tab_trouves,&nb_differences);
+        mesurer_requetes(INDEX_MURS_BVH,grille,bvh,tab_compiles,nb_murs,
+                         tab_requetes,nb_lin,tab_reference,tab_trouves,&nb_differences);
+        printf("  segments %-6s (<=%5d): sans index %10.1lf ns, grille %8.1lf ns, arbre %8.1lf ns\n",
+               type==0?"courts":"longs",longueur,ns_lin,ns_grille,ns_bvh);
+    }
+
+    // recherche des murs touchant un rectangle de la taille de la fentre
+    nb_bvh=nb_lin_rect=0;
+    debut=SDL_GetPerformanceCounter();
+    banc_graine(BANC_GRAINE);
+    for (i=0;i<BANC_NB_REQUETES/100;i++){
+        x=banc_hasard(0,cote);
+        y=banc_hasard(0,cote);
+        nb_bvh+=bvh_murs_dans_rectangle(bvh,tab_compiles,x,y,x+BANC_COTE_FENETRE,y+BANC_COTE_FENETRE,
+                                        tab_visibles,nb_murs);
+    }
+    ns_bvh=temps_ns(debut,BANC_NB_REQUETES/100);
+    debut=SDL_GetPerformanceCounter();
+    banc_graine(BANC_GRAINE);
+    for (i=0;i<BANC_NB_REQUETES/100;i++){
+        x=banc_hasard(0,cote);
+        y=banc_hasard(0,cote);
+        for (j=0;j<nb_murs;j++){
+            if (tab_compiles[j].x_max>=x && tab_compiles[j].x_min<=x+BANC_COTE_FENETRE &&
+                tab_compiles[j].y_max>=y && tab_compiles[j].y_min<=y+BANC_COTE_FENETRE)
+                nb_lin_rect++;
+        }
+    }
+    ns_lin=temps_ns(debut,BANC_NB_REQUETES/100);
+    if (nb_bvh!=nb_lin_rect) nb_differences++;
+    printf("  murs visibles (%dx%d, %.0lf murs en moyenne): sans index %10.1lf ns, arbre %8.1lf ns\n",
+           BANC_COTE_FENETRE,BANC_COTE_FENETRE,(double)nb_bvh/(BANC_NB_REQUETES/100),ns_lin,ns_bvh);
+    printf("  resultats differents de la recherche sans index: %d\n",nb_differences);
+
+    liberer_grille(grille);
+    liberer_bvh(bvh);
+    free(tab_murs);
+    free(tab_compiles);
+    free(tab_requetes);
+    free(tab_reference);
+    free(tab_trouves);
+    free(tab_visibles);
+    return nb_differences;
+}
+
+// ---------------------------------------------
+/* fonction: banc_noyau_collision
+    Description:    compare le test d'intersection gnrique (intersection_segments) aux
+                    tests spcialiss des murs horizontaux et verticaux
+                    (intersection_segments_orientes) de deux faons:
+                    1-par test: chaque segment d'une srie de segments de trajectoire
+                      (courts puis longs) est test contre chaque mur d'un niveau gnr,
+                      aussi avec le test du mur compil (intersection_segment_compile)
+                      qui doit donner exactement le mme rsultat que le test spcialis
+                    2-par tir: tous les tirs de chaque niveau du jeu sont simuls avec les
+                      murs classs au chargement, puis avec tous les murs traits comme
+                      obliques (test gnrique)
+                    Les rsultats des deux mthodes sont compars: croisements diffrents
+                    et cart maximum entre les points d'impact, puis issues de tirs
+                    diffrentes.
+    Paramtre(s):   aucun
+    Retour:         le nb de tests dont le rsultat (croisement ou non) diffre entre les
+                    deux mthodes, -1 en cas d'erreur d'allocation
+    Ex. d'utilisation:
+                    banc_noyau_collision();
+*/
+int banc_noyau_collision()
+{
+    int cote=(int)(BANC_ESPACE_PAR_MUR*sqrt((double)BANC_MURS_NOYAU));
+    int nb_requetes=BANC_NB_REQUETES/100;
+    int (*tab_murs)[COL_TABSEG];
+    t_segment_compile* tab_compiles=NULL;
+    t_requete_banc* tab_requetes=NULL;
+    t_requete_banc* r;
+    t_niveau niv;
+    t_resultat_tir resultat;
+    int* tab_classes;               // orientation de chaque mur du niveau
+    int* tab_issues=NULL;
+    Uint64 debut;
+    double ns_generique,ns_oriente,ns_compile,x,y,xs,ys,ecart_max=0;
+    int type,longueur,i,j,niveau,vx,vy,methode,k,nb_tirs;
+    int nb_croisements,nb_differences=0,nb_tirs_differents;
+    double tab_us[2];
+
+    banc_graine(BANC_GRAINE);
+    tab_murs=generer_murs(BANC_MURS_NOYAU,cote);
+    if (tab_murs!=NULL) tab_compiles=compiler_murs(tab_murs,BANC_MURS_NOYAU);
+    tab_requetes=(t_requete_banc*)malloc(nb_requetes*sizeof(t_requete_banc));
+    tab_issues=(int*)malloc((2*V_INITIALE_MAX+1)*(2*V_INITIALE_MAX+1)*sizeof(int));
+    if (tab_compiles==NULL || tab_requetes==NULL || tab_issues==NULL){
+        printf("memoire insuffisante\n");
+        free(tab_murs);
+        free(tab_compiles);
+        free(tab_requetes);
+        free(tab_issues);
+        return -1;
+    }
+
+    // 1-par test
+    printf("Par test (%d segments x %d murs):\n",nb_requetes,BANC_MURS_NOYAU);
+    for (type=0;type<2;type++){
+        longueur=(type==0)?(int)(V_INITIALE_MAX*DELTAT):cote/4;
+        generer_requetes(tab_requetes,nb_requetes,cote,longueur);
+
+        nb_croisements=0;
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<nb_requetes;i++){
+            r=&tab_requetes[i];
+            for (j=0;j<BANC_MURS_NOYAU;j++){
+                nb_croisements+=intersection_segments(r->x0,r->y0,r->x1,r->y1,
+                                                      tab_murs[j][X0],tab_murs[j][Y0],tab_murs[j][X1],tab_murs[j][Y1],
+                                                      &x,&y);
+            }
+        }
+        ns_generique=temps_ns(debut,nb_requetes*BANC_MURS_NOYAU);
+
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<nb_requetes;i++){
+            r=&tab_requetes[i];
+            for (j=0;j<BANC_MURS_NOYAU;j++){
+                nb_croisements-=intersection_segments_orientes(r->x0,r->y0,r->x1,r->y1,
+                                                               tab_murs[j][X0],tab_murs[j][Y0],tab_murs[j][X1],tab_murs[j][Y1],
+                                                               tab_compiles[j].orientation,&x,&y);
+            }
+        }
+        ns_oriente=temps_ns(debut,nb_requetes*BANC_MURS_NOYAU);
+
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<nb_requetes;i++){
+            r=&tab_requetes[i];
+            for (j=0;j<BANC_MURS_NOYAU;j++){
+                intersection_segment_compile(r->x0,r->y0,r->x1,r->y1,&tab_compiles[j],&x,&y);
+            }
+        }
+        ns_compile=temps_ns(debut,nb_requetes*BANC_MURS_NOYAU);
+
+        // comparer les rsultats test par test
+        for (i=0;i<nb_requetes;i++){
+            r=&tab_requetes[i];
+            for (j=0;j<BANC_MURS_NOYAU;j++){
+                k=intersection_segments(r->x0,r->y0,r->x1,r->y1,
+                                        tab_murs[j][X0],tab_murs[j][Y0],tab_murs[j][X1],tab_murs[j][Y1],
+                                        &x,&y);
+                if (k!=intersection_segments_orientes(r->x0,r->y0,r->x1,r->y1,
+                                                      tab_murs[j][X0],tab_murs[j][Y0],tab_murs[j][X1],tab_murs[j][Y1],
+                                                      tab_compiles[j].orientation,&xs,&ys)) nb_differences++;
+                else if (k) ecart_max=fmax(ecart_max,fmax(fabs(x-xs),fabs(y-ys)));
+                // le test du mur compil doit donner exactement le rsultat du test spcialis
+                k=intersection_segment_compile(r->x0,r->y0,r->x1,r->y1,&tab_compiles[j],&x,&y);
+                if (k!=intersection_segments_orientes(r->x0,r->y0,r->x1,r->y1,
+                                                      tab_murs[j][X0],tab_murs[j][Y0],tab_murs[j][X1],tab_murs[j][Y1],
+                                                      tab_compiles[j].orientation,&xs,&ys) ||
+                    (k && (x!=xs || y!=ys))) nb_differences++;
+            }
+        }
+        printf("  segments %-6s (<=%4d): generique %6.2lf ns, specialise %6.2lf ns (x%.1lf), compile %6.2lf ns (x%.1lf)%s\n",
+               type==0?"courts":"longs",longueur,ns_generique,ns_oriente,ns_generique/ns_oriente,
+               ns_compile,ns_generique/ns_compile,
+               nb_croisements!=0?" (croisements differents)":"");
+    }
+    printf("  croisements differents: %d, ecart maximum entre les points d'impact: %.3g\n",
+           nb_differences,ecart_max);
+
+    // 2-par tir
+    printf("Par tir (vitesses initiales espacees de %d):\n",BANC_PAS_TIRS);
+    initialiser_niveau(&niv);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        if (charger_niveau(niveau,&niv)<0) continue;
+        tab_classes=(int*)malloc(niv.nb_segments*sizeof(int));
+        if (tab_classes==NULL) continue;
+        for (i=0;i<niv.nb_segments;i++) tab_classes[i]=niv.tab_murs[i].orientation;
+
+        nb_tirs_differents=0;
+        for (methode=0;methode<2;methode++){
+            // methode 0: murs classs, methode 1: test gnrique pour tous les murs
+            for (i=0;i<niv.nb_segments;i++) niv.tab_murs[i].orientation=methode?SEGMENT_OBLIQUE:tab_classes[i];
+            nb_tirs=k=0;
+            debut=SDL_GetPerformanceCounter();
+            for (vy=-V_INITIALE_MAX;vy<=V_INITIALE_MAX;vy+=BANC_PAS_TIRS){
+                for (vx=-V_INITIALE_MAX;vx<=V_INITIALE_MAX;vx+=BANC_PAS_TIRS){
+                    if (vx*vx+vy*vy>V_INITIALE_MAX*V_INITIALE_MAX) continue;
+                    simuler_tir(&niv,vx,vy,&resultat);
+                    j=resultat.touche+2*resultat.nb_rebonds+65536*resultat.nb_pas;
+                    if (methode==0) tab_issues[k]=j;
+                    else if (tab_issues[k]!=j) nb_tirs_differents++;
+                    k++;
+                    nb_tirs++;
+                }
+            }
+            tab_us[methode]=temps_ns(debut,nb_tirs)/1000;
+        }
+        free(tab_classes);
+        printf("  niveau %2d (%2d murs): generique %7.2lf us/tir, specialise %7.2lf us/tir (x%.2lf), %d tirs differents sur %d\n",
+               niveau,niv.nb_segments,tab_us[1],tab_us[0],tab_us[1]/tab_us[0],nb_tirs_differents,nb_tirs);
+    }
+    liberer_niveau(&niv);
+
+    free(tab_murs);
+    free(tab_compiles);
+    free(tab_requetes);
+    free(tab_issues);
+    return nb_differences;
+}
+
+// ---------------------------------------------
+/* fonction: impact_mur
+    Description:    point d'impact d'un segment de trajectoire sur un mur
+    Paramtre(s):   tab_compiles        murs compils du niveau gnr
+                    r                   segment de trajectoire
+                    mur                 indice du mur
+                    xr,yr               adresses o placer le point d'impact
+    Retour:         1 si le segment croise le mur, 0 sinon
+*/
+static int impact_mur(t_segment_compile tab_compiles[], t_requete_banc* r, int mur,
+                      double* xr, double* yr)
+{
+    return intersection_segment_compile(r->x0,r->y0,r->x1,r->y1,&tab_compiles[mur],xr,yr);
+}
+// ---------------------------------------------
+/* fonction: banc_noyau_simd
+    Description:    compare les noyaux de recherche du mur le plus proche (scalaire, SSE2,
+                    AVX2)  la recherche de rfrence (un test d'intersection par mur):
+                    - par segment: temps moyen par mur test, sur un niveau gnr de
+                      BANC_MURS_NOYAU murs, pour des segments courts (un pas de simulation)
+                      et longs (un quart de la zone), et nb de murs trouvs diffrents
+                    - par tir: temps moyen d'un tir sur les niveaux du jeu sans index (murs
+                      tests par le noyau) et avec l'arbre des murs, et nb de tirs dont
+                      l'issue diffre de celle obtenue avec l'arbre
+                    Les noyaux non supports par le processeur sont ignors. Le noyau choisi
+                    au lancement du programme est rtabli  la fin.
+    Paramtre(s):   aucun
+    Retour:         le nb de rsultats diffrents de la rfrence (0 si tout concorde),
+                    -1 en cas d'erreur d'allocation
+    Ex. d'utilisation:
+                    banc_noyau_simd();
+*/
+int banc_noyau_simd()
+{
+    const char* tab_noms[]={"scalaire","SSE2","AVX2"};
+    int cote=(int)(BANC_ESPACE_PAR_MUR*sqrt((double)BANC_MURS_NOYAU));
+    int nb_requetes=BANC_NB_REQUETES/100;
+    int noyau_initial=noyau_murs_simd();
+    int (*tab_murs)[COL_TABSEG];
+    t_segment_compile* tab_compiles=NULL;
+    int* tab_reference=NULL;
+    int* tab_trouves=NULL;
+    int* tab_issues=NULL;
+    t_murs_simd* murs=NULL;
+    t_requete_banc* tab_requetes=NULL;
+    t_requete_banc* r;
+    t_niveau niv;
+    t_resultat_tir resultat;
+    Uint64 debut;
+    double ns_reference,ns,s,xr,yr,xs,ys;
+    double tab_us[NOYAU_AVX2+2];
+    int type,longueur,i,k,noyau,niveau,vx,vy,nb_tirs,issue;
+    int nb_differents,nb_egalites,nb_differences=0;
+
+    banc_graine(BANC_GRAINE);
+    tab_murs=generer_murs(BANC_MURS_NOYAU,cote);
+    if (tab_murs!=NULL){
+        tab_compiles=compiler_murs(tab_murs,BANC_MURS_NOYAU);
+        murs=construire_murs_simd(tab_murs,BANC_MURS_NOYAU);
+    }
+    tab_requetes=(t_requete_banc*)malloc(nb_requetes*sizeof(t_requete_banc));
+    tab_reference=(int*)malloc(nb_requetes*sizeof(int));
+    tab_trouves=(int*)malloc(nb_requetes*sizeof(int));
+    tab_issues=(int*)malloc((2*V_INITIALE_MAX+1)*(2*V_INITIALE_MAX+1)*sizeof(int));
+    if (tab_compiles==NULL || murs==NULL || tab_requetes==NULL || tab_reference==NULL ||
+        tab_trouves==NULL || tab_issues==NULL){
+        printf("memoire insuffisante\n");
+        free(tab_murs);
+        free(tab_compiles);
+        liberer_murs_simd(murs);
+        free(tab_requetes);
+        free(tab_reference);
+        free(tab_trouves);
+        free(tab_issues);
+        return -1;
+    }
+
+    // 1-par segment
+    printf("Par segment (%d segments x %d murs), temps par mur teste:\n",nb_requetes,BANC_MURS_NOYAU);
+    for (type=0;type<2;type++){
+        longueur=(type==0)?(int)(V_INITIALE_MAX*DELTAT):cote/4;
+        generer_requetes(tab_requetes,nb_requetes,cote,longueur);
+
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<nb_requetes;i++){
+            tab_reference[i]=premier_mur_lineaire(tab_compiles,BANC_MURS_NOYAU,&tab_requetes[i],&xr,&yr);
+        }
+        ns_reference=temps_ns(debut,nb_requetes*BANC_MURS_NOYAU);
+        printf("  segments %-6s (<=%4d): reference %6.2lf ns\n",type==0?"courts":"longs",longueur,ns_reference);
+
+        for (noyau=NOYAU_SCALAIRE;noyau<=NOYAU_AVX2;noyau++){
+            if (!noyau_murs_simd_disponible(noyau)) continue;
+            choisir_noyau_murs_simd(noyau);
+            debut=SDL_GetPerformanceCounter();
+            for (i=0;i<nb_requetes;i++){
+                r=&tab_requetes[i];
+                tab_trouves[i]=murs_simd_premier_mur(murs,r->x0,r->y0,r->x1,r->y1,&s);
+            }
+            ns=temps_ns(debut,nb_requetes*BANC_MURS_NOYAU);
+
+            // un autre mur crois au mme point (murs colinaires qui se chevauchent)
+            // est une galit et non une diffrence
+            nb_differents=nb_egalites=0;
+            for (i=0;i<nb_requetes;i++){
+                if (tab_trouves[i]==tab_reference[i]) continue;
+                if (tab_trouves[i]>=0 && tab_reference[i]>=0 &&
+                    impact_mur(tab_compiles,&tab_requetes[i],tab_trouves[i],&xs,&ys) &&
+                    impact_mur(tab_compiles,&tab_requetes[i],tab_reference[i],&xr,&yr) &&
+                    fabs(xs-xr)<1e-9 && fabs(ys-yr)<1e-9) nb_egalites++;
+                else nb_differents++;
+            }
+            printf("      %-8s %6.2lf ns (x%.1lf), %d murs trouves differents, %d egalites\n",
+                   tab_noms[noyau],ns,ns_reference/ns,nb_differents,nb_egalites);
+            nb_differences+=nb_differents;
+        }
+    }
+
+    // 2-par tir
+    printf("Par tir (vitesses initiales espacees de %d), temps par tir (us):\n",BANC_PAS_TIRS);
+    printf("            murs    arbre");
+    for (noyau=NOYAU_SCALAIRE;noyau<=NOYAU_AVX2;noyau++) printf(" %8s",tab_noms[noyau]);
+    printf("\n");
+    initialiser_niveau(&niv);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        nb_differents=0;
+        // k=0: arbre des murs (rfrence), k>0: noyau k-1 sans index
+        for (k=0;k<=NOYAU_AVX2+1;k++){
+            tab_us[k]=0;
+            if (k>0 && !noyau_murs_simd_disponible(k-1)) continue;
+            if (k>0) choisir_noyau_murs_simd(k-1);
+            niv.index_murs=(k==0)?INDEX_MURS_BVH:INDEX_MURS_AUCUN;
+            if (charger_niveau(niveau,&niv)<0) break;
+            nb_tirs=0;
+            debut=SDL_GetPerformanceCounter();
+            for (vy=-V_INITIALE_MAX;vy<=V_INITIALE_MAX;vy+=BANC_PAS_TIRS){
+                for (vx=-V_INITIALE_MAX;vx<=V_INITIALE_MAX;vx+=BANC_PAS_TIRS){
+                    if (vx*vx+vy*vy>V_INITIALE_MAX*V_INITIALE_MAX) continue;
+                    simuler_tir(&niv,vx,vy,&resultat);
+                    issue=resultat.touche+2*resultat.nb_rebonds+65536*resultat.nb_pas;
+                    if (k==0) tab_issues[nb_tirs]=issue;
+                    else if (tab_issues[nb_tirs]!=issue) nb_differents++;
+                    nb_tirs++;
+                }
+            }
+            tab_us[k]=temps_ns(debut,nb_tirs)/1000;
+        }
+        if (k<=NOYAU_AVX2+1) continue;
+        printf("  niveau %2d %4d %8.2lf",niveau,niv.nb_segments,tab_us[0]);
+        for (k=1;k<=NOYAU_AVX2+1;k++){
+            if (tab_us[k]>0) printf(" %8.2lf",tab_us[k]);
+            else printf(" %8s","-");
+        }
+        printf("  %d tirs differents\n",nb_differents);
+        nb_differences+=nb_differents;
+    }
+    liberer_niveau(&niv);
+    choisir_noyau_murs_simd(noyau_initial);
+
+    free(tab_murs);
+    free(tab_compiles);
+    liberer_murs_simd(murs);
+    free(tab_requetes);
+    free(tab_reference);
+    free(tab_trouves);
+    free(tab_issues);
+    return nb_differences;
+}
+
+// ---------------------------------------------
+/* fonction: voler_librement
+    Description:    simule un vol libre (sans murs) de BANC_DUREE_VOL secondes avec
+                    l'intgrateur choisi
+    Paramtre(s):   vx,vy   vitesse initiale
+                    dt      pas de temps
+                    x,y     adresses o placer la position finale
+    Retour:         le nb de pas simuls
+*/
+static int voler_librement(double vx, double vy, double dt, double* x, double* y)
+{
+    double tab_projectile[LIG_TABPRO][COL_TABPRO]={{0}};
+    double t=0;
+    int nb_pas=(int)ceil(BANC_DUREE_VOL/dt-1e-9),i;
+
+    tab_projectile[VITESSE][X1]=vx;
+    tab_projectile[VITESSE][Y1]=vy;
+    for (i=0;i<nb_pas;i++) mise_a_jour_ballistique(tab_projectile,&t,BANC_DUREE_VOL/(double)nb_pas);
+    *x=tab_projectile[POSITION][X1];
+    *y=tab_projectile[POSITION][Y1];
+    return nb_pas;
+}
+
+// ---------------------------------------------
+/* fonction: banc_integrateurs
+    Description:    compare les intgrateurs numriques du vol (Euler semi-implicite,
+                    Verlet, RK4, RK45 adaptatif, solution exacte) pour plusieurs pas de temps:
+                    - vols libres: cart maximum de la position aprs BANC_DUREE_VOL
+                      secondes avec une intgration RK4 de pas BANC_PAS_REFERENCE, et temps
+                      moyen d'un vol
+                    - tirs dans les niveaux du jeu: proportion des tirs dont l'issue
+                      (touch ou non) est la mme qu'avec une simulation RK4 de pas
+                      BANC_PAS_REFERENCE_TIRS, et temps moyen d'un tir
+                    - tirs simuls par vnements (voir simuler_tir_analytique): mmes
+                      mesures, avec le nb d'arcs de vol calculs par tir
+                    L'intgrateur choisi au lancement du programme est rtabli  la fin.
+    Paramtre(s):   aucun
+    Retour:         0, -1 en cas d'erreur d'allocation
+    Ex. d'utilisation:
+                    banc_integrateurs();
+*/
+int banc_integrateurs()
+{
+    const char* tab_noms[NB_INTEGRATEURS]={"Euler","Verlet","RK4","RK45","Exact"};
+    double tab_pas_vol[]={0.05,0.1,0.2,0.5,1.0};
+    double tab_pas_tir[]={0.1,0.2,0.5};
+    int nb_pas_vol=sizeof(tab_pas_vol)/sizeof(tab_pas_vol[0]);
+    int nb_pas_tir=sizeof(tab_pas_tir)/sizeof(tab_pas_tir[0]);
+    int integrateur_initial=integrateur_simulation();
+    double tab_vx[BANC_NB_VOLS],tab_vy[BANC_NB_VOLS];
+    double tab_x_ref[BANC_NB_VOLS],tab_y_ref[BANC_NB_VOLS];
+    char* tab_issues[DERNIER_NIVEAU+1]={NULL};  // issue de rfrence de chaque tir, par niveau
+    t_niveau niv;
+    t_resultat_tir resultat;
+    Uint64 debut,duree;
+    double x,y,ecart_max;
+    int integrateur,p,i,niveau,vx,vy,k,nb_tirs,nb_egaux,nb_pas,retour=0;
+
+    // 1-vols libres
+    banc_graine(BANC_GRAINE);
+    choisir_integrateur(INTEGRATEUR_RK4);
+    for (i=0;i<BANC_NB_VOLS;i++){
+        tab_vx[i]=banc_hasard(-100*V_INITIALE_MAX,100*V_INITIALE_MAX)/100.0;
+        tab_vy[i]=banc_hasard(-100*V_INITIALE_MAX,100*V_INITIALE_MAX)/100.0;
+        voler_librement(tab_vx[i],tab_vy[i],BANC_PAS_REFERENCE,&tab_x_ref[i],&tab_y_ref[i]);
+    }
+    printf("Vols libres (%d vols de %d s), ecart maximum avec la reference:\n",BANC_NB_VOLS,BANC_DUREE_VOL);
+    for (integrateur=0;integrateur<NB_INTEGRATEURS;integrateur++){
+        choisir_integrateur(integrateur);
+        for (p=0;p<nb_pas_vol;p++){
+            ecart_max=0;
+            debut=SDL_GetPerformanceCounter();
+            for (i=0;i<BANC_NB_VOLS;i++){
+                nb_pas=voler_librement(tab_vx[i],tab_vy[i],tab_pas_vol[p],&x,&y);
+                ecart_max=fmax(ecart_max,fmax(fabs(x-tab_x_ref[i]),fabs(y-tab_y_ref[i])));
+            }
+            printf("  %-6s pas %4.2lf s (%3d pas/vol): ecart %10.3g, %8.0lf ns/vol\n",
+                   tab_noms[integrateur],tab_pas_vol[p],nb_pas,ecart_max,temps_ns(debut,BANC_NB_VOLS));
+        }
+    }
+
+    // 2-tirs: issues de rfrence
+    initialiser_niveau(&niv);
+    choisir_integrateur(INTEGRATEUR_RK4);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        if (charger_niveau(niveau,&niv)<0) continue;
+        tab_issues[niveau]=(char*)malloc((2*V_INITIALE_MAX+1)*(2*V_INITIALE_MAX+1));
+        if (tab_issues[niveau]==NULL){
+            retour=-1;
+            break;
+        }
+        k=0;
+        for (vy=-V_INITIALE_MAX;vy<=V_INITIALE_MAX;vy+=BANC_PAS_TIRS_INTEGRATEUR){
+            for (vx=-V_INITIALE_MAX;vx<=V_INITIALE_MAX;vx+=BANC_PAS_TIRS_INTEGRATEUR){
+                if (vx*vx+vy*vy>V_INITIALE_MAX*V_INITIALE_MAX) continue;
+                tab_issues[niveau][k++]=(char)simuler_tir_pas(&niv,vx,vy,BANC_PAS_REFERENCE_TIRS,&resultat);
+            }
+        }
+    }
+
+    // 2-tirs: comparaison
+    if (retour==0){
+        printf("Tirs (vitesses initiales espacees de %d), issues identiques a la reference:\n",
+               BANC_PAS_TIRS_INTEGRATEUR);
+        for (integrateur=0;integrateur<NB_INTEGRATEURS;integrateur++){
+            choisir_integrateur(integrateur);
+            for (p=0;p<nb_pas_tir;p++){
+                nb_tirs=nb_egaux=nb_pas=0;
+                duree=0;
+                for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+                    if (tab_issues[niveau]==NULL || charger_niveau(niveau,&niv)<0) continue;
+                    k=0;
+                    debut=SDL_GetPerformanceCounter();
+                    for (vy=-V_INITIALE_MAX;vy<=V_INITIALE_MAX;vy+=BANC_PAS_TIRS_INTEGRATEUR){
+                        for (vx=-V_INITIALE_MAX;vx<=V_INITIALE_MAX;vx+=BANC_PAS_TIRS_INTEGRATEUR){
+                            if (vx*vx+vy*vy>V_INITIALE_MAX*V_INITIALE_MAX) continue;
+                            if (simuler_tir_pas(&niv,vx,vy,tab_pas_tir[p],&resultat)==tab_issues[niveau][k]) nb_egaux++;
+                            nb_pas+=resultat.nb_pas;
+                            k++;
+                        }
+                    }
+                    duree+=SDL_GetPerformanceCounter()-debut;
+                    nb_tirs+=k;
+                }
+                printf("  %-6s pas %4.2lf s: %6.2lf%% (%d tirs), %6.1lf pas/tir, %7.2lf us/tir\n",
+                       tab_noms[integrateur],tab_pas_tir[p],100.0*nb_egaux/nb_tirs,nb_tirs,
+                       (double)nb_pas/nb_tirs,1e6*(double)duree/SDL_GetPerformanceFrequency()/nb_tirs);
+            }
+        }
+
+        // 3-tirs par vnements
+        choisir_integrateur(INTEGRATEUR_ANALYTIQUE);
+        nb_tirs=nb_egaux=nb_pas=0;
+        duree=0;
+        for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+            if (tab_issues[niveau]==NULL || charger_niveau(niveau,&niv)<0 || !niveau_analytique(&niv)) continue;
+            k=0;
+            debut=SDL_GetPerformanceCounter();
+            for (vy=-V_INITIALE_MAX;vy<=V_INITIALE_MAX;vy+=BANC_PAS_TIRS_INTEGRATEUR){
+                for (vx=-V_INITIALE_MAX;vx<=V_INITIALE_MAX;vx+=BANC_PAS_TIRS_INTEGRATEUR){
+                    if (vx*vx+vy*vy>V_INITIALE_MAX*V_INITIALE_MAX) continue;
+                    if (simuler_tir_analytique(&niv,vx,vy,&resultat)==tab_issues[niveau][k]) nb_egaux++;
+                    nb_pas+=resultat.nb_pas;
+                    k++;
+                }
+            }
+            duree+=SDL_GetPerformanceCounter()-debut;
+            nb_tirs+=k;
+        }
+        if (nb_tirs>0){
+            printf("  %-6s evenements: %6.2lf%% (%d tirs), %6.1lf arcs/tir, %7.2lf us/tir\n",
+                   tab_noms[INTEGRATEUR_ANALYTIQUE],100.0*nb_egaux/nb_tirs,nb_tirs,
+                   (double)nb_pas/nb_tirs,1e6*(double)duree/SDL_GetPerformanceFrequency()/nb_tirs);
+        }
+    }
+    else printf("memoire insuffisante\n");
+
+    liberer_niveau(&niv);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++) free(tab_issues[niveau]);
+    choisir_integrateur(integrateur_initial);
+    return retour;
+}
+
+// ---------------------------------------------
+/* fonction: mesurer_images
+    Description:    mesure le temps moyen de dessin d'une image (effacement et murs) par
+                    le rendu logiciel
+    Paramtre(s):   tab_murs    murs  dessiner
+                    nb_murs     nb de murs
+                    en_lot      1 pour dessiner les murs en un seul lot (graph_trace_segments),
+                                0 pour les dessiner un  la fois (graph_trace_segment)
+    Retour:         le temps moyen par image (us)
+*/
+static double mesurer_images(int tab_murs[][COL_TABSEG], int nb_murs, int en_lot)
+{
+    Uint64 debut=SDL_GetPerformanceCounter();
+    int i,k;
+
+    for (i=0;i<BANC_NB_IMAGES;i++){
+        graph_clear(0,0,0,255);
+        graph_select_couleur(255,255,255,255);
+        if (en_lot) graph_trace_segments(tab_murs,nb_murs);
+        else{
+            for (k=0;k<nb_murs;k++) graph_trace_segment(tab_murs[k][X0],tab_murs[k][Y0],tab_murs[k][X1],tab_murs[k][Y1]);
+        }
+        graph_mise_a_jour();
+    }
+    return temps_ns(debut,BANC_NB_IMAGES)/1000;
+}
+
+// ---------------------------------------------
+/* fonction: banc_rendu
+    Description:    mesure le temps de dessin d'une image complte par le rendu logiciel
+                    (graph_logiciel.c), sans cran:
+                    - effacement seul de l'image
+                    - niveaux du jeu: effacement et murs
+                    - niveaux gnrs dans la fentre (100  10000 murs): murs dessins
+                      un  la fois et en un seul lot
+    Paramtre(s):   aucun
+    Retour:         0, -1 si l'image ou les murs ne peuvent pas tre crs
+    Ex. d'utilisation:
+                    banc_rendu();
+*/
+int banc_rendu()
+{
+    int tab_nb_murs[]={100,1000,10000};
+    int (*tab_murs)[COL_TABSEG];
+    int niveau,i,nb_niveaux=0;
+    double total=0;
+    t_niveau niv;
+
+    if (!graph_init("banc",LARGEUR_FEN,HAUTEUR_FEN,0,0,0,255)) return -1;
+    printf("Rendu logiciel %dx%d, %d images par mesure:\n",LARGEUR_FEN,HAUTEUR_FEN,BANC_NB_IMAGES);
+    printf("  effacement seul: %8.2lf us/image\n",mesurer_images(NULL,0,1));
+
+    initialiser_niveau(&niv);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        if (charger_niveau(niveau,&niv)<0) continue;
+        total+=mesurer_images(niv.tab_segments,niv.nb_segments,1);
+        nb_niveaux++;
+    }
+    liberer_niveau(&niv);
+    if (nb_niveaux>0) printf("  niveaux du jeu (%d): %8.2lf us/image\n",nb_niveaux,total/nb_niveaux);
+
+    banc_graine(BANC_GRAINE);
+    for (i=0;i<(int)(sizeof(tab_nb_murs)/sizeof(tab_nb_murs[0]));i++){
+        tab_murs=generer_murs(tab_nb_murs[i],LARGEUR_FEN);
+        if (tab_murs==NULL){
+            graph_fin();
+            return -1;
+        }
+        printf("  %5d murs: un a la fois %8.2lf us/image, en lot %8.2lf us/image\n",tab_nb_murs[i],
+               mesurer_images(tab_murs,tab_nb_murs[i],0),mesurer_images(tab_murs,tab_nb_murs[i],1));
+        free(tab_murs);
+    }
+
+    graph_fin();
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: ecrire_niveau_genere
+    Description:    crit un fichier de niveau au format du jeu avec des murs gnrs: la
+                    zone (0,0)-(cote,cote) puis les murs aprs le contour, la premire
+                    moiti comme murs verticaux et le reste comme murs horizontaux
+    Paramtre(s):   nom_fichier         fichier  crire
+                    tab_murs,nb_murs    murs gnrs (voir generer_murs)
+                    cote                ct de la zone
+    Retour:         la taille du fichier crit (octets), -1 en cas d'erreur
+*/
+static long ecrire_niveau_genere(const char* nom_fichier, int tab_murs[][COL_TABSEG], int nb_murs, int cote)
+{
+    FILE* fp=fopen(nom_fichier,"w");
+    int milieu=4+(nb_murs-4)/2;
+    int i;
+    long taille;
+
+    if (fp==NULL) return -1;
+    fprintf(fp,"Fichier de definition d'un niveau\nDimensions de la zone limite du niveau (x1,y1,x2,y2)\n");
+    fprintf(fp,"0,0,%d,%d\n",cote,cote);
+    fprintf(fp,"nb de segments verticaux\n%d\ncoordonnees des segments verticaux (x1,y1,x2,y2)\n",milieu-4);
+    for (i=4;i<milieu;i++) fprintf(fp,"%d,%d,%d,%d\n",tab_murs[i][X0],tab_murs[i][Y0],tab_murs[i][X1],tab_murs[i][Y1]);
+    fprintf(fp,"nb de segments horizontaux\n%d\ncoordonnees des segments horizontaux (x1,y1,x2,y2)\n",nb_murs-milieu);
+    for (i=milieu;i<nb_murs;i++) fprintf(fp,"%d,%d,%d,%d\n",tab_murs[i][X0],tab_murs[i][Y0],tab_murs[i][X1],tab_murs[i][Y1]);
+    fprintf(fp,"position du lanceur (x,y)\n%d,%d\n",cote/10,cote/10);
+    fprintf(fp,"position de la cible (coin inferieur gauche (x,y))\n%d,%d\n",cote/2,cote/2);
+    fprintf(fp,"taille de la cible (carree de cote x)\n50\n");
+    taille=ftell(fp);
+    if (fclose(fp)!=0) return -1;
+    return taille;
+}
+
+// ---------------------------------------------
+/* fonction: ajouter_mur_lignes
+    Description:    ajoute un mur  un niveau lu par la lecture de rfrence (la capacit
+                    du tableau de murs est double quand il est plein)
+    Paramtre(s):   lu          niveau lu
+                    x1,y1,x2,y2 extrmits du mur
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation
+*/
+static int ajouter_mur_lignes(t_niveau_lu* lu, int x1, int y1, int x2, int y2)
+{
+    int (*tab_segments)[COL_TABSEG];
+    int capacite;
+
+    if (lu->nb_segments==lu->capacite){
+        capacite=(lu->capacite==0)?NB_SEGMENTS_INITIAL:2*lu->capacite;
+        tab_segments=(int (*)[COL_TABSEG])realloc(lu->tab_segments,capacite*sizeof(*tab_segments));
+        if (tab_segments==NULL) return 0;
+        lu->tab_segments=tab_segments;
+        lu->capacite=capacite;
+    }
+    lu->tab_segments[lu->nb_segments][X0]=x1;
+    lu->tab_segments[lu->nb_segments][Y0]=y1;
+    lu->tab_segments[lu->nb_segments][X1]=x2;
+    lu->tab_segments[lu->nb_segments][Y1]=y2;
+    lu->nb_segments++;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: lire_niveau_lignes
+    Description:    lecture de rfrence d'un fichier de niveau, comme l'ancienne version
+                    de lire_fichier_niveau: une ligne  la fois avec fgets dans un tampon,
+                    dcode avec sscanf (ici sans limite du nb de murs)
+    Paramtre(s):   nom_fichier     fichier  lire
+                    lu              niveau lu  remplir (voir analyser_niveau)
+    Retour:         le nombre de segments de murs lus, ou -1 en cas d'erreur
+*/
+static int lire_niveau_lignes(const char* nom_fichier, t_niveau_lu* lu)
+{
+    FILE* fp=fopen(nom_fichier,"r");
+    char ligne[MAX_CHAR];
+    int x1,y1,x2,y2,section,nb,i,cote;
+    int reussite;
+
+    if (fp==NULL) return -1;
+    lu->nb_segments=0;
+
+    // en-tte et zone limite (4 murs)
+    reussite=fgets(ligne,MAX_CHAR,fp)!=NULL && fgets(ligne,MAX_CHAR,fp)!=NULL &&
+             fgets(ligne,MAX_CHAR,fp)!=NULL && sscanf(ligne,"%d,%d,%d,%d",&x1,&y1,&x2,&y2)==4 &&
+             ajouter_mur_lignes(lu,x1,y1,x1,y2) && ajouter_mur_lignes(lu,x1,y2,x2,y2) &&
+             ajouter_mur_lignes(lu,x2,y2,x2,y1) && ajouter_mur_lignes(lu,x2,y1,x1,y1);
+
+    // murs verticaux puis horizontaux
+    for (section=0;section<2 && reussite;section++){
+        reussite=fgets(ligne,MAX_CHAR,fp)!=NULL && fgets(ligne,MAX_CHAR,fp)!=NULL &&
+                 sscanf(ligne,"%d",&nb)==1 && fgets(ligne,MAX_CHAR,fp)!=NULL;
+        for (i=0;i<nb && reussite;i++){
+            reussite=fgets(ligne,MAX_CHAR,fp)!=NULL && sscanf(ligne,"%d,%d,%d,%d",&x1,&y1,&x2,&y2)==4 &&
+                     ajouter_mur_lignes(lu,x1,y1,x2,y2);
+        }
+    }
+
+    // lanceur et cible
+    reussite=reussite && fgets(ligne,MAX_CHAR,fp)!=NULL && fgets(ligne,MAX_CHAR,fp)!=NULL &&
+             sscanf(ligne,"%d,%d",&lu->tab_lanceur[X0],&lu->tab_lanceur[Y0])==2 &&
+             fgets(ligne,MAX_CHAR,fp)!=NULL && fgets(ligne,MAX_CHAR,fp)!=NULL &&
+             sscanf(ligne,"%d,%d",&lu->tab_cible[X0],&lu->tab_cible[Y0])==2 &&
+             fgets(ligne,MAX_CHAR,fp)!=NULL && fgets(ligne,MAX_CHAR,fp)!=NULL && sscanf(ligne,"%d",&cote)==1;
+    fclose(fp);
+    if (!reussite) return -1;
+
+    lu->tab_lanceur[X1]=lu->tab_lanceur[X0];
+    lu->tab_lanceur[Y1]=lu->tab_lanceur[Y0];
+    lu->tab_cible[X1]=lu->tab_cible[X0]+cote;
+    lu->tab_cible[Y1]=lu->tab_cible[Y0]+cote;
+    return lu->nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: banc_lecture_niveau
+    Description:    mesure la lecture d'un fichier de niveau gnr de nb_murs murs:
+                    - lecture de rfrence ligne par ligne (fgets et sscanf)
+                    - lecture du fichier en bloc et dcodage (lire_niveau_texte)
+                    - dcodage seul du texte dj en mmoire (analyser_niveau)
+                    Le fichier est lu plusieurs fois pour lire au moins BANC_MURS_LUS murs
+                    par mesure (il reste dans le cache du systme d'exploitation: seul le
+                    cot de la lecture et du dcodage est mesur). Les murs lus sont
+                    compars aux murs gnrs.
+    Paramtre(s):   nb_murs     nb de murs du niveau gnr (au moins 4)
+    Retour:         le nb de lectures dont le rsultat diffre des murs gnrs (0 si tout
+                    concorde), -1 en cas d'erreur d'criture du fichier ou d'allocation
+    Ex. d'utilisation:
+                    banc_lecture_niveau(100000);
+*/
+int banc_lecture_niveau(int nb_murs)
+{
+    int cote=(int)(BANC_ESPACE_PAR_MUR*sqrt((double)nb_murs));
+    int nb_lectures=(nb_murs>=BANC_MURS_LUS)?1:BANC_MURS_LUS/nb_murs;
+    int (*tab_murs)[COL_TABSEG];
+    t_niveau_lu lu;
+    t_erreur_niveau erreur;
+    char* texte=NULL;
+    FILE* fp;
+    long taille;
+    Uint64 debut;
+    double tab_ns[3];
+    int methode,i,nb=-1,nb_differences=0;
+    const char* tab_noms[3]={"ligne par ligne (fgets/sscanf)","en bloc (lire_niveau_texte)","decodage seul (analyser_niveau)"};
+
+    banc_graine(BANC_GRAINE+nb_murs);
+    tab_murs=generer_murs(nb_murs,cote);
+    if (tab_murs==NULL) return -1;
+    taille=ecrire_niveau_genere(BANC_FICHIER_NIVEAU,tab_murs,nb_murs,cote);
+    if (taille>0) texte=(char*)malloc(taille);
+    fp=(texte!=NULL)?fopen(BANC_FICHIER_NIVEAU,"rb"):NULL;
+    if (fp==NULL || fread(texte,1,taille,fp)!=(size_t)taille){
+        printf("%d murs: ecriture du fichier %s impossible\n",nb_murs,BANC_FICHIER_NIVEAU);
+        if (fp!=NULL) fclose(fp);
+        remove(BANC_FICHIER_NIVEAU);
+        free(texte);
+        free(tab_murs);
+        return -1;
+    }
+    fclose(fp);
+
+    printf("%d murs (fichier de %.2lf Mo, %d lecture%s par mesure):\n",nb_murs,taille/1e6,nb_lectures,nb_lectures>1?"s":"");
+    initialiser_niveau_lu(&lu);
+    for (methode=0;methode<3;methode++){
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<nb_lectures;i++){
+            if (methode==0) nb=lire_niveau_lignes(BANC_FICHIER_NIVEAU,&lu);
+            else if (methode==1) nb=lire_niveau_texte(BANC_FICHIER_NIVEAU,&lu,&erreur);
+            else nb=analyser_niveau(texte,taille,&lu,&erreur);
+        }
+        tab_ns[methode]=temps_ns(debut,nb_lectures);
+        // murs aprs le contour (dans le mme ordre que les murs gnrs)
+        if (nb!=nb_murs || memcmp(lu.tab_segments[4],tab_murs[4],(nb_murs-4)*sizeof(tab_murs[0]))!=0) nb_differences++;
+        printf("  %-34s %10.3lf ms, %7.1lf ns/mur, %7.1lf Mo/s%s\n",tab_noms[methode],tab_ns[methode]/1e6,
+               tab_ns[methode]/nb_murs,taille*1e3/tab_ns[methode],
+               (nb==nb_murs)?"":" (erreur de lecture)");
+    }
+    printf("  acceleration: %.1lfx (en bloc), %.1lfx (decodage seul)\n",tab_ns[0]/tab_ns[1],tab_ns[0]/tab_ns[2]);
+    printf("  lectures differentes des murs generes: %d\n",nb_differences);
+
+    liberer_niveau_lu(&lu);
+    remove(BANC_FICHIER_NIVEAU);
+    free(texte);
+    free(tab_murs);
+    return nb_differences;
+}
@@ -0,0 +1,55 @@
+#ifndef BANC_H
+#define BANC_H
+
+// -------------------------------------------
+/*
+librairie banc.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Bancs d'essai des structures et fonctions de la simulation. Les bancs
+             utilisent des niveaux gnrs (murs alatoires mais reproductibles) pour
+             mesurer le comportement au-del de la taille des niveaux du jeu.
+             Les temps sont mesurs avec le compteur haute prcision de SDL.
+Note: les implmentations des fonctions se trouvent dans le fichier banc.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// paramtres des niveaux gnrs
+// ---------------------------------------------
+#define BANC_GRAINE             12345   // graine du gnrateur de nombres alatoires
+#define BANC_ESPACE_PAR_MUR     20      // ct de la zone de jeu = BANC_ESPACE_PAR_MUR*racine(nb murs)
+#define BANC_LONGUEUR_MIN_MUR   4       // longueur minimum d'un mur gnr
+#define BANC_LONGUEUR_MAX_MUR   32      // longueur maximum d'un mur gnr
+#define BANC_NB_REQUETES        100000  // nb de requtes mesures par structure
+#define BANC_TESTS_LINEAIRES    100000000.0 // nb maximum de tests de murs pour la recherche sans index
+#define BANC_COTE_FENETRE       400     // ct du rectangle des requtes de murs visibles
+#define BANC_MURS_NOYAU         1000    // nb de murs du niveau gnr pour le banc des tests d'intersection
+#define BANC_PAS_TIRS           3       // cart entre les vitesses initiales des tirs simuls
+#define BANC_NB_VOLS            100     // nb de vols libres (sans murs) compars  la rfrence
+#define BANC_DUREE_VOL          10      // dure des vols libres (s)
+#define BANC_PAS_REFERENCE      1e-4    // pas de l'intgration de rfrence (RK4) des vols libres
+#define BANC_PAS_REFERENCE_TIRS 0.01    // pas de la simulation de rfrence (RK4) des tirs
+#define BANC_PAS_TIRS_INTEGRATEUR 8     // cart entre les vitesses initiales des tirs compars  la rfrence
+#define BANC_NB_IMAGES          200     // nb d'images dessines par mesure du rendu logiciel
+#define BANC_FICHIER_NIVEAU     "banc_niveau.txt"   // fichier de niveau gnr pour le banc de lecture
+#define BANC_MURS_LUS           1000000 // nb de murs lus par mesure de la lecture (le fichier est relu au besoin)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void banc_graine(unsigned int graine);
+int banc_hasard(int min, int max);
+int (*generer_murs(int nb_murs, int cote))[COL_TABSEG];
+
+int banc_index_murs(int nb_murs);
+int banc_noyau_collision();
+int banc_noyau_simd();
+int banc_integrateurs();
+int banc_rendu();
+int banc_lecture_niveau(int nb_murs);
+
+#endif // BANC_H
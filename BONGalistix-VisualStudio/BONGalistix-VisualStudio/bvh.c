@@ -0,0 +1,537 @@
+// -------------------------------------------
+/*
+librairie bvh.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Hirarchie de volumes englobants (BVH) des murs: construction par
+             dcoupage des noeuds selon l'heuristique des surfaces (SAH, ici le
+             primtre en 2D) et parcours de l'arbre pour les requtes.
+Note: les prototypes des fonctions se trouvent dans le fichier bvh.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "geometrie.h"
+#include "bvh.h"
+
+#define BVH_EPSILON     1e-9    // tolrance ajoute aux rectangles lors des tests de croisement
+
+// ---------------------------------------------
+/* fonction: demi_perimetre
+    Description:    demi-primtre d'un rectangle. En 2D, la probabilit qu'un segment
+                    quelconque croise un rectangle est proportionnelle  son primtre.
+    Paramtre(s):   x_min,y_min,x_max,y_max     coins du rectangle
+    Retour:         le demi-primtre du rectangle
+*/
+static double demi_perimetre(double x_min, double y_min, double x_max, double y_max)
+{
+    return (x_max-x_min)+(y_max-y_min);
+}
+
+// ---------------------------------------------
+/* fonction: englober_mur
+    Description:    agrandit un rectangle pour qu'il contienne un mur
+    Paramtre(s):   tab_rect    rectangle  agrandir (x_min,y_min,x_max,y_max)
+                    seg         ligne du tableau de segments du mur
+    Retour:         aucun
+*/
+static void englober_mur(double tab_rect[4], int seg[COL_TABSEG])
+{
+    tab_rect[0]=fmin(tab_rect[0],fmin(seg[X0],seg[X1]));
+    tab_rect[1]=fmin(tab_rect[1],fmin(seg[Y0],seg[Y1]));
+    tab_rect[2]=fmax(tab_rect[2],fmax(seg[X0],seg[X1]));
+    tab_rect[3]=fmax(tab_rect[3],fmax(seg[Y0],seg[Y1]));
+}
+
+// ---------------------------------------------
+/* fonction: grand_mur
+    Description:    dtermine si un mur couvre plus de la moiti de la largeur ou de la
+                    hauteur d'un rectangle (ex: les murs du contour d'un niveau)
+    Paramtre(s):   tab_rect    rectangle du noeud (x_min,y_min,x_max,y_max)
+                    seg         ligne du tableau de segments du mur
+    Retour:         1 si le mur est grand par rapport au rectangle, 0 sinon
+*/
+static int grand_mur(double tab_rect[4], int seg[COL_TABSEG])
+{
+    return (2.0*abs(seg[X1]-seg[X0])>tab_rect[2]-tab_rect[0] ||
+            2.0*abs(seg[Y1]-seg[Y0])>tab_rect[3]-tab_rect[1]);
+}
+
+// ---------------------------------------------
+/* fonction: construire_noeud
+    Description:    construit rcursivement le noeud qui contient les murs
+                    tab_murs[debut]  tab_murs[debut+nb-1].
+                    Si le noeud contient trop de murs, les centres des murs sont rpartis
+                    en BVH_NB_INTERVALLES intervalles selon chaque axe. Le dcoupage entre
+                    deux intervalles qui minimise le cot estim (primtre de chaque enfant
+                    multipli par son nb de murs) est choisi, puis les murs sont rordonns
+                    pour que chaque enfant ait des murs conscutifs.
+                    Un dcoupage qui spare les grands murs des autres est aussi valu:
+                    sans lui, les murs du contour du niveau agrandiraient les rectangles
+                    de tous les noeuds qui les contiennent jusqu'aux feuilles.
+    Paramtre(s):   bvh             arbre en construction
+                    tab_segments    tableau des segments de murs
+                    noeud           index du noeud  construire
+                    debut,nb        murs du noeud dans tab_murs
+                    profondeur      profondeur du noeud (0 pour la racine)
+    Retour:         aucun
+*/
+static void construire_noeud(t_bvh* bvh, int tab_segments[][COL_TABSEG],
+                             int noeud, int debut, int nb, int profondeur)
+{
+    t_noeud_bvh* n=&bvh->tab_noeuds[noeud];
+    double tab_rect[4]={HUGE_VAL,HUGE_VAL,-HUGE_VAL,-HUGE_VAL};     // rectangle englobant le noeud
+    double c_min[2]={HUGE_VAL,HUGE_VAL},c_max[2]={-HUGE_VAL,-HUGE_VAL};  // tendue des centres des murs
+    double tab_rect_int[BVH_NB_INTERVALLES][4];     // rectangle englobant les murs de chaque intervalle
+    int tab_nb_int[BVH_NB_INTERVALLES];             // nb de murs de chaque intervalle
+    double tab_rect_g[4],tab_rect_d[4];
+    double centre,cout,cout_min=HUGE_VAL,p;
+    int i,j,k,a,mur,axe=0,coupe=-1,nb_g,tmp,gauche;
+    int grands=0;       // 1 si le dcoupage choisi spare les grands murs des autres
+
+    // rectangle englobant et tendue des centres
+    for (i=debut;i<debut+nb;i++){
+        mur=bvh->tab_murs[i];
+        englober_mur(tab_rect,tab_segments[mur]);
+        for (k=0;k<2;k++){
+            centre=0.5*(tab_segments[mur][X0+k]+tab_segments[mur][X1+k]);
+            c_min[k]=fmin(c_min[k],centre);
+            c_max[k]=fmax(c_max[k],centre);
+        }
+    }
+    n->x_min=tab_rect[0];
+    n->y_min=tab_rect[1];
+    n->x_max=tab_rect[2];
+    n->y_max=tab_rect[3];
+
+    if (nb<=BVH_MAX_MURS_FEUILLE || profondeur>=BVH_MAX_PROFONDEUR-1){
+        n->premier=debut;
+        n->nb_murs=nb;
+        return;
+    }
+
+    // valuer les dcoupages selon chacun des deux axes
+    p=demi_perimetre(tab_rect[0],tab_rect[1],tab_rect[2],tab_rect[3]);
+    for (a=0;a<2;a++){
+        if (c_max[a]<=c_min[a]) continue;
+
+        // rpartir les murs par intervalle selon leur centre
+        for (j=0;j<BVH_NB_INTERVALLES;j++){
+            tab_nb_int[j]=0;
+            tab_rect_int[j][0]=tab_rect_int[j][1]=HUGE_VAL;
+            tab_rect_int[j][2]=tab_rect_int[j][3]=-HUGE_VAL;
+        }
+        for (i=debut;i<debut+nb;i++){
+            mur=bvh->tab_murs[i];
+            centre=0.5*(tab_segments[mur][X0+a]+tab_segments[mur][X1+a]);
+            j=(int)(BVH_NB_INTERVALLES*(centre-c_min[a])/(c_max[a]-c_min[a]));
+            if (j>=BVH_NB_INTERVALLES) j=BVH_NB_INTERVALLES-1;
+            tab_nb_int[j]++;
+            englober_mur(tab_rect_int[j],tab_segments[mur]);
+        }
+
+        // dcoupage j: intervalles 0..j  gauche, j+1..  droite
+        for (j=0;j<BVH_NB_INTERVALLES-1;j++){
+            tab_rect_g[0]=tab_rect_g[1]=tab_rect_d[0]=tab_rect_d[1]=HUGE_VAL;
+            tab_rect_g[2]=tab_rect_g[3]=tab_rect_d[2]=tab_rect_d[3]=-HUGE_VAL;
+            nb_g=0;
+            for (i=0;i<BVH_NB_INTERVALLES;i++){
+                if (tab_nb_int[i]==0) continue;
+                if (i<=j){
+                    nb_g+=tab_nb_int[i];
+                    for (k=0;k<2;k++){
+                        tab_rect_g[k]=fmin(tab_rect_g[k],tab_rect_int[i][k]);
+                        tab_rect_g[k+2]=fmax(tab_rect_g[k+2],tab_rect_int[i][k+2]);
+                    }
+                }
+                else{
+                    for (k=0;k<2;k++){
+                        tab_rect_d[k]=fmin(tab_rect_d[k],tab_rect_int[i][k]);
+                        tab_rect_d[k+2]=fmax(tab_rect_d[k+2],tab_rect_int[i][k+2]);
+                    }
+                }
+            }
+            if (nb_g==0 || nb_g==nb) continue;
+            cout=BVH_COUT_NOEUD+BVH_COUT_MUR*
+                 (nb_g*demi_perimetre(tab_rect_g[0],tab_rect_g[1],tab_rect_g[2],tab_rect_g[3])+
+                  (nb-nb_g)*demi_perimetre(tab_rect_d[0],tab_rect_d[1],tab_rect_d[2],tab_rect_d[3]))/p;
+            if (cout<cout_min){
+                cout_min=cout;
+                axe=a;
+                coupe=j;
+            }
+        }
+    }
+
+    // valuer le dcoupage qui spare les grands murs des autres
+    tab_rect_g[0]=tab_rect_g[1]=tab_rect_d[0]=tab_rect_d[1]=HUGE_VAL;
+    tab_rect_g[2]=tab_rect_g[3]=tab_rect_d[2]=tab_rect_d[3]=-HUGE_VAL;
+    nb_g=0;
+    for (i=debut;i<debut+nb;i++){
+        mur=bvh->tab_murs[i];
+        if (grand_mur(tab_rect,tab_segments[mur])){
+            nb_g++;
+            englober_mur(tab_rect_g,tab_segments[mur]);
+        }
+        else englober_mur(tab_rect_d,tab_segments[mur]);
+    }
+    if (nb_g>0 && nb_g<nb){
+        cout=BVH_COUT_NOEUD+BVH_COUT_MUR*
+             (nb_g*demi_perimetre(tab_rect_g[0],tab_rect_g[1],tab_rect_g[2],tab_rect_g[3])+
+              (nb-nb_g)*demi_perimetre(tab_rect_d[0],tab_rect_d[1],tab_rect_d[2],tab_rect_d[3]))/p;
+        if (cout<cout_min){
+            cout_min=cout;
+            grands=1;
+        }
+    }
+
+    if (grands || coupe>=0){
+        // placer les murs de gauche au dbut
+        nb_g=0;
+        for (i=debut;i<debut+nb;i++){
+            mur=bvh->tab_murs[i];
+            if (grands) j=grand_mur(tab_rect,tab_segments[mur])?0:1;
+            else{
+                centre=0.5*(tab_segments[mur][X0+axe]+tab_segments[mur][X1+axe]);
+                j=(int)(BVH_NB_INTERVALLES*(centre-c_min[axe])/(c_max[axe]-c_min[axe]));
+                if (j>=BVH_NB_INTERVALLES) j=BVH_NB_INTERVALLES-1;
+                j=(j<=coupe)?0:1;
+            }
+            if (j==0){
+                tmp=bvh->tab_murs[debut+nb_g];
+                bvh->tab_murs[debut+nb_g]=mur;
+                bvh->tab_murs[i]=tmp;
+                nb_g++;
+            }
+        }
+    }
+    else nb_g=nb/2;     // centres confondus: dcoupage en deux moitis
+
+    gauche=bvh->nb_noeuds;
+    bvh->nb_noeuds+=2;
+    n->premier=gauche;
+    n->nb_murs=0;
+    construire_noeud(bvh,tab_segments,gauche,debut,nb_g,profondeur+1);
+    construire_noeud(bvh,tab_segments,gauche+1,debut+nb_g,nb-nb_g,profondeur+1);
+}
+
+// ---------------------------------------------
+/* fonction: construire_bvh
+    Description:    construit l'arbre des murs d'un niveau
+    Paramtre(s):   tab_segments    tableau des segments de murs
+                    nb_segments     nombre de segments de murs
+    Retour:         l'adresse de l'arbre construit, NULL en cas d'erreur
+    Ex. d'utilisation:
+                    niv->bvh=construire_bvh(niv->tab_segments,niv->nb_segments);
+*/
+t_bvh* construire_bvh(int tab_segments[][COL_TABSEG], int nb_segments)
+{
+    t_bvh* bvh;
+    int i;
+
+    if (nb_segments<=0) return NULL;
+    bvh=(t_bvh*)calloc(1,sizeof(t_bvh));
+    if (bvh==NULL) return NULL;
+
+    // un arbre binaire dont les feuilles ont au moins un mur a au plus 2n-1 noeuds
+    bvh->tab_noeuds=(t_noeud_bvh*)malloc((2*(size_t)nb_segments-1)*sizeof(t_noeud_bvh));
+    bvh->tab_murs=(int*)malloc(nb_segments*sizeof(int));
+    if (bvh->tab_noeuds==NULL || bvh->tab_murs==NULL){
+        liberer_bvh(bvh);
+        return NULL;
+    }
+    bvh->nb_murs=nb_segments;
+    for (i=0;i<nb_segments;i++) bvh->tab_murs[i]=i;
+
+    bvh->nb_noeuds=1;
+    construire_noeud(bvh,tab_segments,0,0,nb_segments,0);
+
+    return bvh;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_bvh
+    Description:    libre la mmoire d'un arbre
+    Paramtre(s):   bvh     arbre  librer (NULL accept)
+    Retour:         aucun
+*/
+void liberer_bvh(t_bvh* bvh)
+{
+    if (bvh==NULL) return;
+    if (!bvh->emprunte){
+        free(bvh->tab_noeuds);
+        free(bvh->tab_murs);
+    }
+    free(bvh);
+}
+
+// ---------------------------------------------
+/* fonction: ajuster_bvh
+    Description:    recalcule les rectangles de tous les noeuds aprs le dplacement de
+                    murs (ex: niveau modifi pendant la partie), sans changer la forme de
+                    l'arbre ni la rpartition des murs dans les feuilles. Les enfants d'un
+                    noeud ont toujours un index plus grand que lui: un seul parcours des
+                    noeuds du dernier au premier suffit.
+    Note:           l'arbre reste exact, mais il peut devenir moins efficace si les murs
+                    dplacs s'loignent beaucoup des autres murs de leur feuille
+    Paramtre(s):   bvh             arbre  ajuster
+                    tab_segments    tableau des segments de murs (mmes indices qu' la
+                                    construction)
+    Retour:         aucun
+*/
+void ajuster_bvh(t_bvh* bvh, int tab_segments[][COL_TABSEG])
+{
+    double tab_rect[4];
+    t_noeud_bvh* n;
+    t_noeud_bvh* g;
+    t_noeud_bvh* d;
+    int noeud,i;
+
+    for (noeud=bvh->nb_noeuds-1;noeud>=0;noeud--){
+        n=&bvh->tab_noeuds[noeud];
+        if (n->nb_murs>0){
+            tab_rect[0]=tab_rect[1]=HUGE_VAL;
+            tab_rect[2]=tab_rect[3]=-HUGE_VAL;
+            for (i=n->premier;i<n->premier+n->nb_murs;i++) englober_mur(tab_rect,tab_segments[bvh->tab_murs[i]]);
+            n->x_min=tab_rect[0];
+            n->y_min=tab_rect[1];
+            n->x_max=tab_rect[2];
+            n->y_max=tab_rect[3];
+        }
+        else{
+            g=&bvh->tab_noeuds[n->premier];
+            d=&bvh->tab_noeuds[n->premier+1];
+            n->x_min=fmin(g->x_min,d->x_min);
+            n->y_min=fmin(g->y_min,d->y_min);
+            n->x_max=fmax(g->x_max,d->x_max);
+            n->y_max=fmax(g->y_max,d->y_max);
+        }
+    }
+}
+
+// ---------------------------------------------
+/* fonction: croise_noeud
+    Description:    dtermine si le segment (x0,y0)-(x0+dx,y0+dy) croise le rectangle
+                    d'un noeud (mthode des tranches)
+    Paramtre(s):   n       noeud  tester
+                    x0,y0   dbut du segment
+                    dx,dy   dplacement du segment
+                    s       adresse o placer la fraction du segment parcourue  l'entre
+                            dans le rectangle (0 si le dbut est dans le rectangle)
+    Retour:         1 si le segment croise le rectangle, 0 sinon
+*/
+static int croise_noeud(t_noeud_bvh* n, double x0, double y0, double dx, double dy, double* s)
+{
+    double s_min=0,s_max=1,s1,s2,tmp;
+
+    // les comparaisons sont crites directement (plutt qu'avec fmin et fmax) parce que
+    // ce test est fait  chaque noeud visit
+    if (dx!=0){
+        s1=(n->x_min-BVH_EPSILON-x0)/dx;
+        s2=(n->x_max+BVH_EPSILON-x0)/dx;
+        if (s1>s2){ tmp=s1; s1=s2; s2=tmp; }
+        if (s1>s_min) s_min=s1;
+        if (s2<s_max) s_max=s2;
+    }
+    else if (x0<n->x_min-BVH_EPSILON || x0>n->x_max+BVH_EPSILON) return 0;
+    if (dy!=0){
+        s1=(n->y_min-BVH_EPSILON-y0)/dy;
+        s2=(n->y_max+BVH_EPSILON-y0)/dy;
+        if (s1>s2){ tmp=s1; s1=s2; s2=tmp; }
+        if (s1>s_min) s_min=s1;
+        if (s2<s_max) s_max=s2;
+    }
+    else if (y0<n->y_min-BVH_EPSILON || y0>n->y_max+BVH_EPSILON) return 0;
+
+    *s=s_min;
+    return (s_min<=s_max);
+}
+
+// ---------------------------------------------
+/* fonction: bvh_premier_mur
+    Description:    trouve le premier mur crois par le segment de trajectoire (x0,y0)-(x1,y1),
+                    c'est--dire celui dont le point d'impact est le plus proche de (x0,y0).
+                    L'arbre est parcouru en profondeur en visitant d'abord l'enfant dans
+                    lequel le segment entre en premier. Un noeud est ignor si le segment
+                    n'y entre qu'aprs le meilleur impact trouv. En cas d'galit (coin
+                    entre deux murs), le mur de plus petit indice est choisi, comme lors
+                    d'un test de tous les murs dans l'ordre.
+    Paramtre(s):   bvh             arbre des murs
+                    tab_murs        murs compils du niveau (voir compiler_segment)
+                    x0,y0           position de dpart du segment de trajectoire
+                    x1,y1           position d'arrive du segment de trajectoire
+                    xr,yr           adresses o placer le point d'impact
+    Retour:         l'indice du mur crois, -1 si aucun mur n'est crois
+    Ex. d'utilisation:
+                    mur=bvh_premier_mur(niv->bvh,niv->tab_murs,x0,y0,x1,y1,&xr,&yr);
+*/
+int bvh_premier_mur(t_bvh* bvh, t_segment_compile tab_murs[],
+                    double x0, double y0, double x1, double y1,
+                    double* xr, double* yr)
+{
+    double dx=x1-x0,dy=y1-y0;
+    double l2=dx*dx+dy*dy;              // carr de la longueur du segment
+    int tab_pile[BVH_MAX_PROFONDEUR];   // noeuds  visiter
+    double tab_s[BVH_MAX_PROFONDEUR];   // fraction du segment  l'entre de ces noeuds
+    int nb_pile=0;
+    double s,s_g,s_d,xi,yi,d,d_min=HUGE_VAL;
+    int i,mur,mur_min=-1,croise_g,croise_d;
+    t_noeud_bvh* n;
+
+    if (!croise_noeud(&bvh->tab_noeuds[0],x0,y0,dx,dy,&s)) return -1;
+    tab_pile[nb_pile]=0;
+    tab_s[nb_pile++]=s;
+
+    while (nb_pile>0){
+        nb_pile--;
+        if (tab_s[nb_pile]*tab_s[nb_pile]*l2>d_min) continue;
+        n=&bvh->tab_noeuds[tab_pile[nb_pile]];
+
+        if (n->nb_murs>0){
+            // feuille: tester ses murs
+            for (i=n->premier;i<n->premier+n->nb_murs;i++){
+                mur=bvh->tab_murs[i];
+                if (intersection_segment_compile(x0,y0,x1,y1,&tab_murs[mur],&xi,&yi)){
+                    d=(xi-x0)*(xi-x0)+(yi-y0)*(yi-y0);
+                    if (d<d_min || (d==d_min && mur<mur_min)){
+                        d_min=d;
+                        mur_min=mur;
+                        *xr=xi;
+                        *yr=yi;
+                    }
+                }
+            }
+        }
+        else{
+            // noeud interne: empiler l'enfant le plus loign en premier
+            croise_g=croise_noeud(&bvh->tab_noeuds[n->premier],x0,y0,dx,dy,&s_g);
+            croise_d=croise_noeud(&bvh->tab_noeuds[n->premier+1],x0,y0,dx,dy,&s_d);
+            if (croise_g && croise_d && s_d<s_g){
+                tab_pile[nb_pile]=n->premier;
+                tab_s[nb_pile++]=s_g;
+                tab_pile[nb_pile]=n->premier+1;
+                tab_s[nb_pile++]=s_d;
+            }
+            else{
+                if (croise_d){
+                    tab_pile[nb_pile]=n->premier+1;
+                    tab_s[nb_pile++]=s_d;
+                }
+                if (croise_g){
+                    tab_pile[nb_pile]=n->premier;
+                    tab_s[nb_pile++]=s_g;
+                }
+            }
+        }
+    }
+
+    return mur_min;
+}
+
+// ---------------------------------------------
+/* fonction: bvh_murs_dans_rectangle
+    Description:    trouve les murs dont le rectangle englobant touche un rectangle donn
+                    (ex: les murs visibles dans la fentre). Pour des murs horizontaux
+                    ou verticaux, ce sont exactement les murs qui touchent le rectangle.
+    Paramtre(s):   bvh             arbre des murs
+                    tab_murs        murs compils du niveau (rectangle englobant de chaque mur)
+                    x_min,y_min     coin infrieur gauche du rectangle
+                    x_max,y_max     coin suprieur droit du rectangle
+                    tab_resultat    tableau  remplir avec les indices des murs trouvs
+                    max_resultats   nb d'lments de tab_resultat
+    Retour:         le nombre de murs trouvs (seuls les max_resultats premiers sont
+                    placs dans tab_resultat)
+    Ex. d'utilisation:
+                    nb=bvh_murs_dans_rectangle(niv->bvh,niv->tab_murs,0,0,400,400,tab,niv->nb_segments);
+*/
+int bvh_murs_dans_rectangle(t_bvh* bvh, t_segment_compile tab_murs[],
+                            double x_min, double y_min, double x_max, double y_max,
+                            int tab_resultat[], int max_resultats)
+{
+    int tab_pile[BVH_MAX_PROFONDEUR];
+    int nb_pile=0,nb=0,i,mur;
+    t_noeud_bvh* n;
+
+    tab_pile[nb_pile++]=0;
+    while (nb_pile>0){
+        n=&bvh->tab_noeuds[tab_pile[--nb_pile]];
+        if (n->x_max<x_min || n->x_min>x_max || n->y_max<y_min || n->y_min>y_max) continue;
+
+        if (n->nb_murs>0){
+            for (i=n->premier;i<n->premier+n->nb_murs;i++){
+                mur=bvh->tab_murs[i];
+                if (tab_murs[mur].x_max>=x_min && tab_murs[mur].x_min<=x_max &&
+                    tab_murs[mur].y_max>=y_min && tab_murs[mur].y_min<=y_max){
+                    if (nb<max_resultats) tab_resultat[nb]=mur;
+                    nb++;
+                }
+            }
+        }
+        else{
+            tab_pile[nb_pile++]=n->premier+1;
+            tab_pile[nb_pile++]=n->premier;
+        }
+    }
+
+    return nb;
+}
+
+// ---------------------------------------------
+/* fonction: cout_bvh
+    Description:    cot estim d'une recherche dans l'arbre selon l'heuristique des
+                    surfaces: somme, pour chaque noeud, du cot de sa visite (ou des tests
+                    de ses murs pour une feuille) multipli par la probabilit qu'un segment
+                    croisant la racine croise aussi ce noeud (rapport des primtres).
+                    Plus le cot est faible, meilleur est l'arbre.  comparer avec nb_murs,
+                    le cot d'un test de tous les murs.
+    Paramtre(s):   bvh     arbre des murs
+    Retour:         le cot estim, en nombre quivalent de tests de murs
+*/
+double cout_bvh(t_bvh* bvh)
+{
+    t_noeud_bvh* n=&bvh->tab_noeuds[0];
+    double p_racine=demi_perimetre(n->x_min,n->y_min,n->x_max,n->y_max);
+    double cout=0,p;
+    int i;
+
+    if (p_racine<=0) return BVH_COUT_MUR*bvh->nb_murs;
+    for (i=0;i<bvh->nb_noeuds;i++){
+        n=&bvh->tab_noeuds[i];
+        p=demi_perimetre(n->x_min,n->y_min,n->x_max,n->y_max)/p_racine;
+        if (n->nb_murs>0) cout+=BVH_COUT_MUR*n->nb_murs*p;
+        else cout+=BVH_COUT_NOEUD*p;
+    }
+    return cout;
+}
+
+// ---------------------------------------------
+/* fonction: profondeur_bvh
+    Description:    profondeur de l'arbre (nb de noeuds entre la racine et la feuille
+                    la plus profonde, inclusivement)
+    Paramtre(s):   bvh     arbre des murs
+    Retour:         la profondeur de l'arbre
+*/
+int profondeur_bvh(t_bvh* bvh)
+{
+    int tab_pile[BVH_MAX_PROFONDEUR],tab_prof[BVH_MAX_PROFONDEUR];
+    int nb_pile=0,prof,max_prof=0;
+    t_noeud_bvh* n;
+
+    tab_pile[nb_pile]=0;
+    tab_prof[nb_pile++]=1;
+    while (nb_pile>0){
+        nb_pile--;
+        n=&bvh->tab_noeuds[tab_pile[nb_pile]];
+        prof=tab_prof[nb_pile];
+        if (prof>max_prof) max_prof=prof;
+        if (n->nb_murs==0){
+            tab_pile[nb_pile]=n->premier;
+            tab_prof[nb_pile++]=prof+1;
+            tab_pile[nb_pile]=n->premier+1;
+            tab_prof[nb_pile++]=prof+1;
+        }
+    }
+    return max_prof;
+}
@@ -0,0 +1,74 @@
+#ifndef BVH_H
+#define BVH_H
+
+// -------------------------------------------
+/*
+librairie bvh.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Hirarchie de volumes englobants (BVH) des murs d'un niveau. Chaque noeud
+             de l'arbre est un rectangle align sur les axes qui englobe tous les murs
+             de ses descendants. L'arbre est construit une seule fois au chargement
+             du niveau et rpond  deux requtes:
+             - le mur le plus proche crois par un segment de trajectoire (collisions)
+             - les murs qui touchent un rectangle (murs visibles dans la fentre)
+             Contrairement  la grille uniforme (voir grille.h), l'arbre s'adapte  la
+             rpartition des murs: il reste efficace si les murs sont trs ingalement
+             rpartis dans le niveau.
+Note: les implmentations des fonctions se trouvent dans le fichier bvh.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// paramtres de construction de l'arbre
+// ---------------------------------------------
+#define BVH_MAX_MURS_FEUILLE    4       // nb maximum de murs dans une feuille (sauf profondeur maximum atteinte)
+#define BVH_NB_INTERVALLES      16      // nb d'intervalles pour valuer les dcoupages d'un noeud
+#define BVH_MAX_PROFONDEUR      64      // profondeur maximum de l'arbre (taille de la pile de parcours)
+#define BVH_COUT_NOEUD          1.0     // cot relatif de la visite d'un noeud
+#define BVH_COUT_MUR            1.0     // cot relatif du test d'intersection d'un mur
+
+// ---------------------------------------------
+// noeud de l'arbre
+// un noeud interne a ses deux enfants placs cte  cte dans le tableau de noeuds
+// (premier et premier+1), une feuille dsigne nb_murs murs conscutifs de tab_murs
+// ---------------------------------------------
+typedef struct {
+    double x_min,y_min,x_max,y_max;     // rectangle englobant les murs du noeud
+    int premier;        // feuille: premier mur dans tab_murs, noeud interne: enfant de gauche
+    int nb_murs;        // nb de murs de la feuille, 0 pour un noeud interne
+} t_noeud_bvh;
+
+// ---------------------------------------------
+// arbre des murs d'un niveau
+// ---------------------------------------------
+typedef struct s_bvh {
+    int nb_noeuds;              // nb de noeuds utiliss (la racine est le noeud 0)
+    t_noeud_bvh* tab_noeuds;    // noeuds de l'arbre
+    int nb_murs;                // nb de murs dans l'arbre
+    int* tab_murs;              // indices des murs (lignes du tableau de segments) rangs par feuille
+    int emprunte;               // 1 si les tableaux appartiennent au paquet de niveaux (lecture
+                                // seule, jamais librs; voir paquet_niveaux.h)
+} t_bvh;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+t_bvh* construire_bvh(int tab_segments[][COL_TABSEG], int nb_segments);
+void liberer_bvh(t_bvh* bvh);
+void ajuster_bvh(t_bvh* bvh, int tab_segments[][COL_TABSEG]);
+
+int bvh_premier_mur(t_bvh* bvh, t_segment_compile tab_murs[],
+                    double x0, double y0, double x1, double y1,
+                    double* xr, double* yr);
+int bvh_murs_dans_rectangle(t_bvh* bvh, t_segment_compile tab_murs[],
+                            double x_min, double y_min, double x_max, double y_max,
+                            int tab_resultat[], int max_resultats);
+
+double cout_bvh(t_bvh* bvh);
+int profondeur_bvh(t_bvh* bvh);
+
+#endif // BVH_H
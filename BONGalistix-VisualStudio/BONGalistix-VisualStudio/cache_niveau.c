@@ -0,0 +1,194 @@
+// -------------------------------------------
+/*
+librairie cache_niveau.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Cache en mmoire des fichiers de niveau dj lus.
+Note: les prototypes des fonctions se trouvent dans le fichier cache_niveau.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+
+// verrou du cache (le niveau suivant peut tre charg par un autre fil d'excution)
+#include <SDL_atomic.h>
+
+#include "cache_niveau.h"
+
+// ---------------------------------------------
+// niveau lu partag par le cache et les fils qui le recopient
+// (jamais modifi: une nouvelle lecture du fichier remplace le bloc)
+// ---------------------------------------------
+typedef struct {
+    SDL_atomic_t nb_references;                 // entre du cache et copies en cours (libr  0)
+    t_niveau_lu niveau;                         // murs (tableau  la taille du niveau), lanceur et cible
+} t_niveau_partage;
+
+// ---------------------------------------------
+// niveau gard en mmoire
+// ---------------------------------------------
+typedef struct {
+    t_version_fichier version;                  // version du fichier lu (voir fichier_modifie)
+    t_niveau_partage* partage;                  // niveau lu (NULL si l'entre est vide)
+} t_entree_cache;
+
+static t_entree_cache tab_cache[CACHE_NB_NIVEAUX];  // une entre par index de niveau
+static long nb_succes=0;                            // nb de niveaux recopis du cache
+static long nb_lectures=0;                          // nb de fichiers de niveau lus
+static SDL_SpinLock verrou_cache=0;                 // protge les entres (jamais pendant une copie ou une lecture)
+
+// ---------------------------------------------
+/* fonction: relacher_niveau_partage
+    Description:    abandonne une rfrence  un niveau partag, libr  la dernire
+    Paramtre(s):   partage     niveau partag (NULL accept)
+    Retour:         aucun
+*/
+static void relacher_niveau_partage(t_niveau_partage* partage)
+{
+    if (partage!=NULL && SDL_AtomicDecRef(&partage->nb_references)){
+        liberer_niveau_lu(&partage->niveau);
+        free(partage);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: lire_niveau_cache
+    Description:    comme lire_fichier_niveau pour un niveau du dossier DOSSIER_NIVEAU,
+                    mais le niveau est recopi du cache si son fichier n'a pas chang
+                    depuis sa dernire lecture (mme date de modification et mme taille,
+                    ou mme empreinte du contenu si la date est trop rcente pour tre
+                    fiable, voir fichier_modifie)
+                    Le verrou n'est gard que pour prendre une rfrence au niveau de
+                    l'entre, qui n'est jamais modifi: la copie se fait hors du verrou,
+                    mme si l'entre est remplace entre temps.
+    Paramtre(s):   niveau          # du niveau
+                    lu              niveau lu  remplir (initialis avec initialiser_niveau_lu;
+                                    son tableau de murs est rutilis et agrandi au besoin)
+    Retour:         le nombre de segments de murs, ou -1 en cas d'erreur de lecture du fichier
+    Ex. d'utilisation:
+                    nb=lire_niveau_cache(3,&lu);
+*/
+int lire_niveau_cache(int niveau, t_niveau_lu* lu)
+{
+    char nom_fichier[MAX_CHAR];
+    t_version_fichier version;  // version du fichier gard, puis du fichier actuel
+    t_entree_cache* entree;
+    t_niveau_partage* partage=NULL; // niveau gard  recopier, puis copie du niveau lu pour le cache
+    t_niveau_partage* precedent;    // niveau remplac dans le cache (relch hors du verrou)
+    int nb_segments=-1;
+    int modifie;
+
+    if (niveau<0 || niveau>=CACHE_NB_NIVEAUX){
+        SDL_AtomicLock(&verrou_cache);
+        nb_lectures++;
+        SDL_AtomicUnlock(&verrou_cache);
+        return lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,lu);
+    }
+    entree=&tab_cache[niveau];
+
+    nom_fichier_niveau(niveau,FIN_NOM_FICHIER_NIVEAU,nom_fichier);
+    SDL_AtomicLock(&verrou_cache);
+    version=entree->version;
+    version.connue=(entree->partage!=NULL);
+    SDL_AtomicUnlock(&verrou_cache);
+
+    // (l'empreinte ventuelle du fichier est calcule hors du verrou)
+    modifie=fichier_modifie(nom_fichier,&version,0);
+    if (modifie<0){
+        // fichier disparu: le niveau gard n'est plus valide
+        SDL_AtomicLock(&verrou_cache);
+        precedent=entree->partage;
+        entree->partage=NULL;
+        SDL_AtomicUnlock(&verrou_cache);
+        relacher_niveau_partage(precedent);
+        return -1;
+    }
+
+    // fichier inchang: prendre une rfrence au niveau gard (s'il n'a pas t remplac
+    // entre temps), puis le recopier hors du verrou
+    if (!modifie){
+        SDL_AtomicLock(&verrou_cache);
+        if (entree->partage!=NULL && entree->version.empreinte==version.empreinte){
+            partage=entree->partage;
+            SDL_AtomicIncRef(&partage->nb_references);
+            entree->version=version;
+            nb_succes++;
+        }
+        SDL_AtomicUnlock(&verrou_cache);
+        if (partage!=NULL){
+            nb_segments=partage->niveau.nb_segments;
+            if (reserver_niveau_lu(lu,nb_segments)){
+                memcpy(lu->tab_segments,partage->niveau.tab_segments,nb_segments*sizeof(lu->tab_segments[0]));
+                memcpy(lu->tab_lanceur,partage->niveau.tab_lanceur,sizeof(lu->tab_lanceur));
+                memcpy(lu->tab_cible,partage->niveau.tab_cible,sizeof(lu->tab_cible));
+                lu->nb_segments=nb_segments;
+            }
+            else nb_segments=-1;
+            relacher_niveau_partage(partage);
+            return nb_segments;
+        }
+    }
+
+    // sinon lire le fichier, puis remplacer l'entre du cache par une copie du niveau lu
+    nb_segments=lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,lu);
+    if (nb_segments>=0) partage=(t_niveau_partage*)malloc(sizeof(t_niveau_partage));
+    if (partage!=NULL){
+        initialiser_niveau_lu(&partage->niveau);
+        if (reserver_niveau_lu(&partage->niveau,nb_segments)){
+            memcpy(partage->niveau.tab_segments,lu->tab_segments,nb_segments*sizeof(lu->tab_segments[0]));
+            memcpy(partage->niveau.tab_lanceur,lu->tab_lanceur,sizeof(lu->tab_lanceur));
+            memcpy(partage->niveau.tab_cible,lu->tab_cible,sizeof(lu->tab_cible));
+            partage->niveau.nb_segments=nb_segments;
+            SDL_AtomicSet(&partage->nb_references,1);
+        }
+        else{
+            liberer_niveau_lu(&partage->niveau);
+            free(partage);
+            partage=NULL;
+        }
+    }
+    SDL_AtomicLock(&verrou_cache);
+    entree->version=version;
+    precedent=entree->partage;
+    entree->partage=partage;
+    nb_lectures++;
+    SDL_AtomicUnlock(&verrou_cache);
+    relacher_niveau_partage(precedent);
+    return nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: vider_cache_niveaux
+    Description:    oublie tous les niveaux gards en mmoire et libre leurs tableaux
+                    (ils seront relus)
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void vider_cache_niveaux()
+{
+    t_niveau_partage* tab_niveaux[CACHE_NB_NIVEAUX];    // niveaux retirs du cache (relchs hors du verrou)
+    int i;
+
+    SDL_AtomicLock(&verrou_cache);
+    for (i=0;i<CACHE_NB_NIVEAUX;i++){
+        tab_niveaux[i]=tab_cache[i].partage;
+        tab_cache[i].partage=NULL;
+    }
+    SDL_AtomicUnlock(&verrou_cache);
+    for (i=0;i<CACHE_NB_NIVEAUX;i++) relacher_niveau_partage(tab_niveaux[i]);
+}
+
+// ---------------------------------------------
+/* fonction: statistiques_cache_niveaux
+    Description:    nb de niveaux recopis du cache et nb de fichiers de niveau lus
+                    depuis le dbut du programme
+    Paramtre(s):   nb_succes_cache     adresse o placer le nb de niveaux recopis du cache
+                    nb_lectures_fichier adresse o placer le nb de fichiers lus
+    Retour:         aucun
+*/
+void statistiques_cache_niveaux(long* nb_succes_cache, long* nb_lectures_fichier)
+{
+    *nb_succes_cache=nb_succes;
+    *nb_lectures_fichier=nb_lectures;
+}
@@ -0,0 +1,41 @@
+#ifndef CACHE_NIVEAU_H
+#define CACHE_NIVEAU_H
+
+// -------------------------------------------
+/*
+librairie cache_niveau.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Cache en mmoire des fichiers de niveau dj lus (murs, lanceur et cible).
+             Un niveau rejou (tir rat, clic pendant le vol) est recopi de la mmoire
+             au lieu d'tre relu et dcod. Chaque entre est associe  l'index du
+             niveau et  la version du fichier (date de modification, taille et empreinte
+             du contenu, voir fichier_modifie): d'habitude, seules la date et la taille
+             sont consultes (stat); le contenu n'est relu pour calculer son empreinte que
+             si la date est trop proche de la dernire vrification pour tre fiable (deux
+             critures dans la mme seconde). Le fichier n'est dcod que s'il a chang.
+             Le cache peut servir  plusieurs fils d'excution  la fois: son verrou n'est
+             gard que le temps de prendre une rfrence  un niveau gard, jamais pendant
+             une copie ou la lecture d'un fichier. Il utilise SDL (verrou et compteurs
+             atomiques): le programme le branche  charger_niveau avec
+             choisir_lecture_niveau(lire_niveau_cache).
+Note: les implmentations des fonctions se trouvent dans le fichier cache_niveau.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// taille du cache
+// ---------------------------------------------
+#define CACHE_NB_NIVEAUX    (DERNIER_NIVEAU+1)  // niveaux 0  DERNIER_NIVEAU (les autres ne sont pas gards)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int lire_niveau_cache(int niveau, t_niveau_lu* lu);
+void vider_cache_niveaux();
+void statistiques_cache_niveaux(long* nb_succes_cache, long* nb_lectures_fichier);
+
+#endif // CACHE_NIVEAU_H
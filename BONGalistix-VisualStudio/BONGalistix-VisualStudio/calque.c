@@ -0,0 +1,175 @@
+// -------------------------------------------
+/*
+librairie calque.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Calque d'affichage (texture de rendu) pour les lments qui ne changent pas.
+Note: les prototypes des fonctions se trouvent dans le fichier calque.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "calque.h"
+
+// ---------------------------------------------
+/* fonction: initialiser_calque
+    Description:    prpare un calque vide; la texture est cre au premier dessin,
+                    quand le renderer existe
+    Paramtre(s):   calque          calque  initialiser
+                    largeur,hauteur taille du calque (celle de la fentre)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    initialiser_calque(&calque_murs,LARGEUR_FEN,HAUTEUR_FEN);
+*/
+void initialiser_calque(t_calque* calque, int largeur, int hauteur)
+{
+    calque->texture=NULL;
+    calque->largeur=largeur;
+    calque->hauteur=hauteur;
+    calque->pret=0;
+}
+
+// ---------------------------------------------
+/* fonction: calque_debut_dessin
+    Description:    redirige les fonctions de dessin vers le calque et l'efface
+                    (fond transparent). La texture est cre au besoin.
+    Note:           chaque appel russi doit tre suivi d'un appel  calque_fin_dessin
+                    pour revenir au dessin dans la fentre
+    Paramtre(s):   calque  calque dans lequel dessiner
+    Retour:         1 si le dessin se fait dans le calque, 0 si le renderer ne le
+                    permet pas (rien n'est chang)
+    Ex. d'utilisation:
+                    if (calque_debut_dessin(&calque_murs)){
+                        afficher_murs(...);
+                        calque_fin_dessin(&calque_murs);
+                    }
+*/
+int calque_debut_dessin(t_calque* calque)
+{
+    if (!SDL_RenderTargetSupported(renderer)) return 0;
+
+    if (calque->texture==NULL){
+        calque->texture=SDL_CreateTexture(renderer,SDL_PIXELFORMAT_RGBA8888,SDL_TEXTUREACCESS_TARGET,
+                                          calque->largeur,calque->hauteur);
+        if (calque->texture==NULL){
+            printf("[ERR] - Creation du calque impossible: %s\n",SDL_GetError());
+            return 0;
+        }
+        // les pixels transparents du calque laissent voir le fond
+        SDL_SetTextureBlendMode(calque->texture,SDL_BLENDMODE_BLEND);
+    }
+    if (SDL_SetRenderTarget(renderer,calque->texture)<0) return 0;
+
+    graph_clear(0,0,0,0);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: calque_reprendre_dessin
+    Description:    redirige les fonctions de dessin vers un calque dj dessin, sans
+                    l'effacer, pour n'en modifier qu'une partie
+    Note:           chaque appel russi doit tre suivi d'un appel  calque_fin_dessin
+    Paramtre(s):   calque  calque prt (voir calque_pret)
+    Retour:         1 si le dessin se fait dans le calque, 0 si le calque n'est pas prt
+                    ou si le renderer ne le permet plus (le calque doit tre redessin
+                    au complet avec calque_debut_dessin)
+*/
+int calque_reprendre_dessin(t_calque* calque)
+{
+    if (!calque->pret) return 0;
+    return SDL_SetRenderTarget(renderer,calque->texture)==0;
+}
+
+// ---------------------------------------------
+/* fonction: calque_effacer_zone
+    Description:    efface une zone du calque (pixels transparents) et limite les prochains
+                    tracs  cette zone, pour y redessiner les lments modifis: seules
+                    leurs parties dans la zone sont dessines
+    Note:            appeler entre calque_reprendre_dessin et calque_fin_dessin, qui
+                    retire la limite
+    Paramtre(s):   calque          calque en cours de dessin
+                    x1,y1,x2,y2     coins infrieur gauche et suprieur droit de la zone
+                                    (coordonnes du jeu, origine au coin infrieur gauche)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    if (calque_reprendre_dessin(&calque_murs)){
+                        calque_effacer_zone(&calque_murs,100,100,200,150);
+                        afficher_murs(...);
+                        calque_fin_dessin(&calque_murs);
+                    }
+*/
+void calque_effacer_zone(t_calque* calque, int x1, int y1, int x2, int y2)
+{
+    SDL_Rect rect={x1,calque->hauteur-1-y2,x2-x1+1,y2-y1+1};
+
+    // SDL_RenderClear ignore la limite de trac: remplir la zone avec la couleur transparente
+    // (le renderer trace sans mlange: les pixels sont remplacs)
+    SDL_RenderSetClipRect(renderer,&rect);
+    graph_select_couleur(0,0,0,0);
+    SDL_RenderFillRect(renderer,&rect);
+}
+
+// ---------------------------------------------
+/* fonction: calque_fin_dessin
+    Description:    termine le dessin dans le calque et revient au dessin dans la fentre.
+                    Le calque est prt  tre affich.
+    Paramtre(s):   calque  calque dessin
+    Retour:         aucun
+*/
+void calque_fin_dessin(t_calque* calque)
+{
+    SDL_RenderSetClipRect(renderer,NULL);
+    SDL_SetRenderTarget(renderer,NULL);
+    calque->pret=1;
+}
+
+// ---------------------------------------------
+/* fonction: calque_pret
+    Description:    indique si le calque contient un dessin  jour
+    Paramtre(s):   calque  calque  vrifier
+    Retour:         1 si le calque peut tre affich, 0 s'il doit tre (re)dessin
+*/
+int calque_pret(t_calque* calque)
+{
+    return calque->pret;
+}
+
+// ---------------------------------------------
+/* fonction: calque_invalider
+    Description:    indique que le contenu du calque n'est plus  jour (ex: nouveau niveau
+                    charg ou textures perdues par le renderer, vnement
+                    SDL_RENDER_TARGETS_RESET). La texture est conserve.
+    Paramtre(s):   calque  calque  redessiner
+    Retour:         aucun
+*/
+void calque_invalider(t_calque* calque)
+{
+    calque->pret=0;
+}
+
+// ---------------------------------------------
+/* fonction: calque_afficher
+    Description:    recopie le calque dans la fentre par-dessus ce qui est dj trac
+    Note:           comme pour toutes les fonctions de dessin graphique, le rsultat ne sera
+                    visible qu'aprs un appel  la fonction graph_mise_a_jour();
+    Paramtre(s):   calque  calque prt  afficher (voir calque_pret)
+    Retour:         aucun
+*/
+void calque_afficher(t_calque* calque)
+{
+    if (calque->pret) SDL_RenderCopy(renderer,calque->texture,NULL,NULL);
+}
+
+// ---------------------------------------------
+/* fonction: liberer_calque
+    Description:    libre la texture du calque (avant graph_fin)
+    Paramtre(s):   calque  calque  librer
+    Retour:         aucun
+*/
+void liberer_calque(t_calque* calque)
+{
+    if (calque->texture!=NULL) SDL_DestroyTexture(calque->texture);
+    calque->texture=NULL;
+    calque->pret=0;
+}
@@ -0,0 +1,48 @@
+#ifndef CALQUE_H
+#define CALQUE_H
+
+// -------------------------------------------
+/*
+librairie calque.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Calque d'affichage: texture de la taille de la fentre dans laquelle
+             les fonctions de dessin de graph.h peuvent tracer une fois pour toutes
+             des lments qui ne changent pas (ex: les murs d'un niveau). Le calque
+             est ensuite recopi  chaque affichage en une seule opration, peu importe
+             le nb d'lments qu'il contient.
+             Le fond du calque est transparent: il se superpose  ce qui est dj trac.
+             Si le renderer ne permet pas de dessiner dans une texture, le calque n'est
+             jamais prt et les lments doivent tre tracs directement  chaque affichage.
+             Le contenu du calque peut aussi tre perdu par le renderer (ex: changement
+             de carte graphique); il doit alors tre redessin (voir calque_invalider).
+Note: les implmentations des fonctions se trouvent dans le fichier calque.c
+*/
+// -------------------------------------------
+
+#include "graph.h"
+
+// ---------------------------------------------
+// calque d'affichage
+// ---------------------------------------------
+typedef struct {
+    SDL_Texture* texture;   // texture cible du dessin (NULL si pas encore cre ou impossible)
+    int largeur, hauteur;   // taille du calque (pixels)
+    int pret;               // 1 si la texture contient le dessin  jour
+} t_calque;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void initialiser_calque(t_calque* calque, int largeur, int hauteur);
+int calque_debut_dessin(t_calque* calque);
+int calque_reprendre_dessin(t_calque* calque);
+void calque_effacer_zone(t_calque* calque, int x1, int y1, int x2, int y2);
+void calque_fin_dessin(t_calque* calque);
+int calque_pret(t_calque* calque);
+void calque_invalider(t_calque* calque);
+void calque_afficher(t_calque* calque);
+void liberer_calque(t_calque* calque);
+
+#endif // CALQUE_H
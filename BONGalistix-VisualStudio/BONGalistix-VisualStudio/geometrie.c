@@ -14,6 +14,7 @@ Note: les prototypes des fonctions se trouvent dans le fichier geometrie.c
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "geometrie.h"
 #include "math.h"
 
@@ -248,9 +249,10 @@ int intersection_segments(double ax1, double ay1, double bx1, double by1, /*veri
 
 	else
 	{
-		intersection_droites(a1, b1, c1, a2, b2, c2, x, y);
-
-		if (element_du_segment(ax1, ay1, bx1, by1, *x, *y) && element_du_segment(ax2, ay2, bx2, by2, *x, *y))
+		// des droites parallles n'ont pas de point d'intersection: x et y ne sont
+		// alors pas modifis et ne doivent pas tre tests
+		if (intersection_droites(a1, b1, c1, a2, b2, c2, x, y) &&
+			element_du_segment(ax1, ay1, bx1, by1, *x, *y) && element_du_segment(ax2, ay2, bx2, by2, *x, *y))
 		{
 			result = 1;
 		}
@@ -332,6 +334,192 @@ int element_du_segment(double ax, double ay, double bx, double by, double x, dou
 	return result;
 }
 
+// ---------------------------------------------
+/* fonction: orientation_segment
+	Description:    dtermine si un segment est horizontal, vertical ou oblique.
+					Un segment rduit  un point est considr vertical, comme
+					dans equation_droite.
+	Paramtre(s):   ax,ay   coordonnes d'une extrmit du segment
+					bx,by   coordonnes de l'autre extrmit du segment
+	Retour:         SEGMENT_VERTICAL, SEGMENT_HORIZONTAL ou SEGMENT_OBLIQUE
+	Ex. d'utilisation:
+					o=orientation_segment(10,10,10,200);	// renvoie SEGMENT_VERTICAL
+*/
+int orientation_segment(double ax, double ay, double bx, double by) {
+	int result = SEGMENT_OBLIQUE;
+	if (ax == bx) result = SEGMENT_VERTICAL;
+	else if (ay == by) result = SEGMENT_HORIZONTAL;
+	return result;
+}
+
+// ---------------------------------------------
+/* fonction: intersection_segment_horizontal
+	Description:    intersection d'un segment quelconque (A1)-(B1) avec un segment
+					horizontal d'ordonne yh allant de l'abscisse xa  xb.
+					Mthode des tranches: la fraction s du segment 1  laquelle il
+					atteint l'ordonne yh est calcule (une seule division), puis
+					il suffit de vrifier que s est entre 0 et 1 et que l'abscisse
+					atteinte est entre xa et xb. Aucune quation de droite n'est
+					calcule.
+	Paramtre(s):   ax1,ay1 coordonnes d'une extrmit du segment 1
+					bx1,by1 coordonnes de l'autre extrmit du segment 1
+					xa,xb   abscisses des extrmits du segment horizontal
+					yh      ordonne du segment horizontal
+					x,y     les coordonnes du point d'intersection entre les segments.
+	Retour:         1 si les segments se croisent, 0 sinon. Les coordonnes du point
+					de croisement sont mises dans x et y (y vaut exactement yh)
+	Note:           Comme pour intersection_segments, un segment 1 parallle
+					(horizontal) ne croise jamais le segment horizontal.
+	Ex. d'utilisation:
+					// croisement du segment (1,1)-(3,5) avec le segment (0,2)-(4,2)
+					intersection_segment_horizontal(1,1,3,5,0,4,2,&x,&y);
+*/
+int intersection_segment_horizontal(double ax1, double ay1, double bx1, double by1,
+	double xa, double xb, double yh,
+	double* x, double* y) {
+	double s, xi;
+	if (ay1 == by1) return 0;
+	s = (yh - ay1) / (by1 - ay1);
+	if (s < 0 || s > 1) return 0;
+	xi = ax1 + s * (bx1 - ax1);
+	if ((xi >= xa && xi <= xb) || (xi >= xb && xi <= xa))
+	{
+		*x = xi;
+		*y = yh;
+		return 1;
+	}
+	return 0;
+}
+
+// ---------------------------------------------
+/* fonction: intersection_segment_vertical
+	Description:    intersection d'un segment quelconque (A1)-(B1) avec un segment
+					vertical d'abscisse xv allant de l'ordonne ya  yb.
+					Mme mthode que intersection_segment_horizontal en changeant
+					les rles de x et y.
+	Paramtre(s):   ax1,ay1 coordonnes d'une extrmit du segment 1
+					bx1,by1 coordonnes de l'autre extrmit du segment 1
+					ya,yb   ordonnes des extrmits du segment vertical
+					xv      abscisse du segment vertical
+					x,y     les coordonnes du point d'intersection entre les segments.
+	Retour:         1 si les segments se croisent, 0 sinon. Les coordonnes du point
+					de croisement sont mises dans x et y (x vaut exactement xv)
+	Ex. d'utilisation:
+					// croisement du segment (1,1)-(3,5) avec le segment (2,0)-(2,10)
+					intersection_segment_vertical(1,1,3,5,0,10,2,&x,&y);
+*/
+int intersection_segment_vertical(double ax1, double ay1, double bx1, double by1,
+	double ya, double yb, double xv,
+	double* x, double* y) {
+	double s, yi;
+	if (ax1 == bx1) return 0;
+	s = (xv - ax1) / (bx1 - ax1);
+	if (s < 0 || s > 1) return 0;
+	yi = ay1 + s * (by1 - ay1);
+	if ((yi >= ya && yi <= yb) || (yi >= yb && yi <= ya))
+	{
+		*x = xv;
+		*y = yi;
+		return 1;
+	}
+	return 0;
+}
+
+// ---------------------------------------------
+/* fonction: intersection_segments_orientes
+	Description:    intersection de segments lorsque l'orientation du segment 2 est
+					connue d'avance (ex: murs classs au chargement du niveau).
+					Les segments 2 horizontaux et verticaux utilisent les tests
+					spcialiss, les autres le test gnrique intersection_segments.
+	Paramtre(s):   ax1,ay1,bx1,by1 extrmits du segment 1
+					ax2,ay2,bx2,by2 extrmits du segment 2
+					orientation2    orientation du segment 2 (voir orientation_segment)
+					x,y             les coordonnes du point d'intersection entre les segments.
+	Retour:         1 si les segments se croisent, 0 sinon. Les coordonnes du point
+					de croisement sont mises dans x et y
+	Ex. d'utilisation:
+					intersection_segments_orientes(1,1,3,5,0,2,4,2,SEGMENT_HORIZONTAL,&x,&y);
+*/
+int intersection_segments_orientes(double ax1, double ay1, double bx1, double by1,
+	double ax2, double ay2, double bx2, double by2,
+	int orientation2, double* x, double* y) {
+	int result;
+	if (orientation2 == SEGMENT_HORIZONTAL)
+		result = intersection_segment_horizontal(ax1, ay1, bx1, by1, ax2, bx2, ay2, x, y);
+	else if (orientation2 == SEGMENT_VERTICAL)
+		result = intersection_segment_vertical(ax1, ay1, bx1, by1, ay2, by2, ax2, x, y);
+	else
+		result = intersection_segments(ax1, ay1, bx1, by1, ax2, ay2, bx2, by2, x, y);
+	return result;
+}
+
+// ---------------------------------------------
+/* fonction: compiler_segment
+	Description:    calcule une fois pour toutes les donnes d'un segment qui ne
+					dpendent que de ses extrmits: extrmits en rels, quation de
+					la droite (voir equation_droite), normale unitaire, rectangle
+					englobant et orientation (voir orientation_segment)
+	Paramtre(s):   ax,ay   coordonnes d'une extrmit du segment
+					bx,by   coordonnes de l'autre extrmit du segment
+					seg     adresse du segment compil  remplir
+	Retour:         aucun
+	Ex. d'utilisation:
+					compiler_segment(10,10,10,200,&seg);	// seg.orientation vaut SEGMENT_VERTICAL
+*/
+void compiler_segment(double ax, double ay, double bx, double by, t_segment_compile* seg) {
+	double l = longueur(ax, ay, bx, by);
+
+	// octets de remplissage compris: deux segments compils identiques ont la mme mmoire
+	memset(seg, 0, sizeof(*seg));
+	seg->ax = ax;
+	seg->ay = ay;
+	seg->bx = bx;
+	seg->by = by;
+	equation_droite(ax, ay, bx, by, &seg->a, &seg->b, &seg->c);
+	if (l > 0)
+	{
+		seg->nx = -(by - ay) / l;
+		seg->ny = (bx - ax) / l;
+	}
+	seg->x_min = fmin(ax, bx);
+	seg->y_min = fmin(ay, by);
+	seg->x_max = fmax(ax, bx);
+	seg->y_max = fmax(ay, by);
+	seg->orientation = orientation_segment(ax, ay, bx, by);
+}
+
+// ---------------------------------------------
+/* fonction: intersection_segment_compile
+	Description:    mme rsultat que intersection_segments_orientes lorsque le
+					segment 2 est compil: les segments horizontaux et verticaux
+					utilisent les tests spcialiss, les autres le test gnrique
+					avec l'quation de droite dj calcule du segment 2 (seule celle
+					du segment 1 est calcule).
+	Paramtre(s):   ax1,ay1,bx1,by1 extrmits du segment 1
+					seg2            segment 2 compil (voir compiler_segment)
+					x,y             les coordonnes du point d'intersection entre les segments.
+	Retour:         1 si les segments se croisent, 0 sinon. Les coordonnes du point
+					de croisement sont mises dans x et y
+	Ex. d'utilisation:
+					intersection_segment_compile(1,1,3,5,&niv->tab_murs[i],&x,&y);
+*/
+int intersection_segment_compile(double ax1, double ay1, double bx1, double by1,
+	const t_segment_compile* seg2, double* x, double* y) {
+	double a1, b1, c1;	// coefficients de l'quation de la droite du segment 1
+
+	if (seg2->orientation == SEGMENT_HORIZONTAL)
+		return intersection_segment_horizontal(ax1, ay1, bx1, by1, seg2->ax, seg2->bx, seg2->ay, x, y);
+	if (seg2->orientation == SEGMENT_VERTICAL)
+		return intersection_segment_vertical(ax1, ay1, bx1, by1, seg2->ay, seg2->by, seg2->ax, x, y);
+
+	// segment 2 oblique (jamais vertical): le point est dans le segment 2 si son
+	// abscisse est dans le rectangle englobant (voir element_du_segment)
+	equation_droite(ax1, ay1, bx1, by1, &a1, &b1, &c1);
+	return intersection_droites(a1, b1, c1, seg2->a, seg2->b, seg2->c, x, y) &&
+		element_du_segment(ax1, ay1, bx1, by1, *x, *y) &&
+		*x >= seg2->x_min && *x <= seg2->x_max;
+}
+
 // ---------------------------------------------
 /* fonction: signe
 	Description:    calcule le signe d'un rel
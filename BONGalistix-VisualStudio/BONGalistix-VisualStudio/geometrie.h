@@ -13,6 +13,26 @@ Note: les prototypes des fonctions se trouvent dans le fichier geometrie.c
 */
 // -------------------------------------------
 
+// ---------------------------------------------
+// orientation d'un segment (voir orientation_segment)
+// ---------------------------------------------
+#define SEGMENT_OBLIQUE     0   // segment quelconque (test d'intersection gnrique)
+#define SEGMENT_HORIZONTAL  1   // segment horizontal (ay==by)
+#define SEGMENT_VERTICAL    2   // segment vertical (ax==bx)
+
+// ---------------------------------------------
+// segment compil: donnes qui ne dpendent que des extrmits du segment,
+// calcules une seule fois (voir compiler_segment), ex: murs d'un niveau
+// ---------------------------------------------
+typedef struct {
+    double ax,ay,bx,by;             // extrmits du segment
+    double a,b,c;                   // quation de la droite c.y=a.x+b (voir equation_droite)
+    double nx,ny;                   // normale unitaire (segment tourn d'un quart de tour
+                                    // vers la gauche, nulle si le segment est rduit  un point)
+    double x_min,y_min,x_max,y_max; // rectangle englobant
+    int orientation;                // SEGMENT_HORIZONTAL, SEGMENT_VERTICAL ou SEGMENT_OBLIQUE
+} t_segment_compile;
+
 // ---------------------------------------------
 // Prototypes des fonctions de la librairie
 // ---------------------------------------------
@@ -35,6 +55,25 @@ int intersection_segments(double ax1, double ay1, double bx1, double by1,
 int element_du_segment(double ax,double ay,double bx,double by,
                        double x,double y);
 
+int orientation_segment(double ax, double ay, double bx, double by);
+
+int intersection_segment_horizontal(double ax1, double ay1, double bx1, double by1,
+                                    double xa, double xb, double yh,
+                                    double* x, double* y);
+
+int intersection_segment_vertical(double ax1, double ay1, double bx1, double by1,
+                                  double ya, double yb, double xv,
+                                  double* x, double* y);
+
+int intersection_segments_orientes(double ax1, double ay1, double bx1, double by1,
+                                   double ax2, double ay2, double bx2, double by2,
+                                   int orientation2, double* x, double* y);
+
+void compiler_segment(double ax, double ay, double bx, double by, t_segment_compile* seg);
+
+int intersection_segment_compile(double ax1, double ay1, double bx1, double by1,
+                                 const t_segment_compile* seg2, double* x, double* y);
+
 int signe(double x);
 
 double longueur(double x0, double y0, double x1, double y1);
@@ -129,6 +129,161 @@ void graph_trace_rectangle(int x1,int y1,int x2,int y2){
 
 }
 
+// ---------------------------------------------
+// Fonctions de trac en lot: les coordonnes de toutes les primitives sont
+// converties (origine en bas  gauche vers origine en haut  gauche) dans un
+// tampon puis soumises  SDL en un seul appel par tampon plein.
+// ---------------------------------------------
+
+static SDL_Point tab_points_lot[GRAPH_TAILLE_LOT];  // tampon de points convertis
+static SDL_Rect tab_rects_lot[GRAPH_TAILLE_LOT];    // tampon de rectangles convertis
+
+// ---------------------------------------------
+/* fonction: convertir_points
+    Description:    copie des points dans le tampon de points en inversant l'axe vertical.
+                    La mme opration sur tous les points, sans branchement, permet au
+                    compilateur de vectoriser la boucle.
+    Paramtre(s):   tab_points  points  convertir (x,y)
+                    nb_points   nb de points (au plus GRAPH_TAILLE_LOT)
+    Retour:         Aucun
+*/
+static void convertir_points(int tab_points[][2],int nb_points){
+    int i;
+
+    for (i=0;i<nb_points;i++){
+        tab_points_lot[i].x=tab_points[i][0];
+        tab_points_lot[i].y=HAUTEUR_FEN-1-tab_points[i][1];
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_points
+    Description:    trace un lot de points, comme graph_trace_point pour chacun
+    Note:           Comme pour toute les fonctions de dessin, l'effet ne sera visible
+                     l'cran qu'aprs un appel de la fonction graph_mise_a_jour.
+    Paramtre(s):   tab_points  tableau des points  tracer (x,y)
+                    nb_points   nb de points du tableau
+    Retour:         Aucun
+    Ex. d'utilisation:
+                    graph_trace_points(tab_points,100); // tracer 100 points
+*/
+void graph_trace_points(int tab_points[][2],int nb_points){
+    int i,n;
+
+    for (i=0;i<nb_points;i+=n){
+        n=(nb_points-i<GRAPH_TAILLE_LOT)?nb_points-i:GRAPH_TAILLE_LOT;
+        convertir_points(tab_points+i,n);
+        SDL_RenderDrawPoints(renderer,tab_points_lot,n);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_polyligne
+    Description:    trace une ligne brise reliant les points dans l'ordre du tableau
+                    (ex: trane du projectile)
+    Note:           Comme pour toute les fonctions de dessin, l'effet ne sera visible
+                     l'cran qu'aprs un appel de la fonction graph_mise_a_jour.
+    Paramtre(s):   tab_points  tableau des sommets de la ligne (x,y)
+                    nb_points   nb de sommets (un seul sommet trace un point)
+    Retour:         Aucun
+    Ex. d'utilisation:
+                    graph_trace_polyligne(tab_trainee,50);
+*/
+void graph_trace_polyligne(int tab_points[][2],int nb_points){
+    int i,n;
+
+    if (nb_points==1) graph_trace_points(tab_points,1);
+    // les lots successifs partagent un sommet pour que la ligne reste continue
+    for (i=0;i<nb_points-1;i+=n-1){
+        n=(nb_points-i<GRAPH_TAILLE_LOT)?nb_points-i:GRAPH_TAILLE_LOT;
+        convertir_points(tab_points+i,n);
+        SDL_RenderDrawLines(renderer,tab_points_lot,n);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_segments
+    Description:    trace un lot de segments (x1,y1,x2,y2), comme graph_trace_segment
+                    pour chacun. Les segments horizontaux et verticaux sont tracs comme des
+                    rectangles pleins d'un pixel de large, tous en un seul appel. Les autres
+                    sont relis en lignes brises quand un segment commence o finit le
+                    prcdent.
+    Note:           Comme pour toute les fonctions de dessin, l'effet ne sera visible
+                     l'cran qu'aprs un appel de la fonction graph_mise_a_jour.
+    Paramtre(s):   tab_segments    tableau des segments  tracer (x1,y1,x2,y2)
+                    nb_segments     nb de segments du tableau
+    Retour:         Aucun
+    Ex. d'utilisation:
+                    graph_trace_segments(tab_murs,nb_murs);
+*/
+void graph_trace_segments(int tab_segments[][4],int nb_segments){
+    int i,x1,y1,x2,y2;
+    int nb_rects=0;     // nb de rectangles dans le tampon
+    int nb_points=0;    // nb de sommets de la ligne brise en cours dans le tampon
+
+    for (i=0;i<nb_segments;i++){
+        x1=tab_segments[i][0];
+        y1=HAUTEUR_FEN-1-tab_segments[i][1];
+        x2=tab_segments[i][2];
+        y2=HAUTEUR_FEN-1-tab_segments[i][3];
+        if (x1==x2 || y1==y2){
+            tab_rects_lot[nb_rects].x=(x1<x2)?x1:x2;
+            tab_rects_lot[nb_rects].y=(y1<y2)?y1:y2;
+            tab_rects_lot[nb_rects].w=abs(x2-x1)+1;
+            tab_rects_lot[nb_rects].h=abs(y2-y1)+1;
+            if (++nb_rects==GRAPH_TAILLE_LOT){
+                SDL_RenderFillRects(renderer,tab_rects_lot,nb_rects);
+                nb_rects=0;
+            }
+        }
+        else{
+            // commencer une nouvelle ligne brise si le segment ne prolonge pas la prcdente
+            if (nb_points==0 || tab_points_lot[nb_points-1].x!=x1 || tab_points_lot[nb_points-1].y!=y1){
+                if (nb_points>=2) SDL_RenderDrawLines(renderer,tab_points_lot,nb_points);
+                tab_points_lot[0].x=x1;
+                tab_points_lot[0].y=y1;
+                nb_points=1;
+            }
+            tab_points_lot[nb_points].x=x2;
+            tab_points_lot[nb_points].y=y2;
+            if (++nb_points==GRAPH_TAILLE_LOT){
+                SDL_RenderDrawLines(renderer,tab_points_lot,nb_points);
+                tab_points_lot[0]=tab_points_lot[nb_points-1];
+                nb_points=1;
+            }
+        }
+    }
+    if (nb_rects>0) SDL_RenderFillRects(renderer,tab_rects_lot,nb_rects);
+    if (nb_points>=2) SDL_RenderDrawLines(renderer,tab_points_lot,nb_points);
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_rectangles
+    Description:    trace un lot de rectangles donns par leur coin infrieur gauche et
+                    suprieur droit (x1,y1,x2,y2), comme graph_trace_rectangle pour chacun
+    Note:           Comme pour toute les fonctions de dessin, l'effet ne sera visible
+                     l'cran qu'aprs un appel de la fonction graph_mise_a_jour.
+    Paramtre(s):   tab_rectangles  tableau des rectangles  tracer (x1,y1,x2,y2)
+                    nb_rectangles   nb de rectangles du tableau
+    Retour:         Aucun
+    Ex. d'utilisation:
+                    graph_trace_rectangles(tab_projectiles,nb_projectiles);
+*/
+void graph_trace_rectangles(int tab_rectangles[][4],int nb_rectangles){
+    int i,n,k;
+
+    for (i=0;i<nb_rectangles;i+=n){
+        n=(nb_rectangles-i<GRAPH_TAILLE_LOT)?nb_rectangles-i:GRAPH_TAILLE_LOT;
+        for (k=0;k<n;k++){
+            tab_rects_lot[k].w=abs(tab_rectangles[i+k][2]-tab_rectangles[i+k][0]);
+            tab_rects_lot[k].h=abs(tab_rectangles[i+k][3]-tab_rectangles[i+k][1]);
+            tab_rects_lot[k].x=tab_rectangles[i+k][0];
+            tab_rects_lot[k].y=HAUTEUR_FEN-1-tab_rectangles[i+k][1]-tab_rects_lot[k].h;
+        }
+        SDL_RenderDrawRects(renderer,tab_rects_lot,n);
+    }
+}
+
 // ---------------------------------------------
 /* fonction: graph_mise_a_jour
     Description:    mise a jour de la fenetre graphique pour faire apparaitre tous les tracs
@@ -42,6 +42,10 @@ extern SDL_Event event;                // evenement souris/clavier/croix/...
 #define LARGEUR_FEN   400
 #define HAUTEUR_FEN   400
 
+// nb de primitives converties  la fois par les fonctions de trac en lot
+// (les lots plus grands sont soumis  SDL en plusieurs appels)
+#define GRAPH_TAILLE_LOT    1024
+
 // ---------------------------------------------
 // Prototypes des fonctions d'encapsulation des
 // graphiques de la librairie SDL
@@ -52,6 +56,10 @@ void graph_clear(int r, int g, int b, int a);
 void graph_trace_point(int x,int y);
 void graph_trace_segment(int x1,int y1,int x2,int y2);
 void graph_trace_rectangle(int x1,int y1,int x2,int y2);
+void graph_trace_points(int tab_points[][2],int nb_points);
+void graph_trace_polyligne(int tab_points[][2],int nb_points);
+void graph_trace_segments(int tab_segments[][4],int nb_segments);
+void graph_trace_rectangles(int tab_rectangles[][4],int nb_rectangles);
 void graph_mise_a_jour();
 void graph_get_mousexy(int *mousex,int *mousey);
 void graph_delai_ms(int milisec);
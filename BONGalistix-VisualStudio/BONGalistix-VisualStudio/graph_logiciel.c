@@ -0,0 +1,585 @@
+// -------------------------------------------
+/*
+librairie graph_logiciel.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rendu logiciel des fonctions de graph.h dans une image en mmoire.
+             Remplace graph.c  l'dition des liens (un seul des deux fichiers par
+             programme).
+Note: les prototypes des fonctions se trouvent dans les fichiers graph.h et
+      graph_logiciel.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <SDL.h>
+
+// fichiers de prototypes des fonctions graphiques
+#include "graph.h"
+#include "graph_logiciel.h"
+
+// ---------------------------------------------
+// variables globales de graph.h (pas de fentre ni de renderer)
+// ---------------------------------------------
+SDL_Window* fenetre = NULL;     // Fenetre graphique (toujours NULL)
+SDL_Renderer* renderer = NULL;  // renderer (toujours NULL)
+Uint8 r,g,b,a;                  // variables pour la gestion des couleurs
+SDL_Event event;                // evenement souris/clavier/croix/... (jamais reu)
+
+// ---------------------------------------------
+// image en mmoire
+// ---------------------------------------------
+static Uint32* tab_pixels = NULL;   // pixels de l'image, ligne par ligne  partir du haut
+static int largeur_image = 0;       // nb de pixels par ligne
+static int hauteur_image = 0;       // nb de lignes
+static Uint32 couleur = 0;          // couleur active (octets R,G,B,A dans l'ordre en mmoire)
+static int nb_images = 0;           // nb d'appels de graph_mise_a_jour
+static char modele_capture[FILENAME_MAX] = "";  // modle du nom des images sauvegardes
+
+// ---------------------------------------------
+// Fonctions de trac dans l'image (coordonnes de l'image: origine en haut  gauche)
+// ---------------------------------------------
+
+// ---------------------------------------------
+/* fonction: remplir_rangee
+    Description:    colorie les pixels (x1..x2,y) d'une ligne de l'image, limits  l'image.
+                    La boucle sans branchement est vectorise par le compilateur.
+    Paramtre(s):   x1,x2   premire et dernire colonne (dans n'importe quel ordre)
+                    y       ligne
+    Retour:         Aucun
+*/
+static void remplir_rangee(int x1,int x2,int y){
+    Uint32* ligne;
+    int x,tmp;
+
+    if (x1>x2){ tmp=x1; x1=x2; x2=tmp; }
+    if (y<0 || y>=hauteur_image || x2<0 || x1>=largeur_image) return;
+    if (x1<0) x1=0;
+    if (x2>=largeur_image) x2=largeur_image-1;
+    ligne=tab_pixels+(size_t)y*largeur_image;
+    for (x=x1;x<=x2;x++) ligne[x]=couleur;
+}
+
+// ---------------------------------------------
+/* fonction: remplir_colonne
+    Description:    colorie les pixels (x,y1..y2) d'une colonne de l'image, limits  l'image
+    Paramtre(s):   x       colonne
+                    y1,y2   premire et dernire ligne (dans n'importe quel ordre)
+    Retour:         Aucun
+*/
+static void remplir_colonne(int x,int y1,int y2){
+    Uint32* pixel;
+    int y,tmp;
+
+    if (y1>y2){ tmp=y1; y1=y2; y2=tmp; }
+    if (x<0 || x>=largeur_image || y2<0 || y1>=hauteur_image) return;
+    if (y1<0) y1=0;
+    if (y2>=hauteur_image) y2=hauteur_image-1;
+    pixel=tab_pixels+(size_t)y1*largeur_image+x;
+    for (y=y1;y<=y2;y++,pixel+=largeur_image) *pixel=couleur;
+}
+
+// ---------------------------------------------
+/* fonction: tracer_ligne
+    Description:    trace une ligne entre deux pixels (extrmits comprises), comme
+                    SDL_RenderDrawLine. Les lignes horizontales et verticales sont remplies
+                    directement; les autres sont traces par l'algorithme de Bresenham
+                    (arithmtique entire, un pixel par pas sur l'axe principal).
+    Paramtre(s):   x1,y1   premire extrmit
+                    x2,y2   deuxime extrmit
+    Retour:         Aucun
+*/
+static void tracer_ligne(int x1,int y1,int x2,int y2){
+    int dx=abs(x2-x1),dy=-abs(y2-y1);
+    int sx=(x1<x2)?1:-1,sy=(y1<y2)?1:-1;
+    int erreur=dx+dy,e2;
+
+    if (y1==y2){
+        remplir_rangee(x1,x2,y1);
+        return;
+    }
+    if (x1==x2){
+        remplir_colonne(x1,y1,y2);
+        return;
+    }
+    for (;;){
+        if (x1>=0 && x1<largeur_image && y1>=0 && y1<hauteur_image){
+            tab_pixels[(size_t)y1*largeur_image+x1]=couleur;
+        }
+        if (x1==x2 && y1==y2) break;
+        e2=2*erreur;
+        if (e2>=dy){ erreur+=dy; x1+=sx; }
+        if (e2<=dx){ erreur+=dx; y1+=sy; }
+    }
+}
+
+// ---------------------------------------------
+/* fonction: tracer_contour
+    Description:    trace le contour d'un rectangle, comme SDL_RenderDrawRect
+    Paramtre(s):   x,y     coin suprieur gauche
+                    l,h     largeur et hauteur (rien n'est trac si l'une est nulle)
+    Retour:         Aucun
+*/
+static void tracer_contour(int x,int y,int l,int h){
+    if (l<=0 || h<=0) return;
+    remplir_rangee(x,x+l-1,y);
+    remplir_rangee(x,x+l-1,y+h-1);
+    remplir_colonne(x,y,y+h-1);
+    remplir_colonne(x+l-1,y,y+h-1);
+}
+
+// ---------------------------------------------
+// Fonctions de graph.h
+// ---------------------------------------------
+
+// ---------------------------------------------
+/* fonction: graph_select_couleur
+    Description:    choisit la couleur (RGBA) des prochains tracs
+    Paramtre(s):   r,g,b,a     composantes de la couleur (0-255)
+    Retour:         Aucun
+*/
+void graph_select_couleur(int r, int g, int b, int a){
+    Uint8 tab_octets[4];
+
+    tab_octets[0]=(Uint8)r;
+    tab_octets[1]=(Uint8)g;
+    tab_octets[2]=(Uint8)b;
+    tab_octets[3]=(Uint8)a;
+    memcpy(&couleur,tab_octets,sizeof(couleur));
+}
+
+// ---------------------------------------------
+/* fonction: graph_clear
+    Description:    remplit toute l'image avec une couleur
+    Paramtre(s):   r,g,b,a     composantes de la couleur (0-255)
+    Retour:         Aucun
+*/
+void graph_clear(int r, int g, int b, int a){
+    int y;
+
+    graph_select_couleur(r,g,b,a);
+    for (y=0;y<hauteur_image;y++) remplir_rangee(0,largeur_image-1,y);
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_point
+    Description:    trace un point (origine des coordonnes au coin infrieur gauche)
+    Paramtre(s):   x,y     position du point
+    Retour:         Aucun
+*/
+void graph_trace_point(int x,int y){
+    remplir_rangee(x,x,HAUTEUR_FEN-y-1);
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_segment
+    Description:    trace un segment entre les points (x1,y1) et (x2,y2)
+    Paramtre(s):   x1,y1,x2,y2     extrmits du segment
+    Retour:         Aucun
+*/
+void graph_trace_segment(int x1,int y1,int x2,int y2){
+    tracer_ligne(x1,HAUTEUR_FEN-y1-1,x2,HAUTEUR_FEN-y2-1);
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_rectangle
+    Description:    trace le contour d'un rectangle donn par son coin infrieur gauche et
+                    suprieur droit (mmes pixels que graph.c)
+    Paramtre(s):   x1,y1,x2,y2     coins du rectangle
+    Retour:         Aucun
+*/
+void graph_trace_rectangle(int x1,int y1,int x2,int y2){
+    tracer_contour(x1,HAUTEUR_FEN-y1-1-abs(y2-y1),abs(x2-x1),abs(y2-y1));
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_points
+    Description:    trace un lot de points (voir graph.c)
+    Paramtre(s):   tab_points,nb_points    points  tracer (x,y)
+    Retour:         Aucun
+*/
+void graph_trace_points(int tab_points[][2],int nb_points){
+    int i;
+
+    for (i=0;i<nb_points;i++) graph_trace_point(tab_points[i][0],tab_points[i][1]);
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_polyligne
+    Description:    trace une ligne brise reliant les points (voir graph.c)
+    Paramtre(s):   tab_points,nb_points    sommets de la ligne (x,y)
+    Retour:         Aucun
+*/
+void graph_trace_polyligne(int tab_points[][2],int nb_points){
+    int i;
+
+    if (nb_points==1) graph_trace_point(tab_points[0][0],tab_points[0][1]);
+    for (i=0;i+1<nb_points;i++){
+        graph_trace_segment(tab_points[i][0],tab_points[i][1],tab_points[i+1][0],tab_points[i+1][1]);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_segments
+    Description:    trace un lot de segments (voir graph.c)
+    Paramtre(s):   tab_segments,nb_segments    segments  tracer (x1,y1,x2,y2)
+    Retour:         Aucun
+*/
+void graph_trace_segments(int tab_segments[][4],int nb_segments){
+    int i;
+
+    for (i=0;i<nb_segments;i++){
+        graph_trace_segment(tab_segments[i][0],tab_segments[i][1],tab_segments[i][2],tab_segments[i][3]);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_trace_rectangles
+    Description:    trace un lot de rectangles (voir graph.c)
+    Paramtre(s):   tab_rectangles,nb_rectangles    rectangles  tracer (x1,y1,x2,y2)
+    Retour:         Aucun
+*/
+void graph_trace_rectangles(int tab_rectangles[][4],int nb_rectangles){
+    int i;
+
+    for (i=0;i<nb_rectangles;i++){
+        graph_trace_rectangle(tab_rectangles[i][0],tab_rectangles[i][1],tab_rectangles[i][2],tab_rectangles[i][3]);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_mise_a_jour
+    Description:    termine une image; elle est sauvegarde si la capture est active
+                    (voir graph_logiciel_capturer)
+    Paramtre(s):   Aucun
+    Retour:         Aucun
+*/
+void graph_mise_a_jour(){
+    char nom_fichier[FILENAME_MAX];
+
+    nb_images++;
+    if (modele_capture[0]!='\0'){
+        snprintf(nom_fichier,sizeof(nom_fichier),modele_capture,nb_images);
+        if (!graph_logiciel_sauver(nom_fichier)) printf("[ERR] - Sauvegarde de l'image %s impossible\n",nom_fichier);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: graph_get_mousexy
+    Description:    position de la souris (il n'y a pas d'vnement sans cran: la position
+                    du dernier vnement plac dans event par le programme)
+    Paramtre(s):   mousex,mousey   adresses o placer la position
+    Retour:         Aucun
+*/
+void graph_get_mousexy(int *mousex,int *mousey){
+    *mousex=event.motion.x;
+    *mousey=HAUTEUR_FEN-event.motion.y-1;
+}
+
+// ---------------------------------------------
+/* fonction: graph_delai_ms
+    Description:    sans cran, il n'y a rien  attendre: le rendu va aussi vite que possible
+    Paramtre(s):   milisec     dlai demand (ignor)
+    Retour:         Aucun
+*/
+void graph_delai_ms(int milisec){
+    (void)milisec;
+}
+
+// ---------------------------------------------
+/* fonction: graph_titre
+    Description:    sans fentre, le titre n'est pas affich
+    Paramtre(s):   titre   titre demand (ignor)
+    Retour:         Aucun
+*/
+void graph_titre(char* titre){
+    (void)titre;
+}
+
+// ---------------------------------------------
+/* fonction: graph_init
+    Description:    cre l'image en mmoire et la remplit avec la couleur de fond
+    Paramtre(s):   titre           ignor
+                    largeur,hauteur taille de l'image (pixels)
+                    r,g,b,a         couleur de fond
+    Retour:         renvoi 0 en cas de problme ou 1 en cas de succs
+*/
+int graph_init(char* titre,int largeur, int hauteur,int r, int g, int b, int a){
+    (void)titre;
+    free(tab_pixels);
+    tab_pixels=(Uint32*)malloc((size_t)largeur*hauteur*sizeof(Uint32));
+    if (tab_pixels==NULL){
+        printf("L'image du rendu logiciel ne peut pas etre creee\n");
+        return 0;
+    }
+    largeur_image=largeur;
+    hauteur_image=hauteur;
+    nb_images=0;
+    graph_clear(r,g,b,a);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: graph_fin
+    Description:    libre l'image en mmoire
+    Paramtre(s):   Aucun
+    Retour:         Aucun
+*/
+void graph_fin(){
+    free(tab_pixels);
+    tab_pixels=NULL;
+    largeur_image=hauteur_image=0;
+    modele_capture[0]='\0';
+}
+
+// ---------------------------------------------
+// Fonctions propres au rendu logiciel
+// ---------------------------------------------
+
+// ---------------------------------------------
+/* fonction: graph_logiciel_pixels
+    Description:    accs aux pixels de l'image (ex: comparaison de deux images)
+    Paramtre(s):   largeur,hauteur adresses o placer la taille de l'image (ou NULL)
+    Retour:         les octets R,G,B,A de chaque pixel, ligne par ligne  partir du haut
+                    (NULL avant graph_init)
+*/
+Uint8* graph_logiciel_pixels(int* largeur, int* hauteur){
+    if (largeur!=NULL) *largeur=largeur_image;
+    if (hauteur!=NULL) *hauteur=hauteur_image;
+    return (Uint8*)tab_pixels;
+}
+
+// ---------------------------------------------
+/* fonction: ecrire_gros_boutiste
+    Description:    crit un entier de 32 bits en commenant par l'octet de poids fort
+                    (ordre des entiers du format PNG)
+    Paramtre(s):   tab_octets  o crire les 4 octets
+                    valeur      entier  crire
+    Retour:         Aucun
+*/
+static void ecrire_gros_boutiste(Uint8 tab_octets[], Uint32 valeur){
+    tab_octets[0]=(Uint8)(valeur>>24);
+    tab_octets[1]=(Uint8)(valeur>>16);
+    tab_octets[2]=(Uint8)(valeur>>8);
+    tab_octets[3]=(Uint8)valeur;
+}
+
+// ---------------------------------------------
+/* fonction: crc_png
+    Description:    somme de contrle CRC-32 d'un bloc PNG (type et donnes)
+    Paramtre(s):   crc         somme des octets prcdents (0 au dpart)
+                    tab_octets  octets  ajouter
+                    nb_octets   nb d'octets
+    Retour:         la somme mise  jour
+*/
+static Uint32 crc_png(Uint32 crc, const Uint8 tab_octets[], size_t nb_octets){
+    static Uint32 tab_crc[256];
+    static int table_prete=0;
+    Uint32 c;
+    size_t i;
+    int k;
+
+    if (!table_prete){
+        for (i=0;i<256;i++){
+            c=(Uint32)i;
+            for (k=0;k<8;k++) c=(c&1)?0xEDB88320u^(c>>1):c>>1;
+            tab_crc[i]=c;
+        }
+        table_prete=1;
+    }
+    crc=~crc;
+    for (i=0;i<nb_octets;i++) crc=tab_crc[(crc^tab_octets[i])&0xFF]^(crc>>8);
+    return ~crc;
+}
+
+// ---------------------------------------------
+/* fonction: ecrire_bloc_png
+    Description:    crit un bloc PNG: longueur, type, donnes et CRC-32
+    Paramtre(s):   fichier     fichier ouvert en criture binaire
+                    type        type du bloc (4 lettres)
+                    tab_donnees donnes du bloc
+                    nb_octets   taille des donnes
+    Retour:         1 si le bloc est crit, 0 sinon
+*/
+static int ecrire_bloc_png(FILE* fichier, const char* type, const Uint8 tab_donnees[], size_t nb_octets){
+    Uint8 tab_entete[8],tab_crc[4];
+    Uint32 crc;
+
+    ecrire_gros_boutiste(tab_entete,(Uint32)nb_octets);
+    memcpy(tab_entete+4,type,4);
+    crc=crc_png(crc_png(0,tab_entete+4,4),tab_donnees,nb_octets);
+    ecrire_gros_boutiste(tab_crc,crc);
+    return fwrite(tab_entete,1,8,fichier)==8 &&
+           fwrite(tab_donnees,1,nb_octets,fichier)==nb_octets &&
+           fwrite(tab_crc,1,4,fichier)==4;
+}
+
+// ---------------------------------------------
+/* fonction: sauver_png
+    Description:    crit l'image en format PNG (RGBA, 8 bits par composante). Les donnes
+                    ne sont pas compresses (blocs  stored  du format zlib): le fichier
+                    est lisible par tous les logiciels sans dpendre d'une librairie de
+                    compression.
+    Paramtre(s):   fichier     fichier ouvert en criture binaire
+    Retour:         1 si l'image est crite, 0 sinon
+*/
+static int sauver_png(FILE* fichier){
+    static const Uint8 tab_signature[8]={0x89,'P','N','G','\r','\n',0x1A,'\n'};
+    Uint8 tab_ihdr[13]={0};
+    size_t taille_ligne=1+4*(size_t)largeur_image;         // octet de filtre + pixels
+    size_t taille_brute=taille_ligne*hauteur_image;
+    size_t nb_blocs=(taille_brute+65534)/65535;
+    Uint8* tab_idat;
+    Uint8* p;
+    size_t i,n,reste;
+    Uint32 s1=1,s2=0;       // somme de contrle Adler-32 des donnes brutes
+    Uint8 octet;
+    int y,ok;
+
+    tab_idat=(Uint8*)malloc(2+5*nb_blocs+taille_brute+4);
+    if (tab_idat==NULL) return 0;
+
+    ecrire_gros_boutiste(tab_ihdr,(Uint32)largeur_image);
+    ecrire_gros_boutiste(tab_ihdr+4,(Uint32)hauteur_image);
+    tab_ihdr[8]=8;      // bits par composante
+    tab_ihdr[9]=6;      // RGBA
+
+    // flux zlib: en-tte, blocs non compresss d'au plus 65535 octets, Adler-32
+    p=tab_idat;
+    *p++=0x78;
+    *p++=0x01;
+    reste=taille_brute;
+    y=0;
+    i=0;            // position dans la ligne en cours (0: octet de filtre)
+    while (reste>0){
+        n=(reste<65535)?reste:65535;
+        reste-=n;
+        *p++=(reste==0)?1:0;
+        *p++=(Uint8)(n&0xFF);
+        *p++=(Uint8)(n>>8);
+        *p++=(Uint8)(~n&0xFF);
+        *p++=(Uint8)((~n>>8)&0xFF);
+        for (;n>0;n--){
+            octet=(i==0)?0:((Uint8*)tab_pixels)[(size_t)y*largeur_image*4+i-1];
+            *p++=octet;
+            s1=(s1+octet)%65521;
+            s2=(s2+s1)%65521;
+            if (++i==taille_ligne){
+                i=0;
+                y++;
+            }
+        }
+    }
+    ecrire_gros_boutiste(p,(s2<<16)|s1);
+    p+=4;
+
+    ok=fwrite(tab_signature,1,8,fichier)==8 &&
+       ecrire_bloc_png(fichier,"IHDR",tab_ihdr,sizeof(tab_ihdr)) &&
+       ecrire_bloc_png(fichier,"IDAT",tab_idat,(size_t)(p-tab_idat)) &&
+       ecrire_bloc_png(fichier,"IEND",NULL,0);
+    free(tab_idat);
+    return ok;
+}
+
+// ---------------------------------------------
+/* fonction: sauver_ppm
+    Description:    crit l'image en format PPM binaire (P6, RGB sans transparence)
+    Paramtre(s):   fichier     fichier ouvert en criture binaire
+    Retour:         1 si l'image est crite, 0 sinon
+*/
+static int sauver_ppm(FILE* fichier){
+    Uint8* tab_ligne;
+    Uint8* pixel;
+    int x,y,ok;
+
+    tab_ligne=(Uint8*)malloc(3*(size_t)largeur_image);
+    if (tab_ligne==NULL) return 0;
+    ok=fprintf(fichier,"P6\n%d %d\n255\n",largeur_image,hauteur_image)>0;
+    for (y=0;y<hauteur_image && ok;y++){
+        pixel=(Uint8*)(tab_pixels+(size_t)y*largeur_image);
+        for (x=0;x<largeur_image;x++){
+            tab_ligne[3*x]=pixel[4*x];
+            tab_ligne[3*x+1]=pixel[4*x+1];
+            tab_ligne[3*x+2]=pixel[4*x+2];
+        }
+        ok=fwrite(tab_ligne,3,largeur_image,fichier)==(size_t)largeur_image;
+    }
+    free(tab_ligne);
+    return ok;
+}
+
+// ---------------------------------------------
+/* fonction: graph_logiciel_sauver
+    Description:    sauvegarde l'image en cours; le format est choisi selon l'extension
+                    du nom de fichier (.png, sinon PPM)
+    Paramtre(s):   nom_fichier     nom du fichier  crire
+    Retour:         1 si l'image est sauvegarde, 0 sinon
+    Ex. d'utilisation:
+                    graph_logiciel_sauver("tir.png");
+*/
+int graph_logiciel_sauver(const char* nom_fichier){
+    FILE* fichier;
+    size_t longueur=strlen(nom_fichier);
+    int ok;
+
+    if (tab_pixels==NULL) return 0;
+    fichier=fopen(nom_fichier,"wb");
+    if (fichier==NULL) return 0;
+    if (longueur>=4 && strcmp(nom_fichier+longueur-4,".png")==0) ok=sauver_png(fichier);
+    else ok=sauver_ppm(fichier);
+    ok=(fclose(fichier)==0) && ok;
+    return ok;
+}
+
+// ---------------------------------------------
+/* fonction: modele_capture_valide
+    Description:    vrifie qu'un modle de nom d'image peut servir de format  snprintf
+                    avec le seul numro de l'image: exactement une conversion %d ou %0Nd
+                    (N: chiffres de la largeur) et aucun autre caractre %
+    Paramtre(s):   modele  modle du nom des fichiers
+    Retour:         1 si le modle est valide, 0 sinon
+*/
+static int modele_capture_valide(const char* modele){
+    const char* p;
+    int nb_conversions=0;
+
+    for (p=modele;*p!='\0';p++){
+        if (*p!='%') continue;
+        p++;
+        while (*p>='0' && *p<='9') p++;
+        if (*p!='d') return 0;
+        nb_conversions++;
+    }
+    return nb_conversions==1;
+}
+
+// ---------------------------------------------
+/* fonction: graph_logiciel_capturer
+    Description:    active la sauvegarde de chaque image termine par graph_mise_a_jour
+    Paramtre(s):   modele  modle du nom des fichiers, avec un seul %d (ou %0Nd) remplac
+                            par le numro de l'image ( partir de 1) et aucun autre %;
+                            NULL ou "" pour arrter la capture
+    Retour:         1 si la capture est active (ou arrte), 0 si le modle est invalide
+                    ou trop long (la capture est alors arrte)
+    Ex. d'utilisation:
+                    graph_logiciel_capturer("images/tir%05d.ppm");
+*/
+int graph_logiciel_capturer(const char* modele){
+    modele_capture[0]='\0';
+    if (modele==NULL || modele[0]=='\0') return 1;
+    if (!modele_capture_valide(modele) || strlen(modele)>=sizeof(modele_capture)) return 0;
+    strcpy(modele_capture,modele);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: graph_logiciel_nb_images
+    Description:    nb d'images termines par graph_mise_a_jour depuis graph_init
+    Paramtre(s):   Aucun
+    Retour:         le nb d'images
+*/
+int graph_logiciel_nb_images(){
+    return nb_images;
+}
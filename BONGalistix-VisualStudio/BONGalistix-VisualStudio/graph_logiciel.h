@@ -0,0 +1,35 @@
+#ifndef GRAPH_LOGICIEL_H
+#define GRAPH_LOGICIEL_H
+
+// -------------------------------------------
+/*
+librairie graph_logiciel.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rendu logiciel des fonctions de graph.h, sans cran. Un programme li
+             avec graph_logiciel.c plutt qu'avec graph.c dessine avec les mmes
+             fonctions graph_* dans une image en mmoire (pixels RGBA) au lieu d'une
+             fentre SDL: aucun serveur d'affichage n'est ncessaire (ex: tirs de
+             rgression et comparaison d'images sur un serveur).
+             Les lignes sont traces par l'algorithme de Bresenham; les lignes
+             horizontales et les rectangles pleins sont remplis par ranges de pixels
+             contigus. Les images affiches (graph_mise_a_jour) peuvent tre
+             sauvegardes en format PPM ou PNG.
+             Diffrences avec graph.c: il n'y a ni fentre, ni renderer (renderer vaut
+             NULL), ni vnements, et graph_delai_ms n'attend pas.
+Note: les implmentations des fonctions se trouvent dans le fichier graph_logiciel.c
+*/
+// -------------------------------------------
+
+#include "graph.h"
+
+// ---------------------------------------------
+// Prototypes des fonctions propres au rendu logiciel
+// ---------------------------------------------
+
+Uint8* graph_logiciel_pixels(int* largeur, int* hauteur);
+int graph_logiciel_sauver(const char* nom_fichier);
+int graph_logiciel_capturer(const char* modele);
+int graph_logiciel_nb_images();
+
+#endif // GRAPH_LOGICIEL_H
@@ -0,0 +1,325 @@
+// -------------------------------------------
+/*
+librairie grille.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Index spatial des murs par grille uniforme et recherche du premier mur
+             crois par un segment de trajectoire (parcours DDA des cases).
+Note: les prototypes des fonctions se trouvent dans le fichier grille.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "geometrie.h"
+#include "grille.h"
+
+#define GRILLE_MARGE        1.0     // marge ajoute autour de la zone des murs
+#define GRILLE_EPSILON      1e-9    // tolrance d'appartenance d'un point  une case
+
+// ---------------------------------------------
+/* fonction: index_case
+    Description:    index de la colonne (ou ligne) de la case contenant la coordonne v,
+                    limit aux cases existantes
+    Paramtre(s):   v       coordonne (x ou y)
+                    v_min   dbut de la zone couverte selon cet axe
+                    taille  ct d'une case
+                    nb      nb de cases selon cet axe
+    Retour:         l'index de colonne (ou ligne) entre 0 et nb-1
+*/
+static int index_case(double v, double v_min, double taille, int nb)
+{
+    double i=floor((v-v_min)/taille);
+    if (i<0) return 0;
+    if (i>nb-1) return nb-1;
+    return (int)i;
+}
+
+// ---------------------------------------------
+/* fonction: ajouter_mur_case
+    Description:    ajoute l'indice d'un mur  la liste d'une case (agrandit la liste au besoin)
+    Paramtre(s):   c       case  modifier
+                    mur     indice du mur
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation
+*/
+static int ajouter_mur_case(t_case_grille* c, int mur)
+{
+    int* tab;
+    if (c->nb_murs==c->capacite){
+        tab=(int*)realloc(c->tab_murs,(c->capacite?2*c->capacite:4)*sizeof(int));
+        if (tab==NULL) return 0;
+        c->tab_murs=tab;
+        c->capacite=c->capacite?2*c->capacite:4;
+    }
+    c->tab_murs[c->nb_murs++]=mur;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: construire_grille
+    Description:    construit la grille uniforme des murs d'un niveau. La zone couverte est
+                    le rectangle englobant tous les murs (plus une petite marge). Le nombre
+                    de cases est proportionnel au nombre de murs (GRILLE_CASES_PAR_MUR).
+                    Chaque mur est plac dans toutes les cases touches par son rectangle
+                    englobant (exactement les cases traverses pour un mur horizontal ou
+                    vertical).
+    Paramtre(s):   tab_segments    tableau des segments de murs
+                    nb_segments     nombre de segments de murs
+    Retour:         l'adresse de la grille construite, NULL en cas d'erreur
+    Ex. d'utilisation:
+                    niv->grille=construire_grille(niv->tab_segments,niv->nb_segments);
+*/
+t_grille* construire_grille(int tab_segments[][COL_TABSEG], int nb_segments)
+{
+    t_grille* grille;
+    double x_max,y_max,largeur,hauteur,taille;
+    int i,col,lig,col0,col1,lig0,lig1;
+    int reussite=1;
+
+    if (nb_segments<=0) return NULL;
+    grille=(t_grille*)calloc(1,sizeof(t_grille));
+    if (grille==NULL) return NULL;
+
+    // rectangle englobant tous les murs
+    grille->x_min=x_max=tab_segments[0][X0];
+    grille->y_min=y_max=tab_segments[0][Y0];
+    for (i=0;i<nb_segments;i++){
+        grille->x_min=fmin(grille->x_min,fmin(tab_segments[i][X0],tab_segments[i][X1]));
+        grille->y_min=fmin(grille->y_min,fmin(tab_segments[i][Y0],tab_segments[i][Y1]));
+        x_max=fmax(x_max,fmax(tab_segments[i][X0],tab_segments[i][X1]));
+        y_max=fmax(y_max,fmax(tab_segments[i][Y0],tab_segments[i][Y1]));
+    }
+    grille->x_min-=GRILLE_MARGE;
+    grille->y_min-=GRILLE_MARGE;
+    largeur=x_max+GRILLE_MARGE-grille->x_min;
+    hauteur=y_max+GRILLE_MARGE-grille->y_min;
+
+    // taille des cases selon le nombre de cases vis
+    taille=sqrt(largeur*hauteur/(GRILLE_CASES_PAR_MUR*(double)nb_segments));
+    grille->nb_col=(int)ceil(largeur/taille);
+    grille->nb_lig=(int)ceil(hauteur/taille);
+    if (grille->nb_col<1) grille->nb_col=1;
+    if (grille->nb_lig<1) grille->nb_lig=1;
+    if (grille->nb_col>GRILLE_MAX_COTE) grille->nb_col=GRILLE_MAX_COTE;
+    if (grille->nb_lig>GRILLE_MAX_COTE) grille->nb_lig=GRILLE_MAX_COTE;
+    grille->taille_case=fmax(largeur/grille->nb_col,hauteur/grille->nb_lig);
+
+    grille->tab_cases=(t_case_grille*)calloc((size_t)grille->nb_col*grille->nb_lig,sizeof(t_case_grille));
+    if (grille->tab_cases==NULL){
+        free(grille);
+        return NULL;
+    }
+
+    // placer chaque mur dans les cases touches par son rectangle englobant
+    for (i=0;i<nb_segments && reussite;i++){
+        col0=index_case(fmin(tab_segments[i][X0],tab_segments[i][X1])-GRILLE_EPSILON,grille->x_min,grille->taille_case,grille->nb_col);
+        col1=index_case(fmax(tab_segments[i][X0],tab_segments[i][X1])+GRILLE_EPSILON,grille->x_min,grille->taille_case,grille->nb_col);
+        lig0=index_case(fmin(tab_segments[i][Y0],tab_segments[i][Y1])-GRILLE_EPSILON,grille->y_min,grille->taille_case,grille->nb_lig);
+        lig1=index_case(fmax(tab_segments[i][Y0],tab_segments[i][Y1])+GRILLE_EPSILON,grille->y_min,grille->taille_case,grille->nb_lig);
+        for (lig=lig0;lig<=lig1 && reussite;lig++){
+            for (col=col0;col<=col1 && reussite;col++){
+                reussite=ajouter_mur_case(&grille->tab_cases[lig*grille->nb_col+col],i);
+            }
+        }
+    }
+    if (!reussite){
+        liberer_grille(grille);
+        return NULL;
+    }
+
+    return grille;
+}
+
+// ---------------------------------------------
+/* fonction: cases_mur
+    Description:    cases touches par le rectangle englobant d'un mur
+    Paramtre(s):   grille      grille des murs
+                    seg         ligne du tableau de segments du mur
+                    col0,col1   adresses o placer la premire et la dernire colonne
+                    lig0,lig1   adresses o placer la premire et la dernire ligne
+    Retour:         1 si le mur est entirement dans la zone couverte par la grille, 0 sinon
+*/
+static int cases_mur(t_grille* grille, int seg[COL_TABSEG], int* col0, int* col1, int* lig0, int* lig1)
+{
+    double x_max=grille->x_min+grille->nb_col*grille->taille_case;
+    double y_max=grille->y_min+grille->nb_lig*grille->taille_case;
+
+    *col0=index_case(fmin(seg[X0],seg[X1])-GRILLE_EPSILON,grille->x_min,grille->taille_case,grille->nb_col);
+    *col1=index_case(fmax(seg[X0],seg[X1])+GRILLE_EPSILON,grille->x_min,grille->taille_case,grille->nb_col);
+    *lig0=index_case(fmin(seg[Y0],seg[Y1])-GRILLE_EPSILON,grille->y_min,grille->taille_case,grille->nb_lig);
+    *lig1=index_case(fmax(seg[Y0],seg[Y1])+GRILLE_EPSILON,grille->y_min,grille->taille_case,grille->nb_lig);
+    return fmin(seg[X0],seg[X1])>=grille->x_min && fmax(seg[X0],seg[X1])<=x_max &&
+           fmin(seg[Y0],seg[Y1])>=grille->y_min && fmax(seg[Y0],seg[Y1])<=y_max;
+}
+
+// ---------------------------------------------
+/* fonction: grille_deplacer_mur
+    Description:    dplace un mur dans la grille (ex: niveau modifi pendant la partie):
+                    le mur est retir des cases de son ancienne position puis ajout aux
+                    cases de la nouvelle. Seules ces cases sont modifies.
+    Paramtre(s):   grille      grille des murs
+                    ancien      segment du mur avant le dplacement
+                    nouveau     segment du mur aprs le dplacement
+                    mur         indice du mur
+    Retour:         1 en cas de succs, 0 si la nouvelle position sort de la zone couverte
+                    par la grille ou en cas d'erreur d'allocation (la grille doit alors
+                    tre reconstruite)
+    Ex. d'utilisation:
+                    if (!grille_deplacer_mur(grille,tab_segments[i],nouveau,i)) ...
+*/
+int grille_deplacer_mur(t_grille* grille, int ancien[COL_TABSEG], int nouveau[COL_TABSEG], int mur)
+{
+    int col,lig,col0,col1,lig0,lig1,i;
+    t_case_grille* c;
+
+    cases_mur(grille,ancien,&col0,&col1,&lig0,&lig1);
+    for (lig=lig0;lig<=lig1;lig++){
+        for (col=col0;col<=col1;col++){
+            c=&grille->tab_cases[lig*grille->nb_col+col];
+            for (i=0;i<c->nb_murs;i++){
+                if (c->tab_murs[i]==mur){
+                    c->tab_murs[i]=c->tab_murs[--c->nb_murs];
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!cases_mur(grille,nouveau,&col0,&col1,&lig0,&lig1)) return 0;
+    for (lig=lig0;lig<=lig1;lig++){
+        for (col=col0;col<=col1;col++){
+            if (!ajouter_mur_case(&grille->tab_cases[lig*grille->nb_col+col],mur)) return 0;
+        }
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_grille
+    Description:    libre la mmoire d'une grille
+    Paramtre(s):   grille  grille  librer (NULL accept)
+    Retour:         aucun
+*/
+void liberer_grille(t_grille* grille)
+{
+    int i;
+    if (grille==NULL) return;
+    if (grille->tab_cases!=NULL){
+        for (i=0;i<grille->nb_col*grille->nb_lig;i++) free(grille->tab_cases[i].tab_murs);
+        free(grille->tab_cases);
+    }
+    free(grille);
+}
+
+// ---------------------------------------------
+/* fonction: grille_premier_mur
+    Description:    trouve le premier mur crois par le segment de trajectoire (x0,y0)-(x1,y1)
+                    en 3 tapes:
+                    1-limiter le segment  la zone couverte par la grille
+                    2-parcourir les cases traverses dans l'ordre du dplacement (DDA):
+                       chaque case, on passe  la case voisine en x ou en y selon la
+                      frontire de case atteinte en premier
+                    3-dans chaque case, tester les murs de la case. Seul un point
+                      d'intersection situ dans la case courante est accept: un point
+                      situ plus loin sera retrouv dans une case suivante. La premire
+                      case contenant une intersection donne donc le mur le plus proche.
+    Paramtre(s):   grille          grille des murs
+                    tab_murs        murs compils du niveau (voir compiler_segment)
+                    x0,y0           position de dpart du segment de trajectoire
+                    x1,y1           position d'arrive du segment de trajectoire
+                    xr,yr           adresses o placer le point d'impact
+    Retour:         l'indice du mur crois, -1 si aucun mur n'est crois
+    Ex. d'utilisation:
+                    mur=grille_premier_mur(grille,niv->tab_murs,x0,y0,x1,y1,&xr,&yr);
+*/
+int grille_premier_mur(t_grille* grille, t_segment_compile tab_murs[],
+                       double x0, double y0, double x1, double y1,
+                       double* xr, double* yr)
+{
+    double dx=x1-x0,dy=y1-y0;               // dplacement
+    double s_min=0,s_max=1;                 // portion du dplacement dans la zone couverte
+    double x_max=grille->x_min+grille->nb_col*grille->taille_case;
+    double y_max=grille->y_min+grille->nb_lig*grille->taille_case;
+    double s_x,s_y,ds_x,ds_y;               // prochaine frontire de case atteinte en x et en y, et cart entre frontires
+    double cx0,cy0,xi,yi,d,d_min;
+    int col,lig,col_fin,lig_fin,pas_col,pas_lig;
+    int i,mur,mur_min;
+    t_case_grille* c;
+
+    // 1-limiter le segment  la zone couverte (mthode des tranches)
+    if (dx!=0){
+        s_x=(grille->x_min-x0)/dx;
+        s_y=(x_max-x0)/dx;
+        s_min=fmax(s_min,fmin(s_x,s_y));
+        s_max=fmin(s_max,fmax(s_x,s_y));
+    }
+    else if (x0<grille->x_min || x0>x_max) return -1;
+    if (dy!=0){
+        s_x=(grille->y_min-y0)/dy;
+        s_y=(y_max-y0)/dy;
+        s_min=fmax(s_min,fmin(s_x,s_y));
+        s_max=fmin(s_max,fmax(s_x,s_y));
+    }
+    else if (y0<grille->y_min || y0>y_max) return -1;
+    if (s_min>s_max) return -1;
+
+    // 2-cases de dpart et d'arrive, et paramtres du parcours
+    col=index_case(x0+s_min*dx,grille->x_min,grille->taille_case,grille->nb_col);
+    lig=index_case(y0+s_min*dy,grille->y_min,grille->taille_case,grille->nb_lig);
+    col_fin=index_case(x0+s_max*dx,grille->x_min,grille->taille_case,grille->nb_col);
+    lig_fin=index_case(y0+s_max*dy,grille->y_min,grille->taille_case,grille->nb_lig);
+
+    pas_col=(dx>0)?1:((dx<0)?-1:0);
+    pas_lig=(dy>0)?1:((dy<0)?-1:0);
+    if (dx!=0){
+        s_x=(grille->x_min+(col+(dx>0))*grille->taille_case-x0)/dx;
+        ds_x=grille->taille_case/fabs(dx);
+    }
+    else s_x=ds_x=HUGE_VAL;
+    if (dy!=0){
+        s_y=(grille->y_min+(lig+(dy>0))*grille->taille_case-y0)/dy;
+        ds_y=grille->taille_case/fabs(dy);
+    }
+    else s_y=ds_y=HUGE_VAL;
+
+    while (1){
+        // 3-tester les murs de la case courante
+        c=&grille->tab_cases[lig*grille->nb_col+col];
+        cx0=grille->x_min+col*grille->taille_case;
+        cy0=grille->y_min+lig*grille->taille_case;
+        mur_min=-1;
+        d_min=HUGE_VAL;
+        for (i=0;i<c->nb_murs;i++){
+            mur=c->tab_murs[i];
+            if (intersection_segment_compile(x0,y0,x1,y1,&tab_murs[mur],&xi,&yi) &&
+                xi>=cx0-GRILLE_EPSILON && xi<=cx0+grille->taille_case+GRILLE_EPSILON &&
+                yi>=cy0-GRILLE_EPSILON && yi<=cy0+grille->taille_case+GRILLE_EPSILON){
+                d=(xi-x0)*(xi-x0)+(yi-y0)*(yi-y0);
+                if (d<d_min){
+                    d_min=d;
+                    mur_min=mur;
+                    *xr=xi;
+                    *yr=yi;
+                }
+            }
+        }
+        if (mur_min>=0) return mur_min;
+
+        // passer  la case suivante
+        if (col==col_fin && lig==lig_fin) break;
+        if (s_x<s_y){
+            if (s_x>s_max) break;
+            col+=pas_col;
+            s_x+=ds_x;
+        }
+        else{
+            if (s_y>s_max) break;
+            lig+=pas_lig;
+            s_y+=ds_y;
+        }
+        if (col<0 || col>=grille->nb_col || lig<0 || lig>=grille->nb_lig) break;
+    }
+
+    return -1;
+}
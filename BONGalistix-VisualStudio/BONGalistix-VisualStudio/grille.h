@@ -0,0 +1,58 @@
+#ifndef GRILLE_H
+#define GRILLE_H
+
+// -------------------------------------------
+/*
+librairie grille.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Index spatial des murs par grille uniforme. La zone couverte par les murs
+             est dcoupe en cases carres et chaque case mmorise les indices des murs
+             qui la touchent. Pour trouver le mur crois par un segment de trajectoire,
+             seules les cases traverses par le segment sont visites (parcours DDA),
+             dans l'ordre du dplacement: le cot d'une recherche dpend de la longueur
+             du segment et non du nombre total de murs.
+Note: les implmentations des fonctions se trouvent dans le fichier grille.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// paramtres de construction de la grille
+// ---------------------------------------------
+#define GRILLE_CASES_PAR_MUR    2       // nb de cases vis par mur du niveau
+#define GRILLE_MAX_COTE         512     // nb maximum de cases sur un ct de la grille
+
+// ---------------------------------------------
+// case de la grille: liste des murs qui la touchent
+// ---------------------------------------------
+typedef struct {
+    int nb_murs;        // nb de murs dans la case
+    int capacite;       // nb de murs pouvant tre placs dans tab_murs sans rallocation
+    int* tab_murs;      // indices des murs (lignes du tableau de segments)
+} t_case_grille;
+
+// ---------------------------------------------
+// grille uniforme sur la zone des murs
+// ---------------------------------------------
+typedef struct s_grille {
+    double x_min,y_min;     // coin infrieur gauche de la zone couverte
+    double taille_case;     // ct d'une case
+    int nb_col,nb_lig;      // nb de cases en x et en y
+    t_case_grille* tab_cases;   // cases ranges ligne par ligne (nb_col*nb_lig)
+} t_grille;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+t_grille* construire_grille(int tab_segments[][COL_TABSEG], int nb_segments);
+void liberer_grille(t_grille* grille);
+int grille_deplacer_mur(t_grille* grille, int ancien[COL_TABSEG], int nouveau[COL_TABSEG], int mur);
+
+int grille_premier_mur(t_grille* grille, t_segment_compile tab_murs[],
+                       double x0, double y0, double x1, double y1,
+                       double* xr, double* yr);
+
+#endif // GRILLE_H
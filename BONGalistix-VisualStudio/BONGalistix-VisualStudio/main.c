@@ -9,6 +9,8 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
             avant que le projectile n'atteigne une vitesse quasi-nulle. Le niveau suivant est
             alors charg et le jeu continue. Il n'y a pas de limite de nombre de tirs pour russir
             un niveau. Quand le dernier niveau est russi, le jeu recommence au premier niveau.
+            Lanc avec  -trace fichier.json , le jeu enregistre la dure de chaque mode, des
+            chargements de niveau et des pas de simulation dans une trace lisible par Perfetto.
 */
 
 // -------------------------------------------
@@ -17,6 +19,7 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
 // -------------------------------------------
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 // -------------------------------------------
@@ -30,39 +33,34 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
 #include "geometrie.h"
 
 // -------------------------------------------
-// constantes utiles aux calculs mathmatiques
+// librairies de description des niveaux et de simulation
+// du vol du projectile (sans dpendance  SDL)
 // -------------------------------------------
-#define PI 3.14159
-
-// ------------------------------------------
-// constantes utiles  la simulation numrique
-// et la modlisation du projectile
-// ------------------------------------------
-#define MASSE           2       // masse de l'objet lanc (kg)
-#define RAYON           0.05    // rayon du projectile (m)
-#define CX              0.4     // coef. de rsistance arodynamique d'une sphre
-#define RHO             1.2     // masse volumique de l'air
-#define GRAVITE         9.8     // acclration gravitationnelle m2/s
-#define C_RESTITUTION   0.95    // coefficient de restitution de vitesse de la paroi lors des rebonds
-#define C_FROTTEMENT    (0.5*CX*RHO*PI*RAYON*RAYON) // coefficient de frottement de l'air pour une sphre
-#define V_INITIALE_MAX  120     // vitesse initiale maximum (m/s)
-#define T_IMMOBILE_MAX  2       // temps d'immobilit maximum du projectile avant de dclarer la fin d'un lancer (s)
-#define DELTAT          0.1     // incrment de temps maximum lors de la simulation numrique du vol du projectile (s)
-#define DECALAGE_REBOND 0.05    // distance  la paroi  laquelle le projectile est replac lors des rebonds
+#include "niveau.h"
+#include "cache_niveau.h"
+#include "prechargement.h"
+#include "rechargement.h"
+#include "paquet_niveaux.h"
+#include "niveaux_embarques.h"
+#include "simulation.h"
+#include "bvh.h"
+#include "murs_simd.h"
 
-// -----------------------------------------
-// contantes utiles au chargement des diffrents niveaux
-// tous les niveaux doivent se trouver dans un dossier au mme endroit que l'excutable
-// le nom des fichiers de niveau est toujours le mme, seul l'index varie
-// ex: "Niveaux\niveau1.text" ... "Niveaux\niveau10.text"
-// Le premier niveau est le plus facile.
-// -----------------------------------------
+// -------------------------------------------
+// calque d'affichage des lments fixes
+// -------------------------------------------
+#include "calque.h"
+#include "redessin.h"
+
+// -------------------------------------------
+// mesure du temps des phases de chaque image
+// -------------------------------------------
+#include "profil.h"
 
-#define DOSSIER_NIVEAU              "Niveaux" // dossier dans lequel se trouvent les fichiers de niveaux
-#define DEBUT_NOM_FICHIER_NIVEAU    "niveau"  // prfixe du nom de ficher de niveau (ex:niveau4.txt)
-#define FIN_NOM_FICHIER_NIVEAU      ".txt"    // extension du nom de fichier de niveau (ex:niveau4.txt)
-#define PREMIER_NIVEAU              1         // index du premier niveau (ex: "Niveaux\niveau1.text")
-#define DERNIER_NIVEAU              18        // index du dernier niveau (ex: "Niveaux\niveau17.text")
+// -------------------------------------------
+// trace chronologique facultative (format Chrome trace)
+// -------------------------------------------
+#include "trace.h"
 
 // -----------------------------------------
 // constantes utiles  l'affichage graphique
@@ -98,34 +96,6 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
 // taille de la reprsentation graphique du projectile (carr)
 #define TAILLE_PRO 2    // nb pixels ajouts de chaque ct de son centre.
 
-// ---------------------------------------------
-// dimensions du tableau des segments de murs du niveau en cours
-// ---------------------------------------------
-#define DIMENSION_POINT     2       // nb de dimension pour les coordonnes des points 2 pour 2D, 3 pour 3D
-#define POINT_PAR_SEGMENT   2       // nb de points pour dfinir un segment (mur)
-#define MAXSEGMENT          100     // nb maximum de segments (murs)
-
-#define COL_TABSEG  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau de segments de murs
-#define COL_TABCIB  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur la cible
-#define COL_TABLAN  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur le lanceur
-#define COL_TABPRO  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur le projectile
-#define LIG_TABPRO  2                                       // nb de ligne du tableau d'info sur le projectile
-
-// indices de colonne d'accs aux lment des tableau
-#define X0                  0
-#define Y0                  1
-#define X1                  2
-#define Y1                  3
-
-// indices de ligne d'accs aux lments du tableau de projectile
-#define POSITION            0
-#define VITESSE             1
-
-// ---------------------------------------------
-// limite de taille pour les chaines de caractres
-// ---------------------------------------------
-#define MAX_CHAR    100
-
 // ---------------------------------------------
 // diffrents modes (tats) dans lequel le jeu peut-tre
 // ---------------------------------------------
@@ -138,6 +108,7 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
 #define MODE_SIMULATION_VOL         5   // Simulation numrique de la trajectoire du projectile
 #define MODE_TOUCHER_CIBLE          6   // Affichage indiquant que le niveau russi
 #define MODE_RATER_CIBLE            7   // Affichage indiquant que la balle s'est immobilise sans toucher la cible
+#define NB_MODES                    8
 
 // ---------------------------------------------
 // diffrents lments graphique pouvant tre visible ou non
@@ -149,39 +120,70 @@ Description: Jeu de tir pour atteindre une cible. L'objet lanc
 #define TOUS_VISIBLE        15 //(0b1111)      // valeur  utiliser pour rendre tous les lments visible lors de l'affichage
 #define TOUS_INVISIBLE      0  //(0b0000)      // valeur  utiliser pour rendre tous les lments invisible lors de l'affichage
 
+// ---------------------------------------------
+// numros des lments suivis pour le redessin partiel de l'affichage
+// ---------------------------------------------
+#define ELEMENT_MURS        0
+#define ELEMENT_CIBLE       1
+#define ELEMENT_LANCEUR     2
+#define ELEMENT_PROJECTILE  3
+
+// ---------------------------------------------
+// attente des vnements quand l'affichage ne change pas
+// ---------------------------------------------
+#define DELAI_SANS_AFFICHAGE 5      // attente max (ms) quand rien n'a chang  l'cran (hors clignotement de fin de lancer)
+#define DELAI_ATTENTE_MAX    500    // attente max (ms) pendant l'ajustement du lancer (seuls les vnements le changent)
+#define DELAI_FENETRE_CACHEE (1000/FREQUENCE_PHYSIQUE)  // attente (ms) entre deux tours quand la fentre est cache
+
+// touche du clavier qui affiche le profil du temps des images dans la console
+#define TOUCHE_PROFIL       SDLK_p
+
+// argument du programme qui dmarre la trace (suivi du nom du fichier JSON)
+#define OPTION_TRACE        "-trace"
+
 // ---------------------------------------------
 // paramtres de clignotement de la cible ou des murs lors de la fin d'un lancer (succes ou chec)
 // ---------------------------------------------
 #define PERIODE_CLIGNOTEMENT    200     // priode de clignotement des murs ou de la cible lors de la fin d'un lancer
 #define NB_CLIGNOTEMENT         4       // nombre de clignotement des murs ou de la cible lors de la fin d'un lancer
 
+// ---------------------------------------------
+// cadence de la simulation du vol, indpendante de celle de l'affichage
+// ---------------------------------------------
+#define FREQUENCE_PHYSIQUE      12      // nb de pas de simulation (DELTAT) par seconde relle
+#define MAX_PAS_PAR_IMAGE       8       // nb maximum de pas simuls entre deux affichages (le retard au-del est abandonn)
+
 // ---------------------------------------------
 // prototypes des fonctions
 // ---------------------------------------------
 
-void afficher_elements(int elements_visibles,
-                       int tab_murs[][COL_TABSEG],int nb_murs,
-                       int tab_cible[],
-                       int tab_lanceur[],
-                       double tab_projectile[][COL_TABPRO]);
-int afficher_murs(int tab_segments[][COL_TABSEG],int nb_segments,int max_segments);
+int afficher_elements(int elements_visibles,
+                      t_segment_compile tab_murs[],int nb_murs,t_bvh* bvh_murs,
+                      t_calque* calque_murs,t_redessin* redessin,
+                      int tab_cible[],
+                      int tab_lanceur[],
+                      double tab_projectile[][COL_TABPRO]);
+void tracer_elements(int elements_visibles,
+                     t_segment_compile tab_murs[],int nb_murs,t_bvh* bvh_murs,t_calque* calque_murs,
+                     int tab_cible[],
+                     int tab_lanceur[],
+                     double tab_projectile[][COL_TABPRO]);
+int reserver_murs_affiches(int nb_murs);
+void liberer_murs_affiches();
+int afficher_murs(t_segment_compile tab_murs[],int nb_segments,int max_segments,t_bvh* bvh_murs);
 void afficher_projectile(double tab_projectile[][COL_TABPRO]);
+void interpoler_projectile(double tab_projectile[][COL_TABPRO],double alpha,double tab_affichage[][COL_TABPRO]);
 void afficher_cible(int tab_cible[]);
 void afficher_lanceur(int tab_lanceur[]);
+void appliquer_niveau_modifie(t_niveau* niv,t_calque* calque_murs,t_redessin* redessin);
 
-void calcule_lanceur(int mousex,int mousey,int vmax,int tab_lanceur[]);
-
-void mise_a_jour_ballistique(double tab_projectile[][COL_TABPRO],double *t,double dt);
-void mise_a_jour_rebond(int tab_segments[][COL_TABSEG],int nb_segments,
-                        double tab_projectile[][COL_TABPRO],
-                        double *t,double *dt);
-
-int cible_atteinte(double tab_projectile[][COL_TABCIB],int tab_cible[]);
-int projectile_immobile(double tab_projectile[][COL_TABPRO]);
-
-void affiche_tab2D(int tab_segments[][COL_TABSEG],int nb_segments);
-int lire_fichier_niveau(int niveau, char* dossier, char* txt_debut_fichier, char* txt_fin_fichier,
-                        int tab_seg[][COL_TABSEG],int tab_lanceur[], int tab_cible[]);
+// ---------------------------------------------
+// tableaux de travail de l'affichage des murs, gards d'une image  l'autre
+// (agrandis seulement au chargement d'un niveau plus grand, voir reserver_murs_affiches)
+// ---------------------------------------------
+static int* tab_visibles=NULL;                  // indices des murs qui touchent la fentre
+static int (*tab_traces)[COL_TABSEG]=NULL;      // murs  tracer, soumis en un seul lot
+static int capacite_murs_affiches=0;            // nb de murs que les deux tableaux peuvent contenir
 
 
 // ---------------------------------------------
@@ -193,27 +195,82 @@ int main( int argc, char* args[] ){
     // variables:
 
     // lments du jeu
-    int tab_segments[MAXSEGMENT][COL_TABSEG]={{0}};   // tableau de segments
-    int tab_lanceur[COL_TABLAN]={0};        // coordonnes de la position et du bout du lanceur
-    int tab_cible[COL_TABCIB]={0};          // coordonnes de la cible (coin infrieur gauche et coin suprieur droit)
+    t_niveau niv;                           // niveau en cours (segments de murs, lanceur et cible)
     double tab_projectile[LIG_TABPRO][COL_TABCIB]={{0}}; // position/vitesse actuelle et prcdente du projectile
+    double tab_affichage[LIG_TABPRO][COL_TABPRO]={{0}};  // projectile affich (entre la position prcdente et l'actuelle)
+
+    t_calque calque_murs;                   // murs du niveau tracs une seule fois
+    t_redessin redessin;                    // zones de l'affichage  redessiner
 
     // tat du jeu
     char titre_fenetre[MAX_CHAR];           // titre de la fenetre pour afficher le numro du niveau
     int mode=MODE_DEBUT;                    // mode du jeu
     int niveau=PREMIER_NIVEAU;              // index du niveau
-    int nb_segments=0;                      // nb de segments de murs valides dans le tableau de segments
     double t=0;                             // temps coul lors de la simulation du vol du projectile
-    double dt=DELTAT;                       // incrment de temps de la simulation du vol
+    double dt=DELTAT;                       // pas de temps de la simulation du vol
     double chrono_immobile=0;               // chronomtre pour compter le temps d'immobilit du projectile
     int elements_visibles=TOUS_INVISIBLE;   // dfinition des lments graphiques visibles
 
+    // cadence de la simulation
+    double periode=1.0/FREQUENCE_PHYSIQUE;  // temps rel entre deux pas de simulation (s)
+    double accumulateur=0;                  // temps rel coul pas encore simul (s)
+    Uint64 compteur_precedent;              // compteur haute prcision au tour de boucle prcdent
+    Uint64 compteur;                        // compteur haute prcision au tour de boucle actuel
+
+    // attente des vnements
+    int image_affichee=1;                   // 1 si le tour prcdent a chang l'affichage
+    int fenetre_cachee=0;                   // 1 si la fentre est cache ou rduite (rien n'est dessin)
+    Uint32 delai_attente;                   // attente max (ms) du prochain vnement
+
     // interaction souris
     int mousex=0,mousey=0;                      // position de la souris
 
-    // autres
-    int i;                                  // itrateur pour le dcompte de clignotement
+    // trace de la dure des modes
+    const char* tab_noms_modes[NB_MODES]={"DEBUT","QUITTER","CHARGEMENT_NIVEAU","AJUSTEMENT_LANCER",
+                                          "DEPART_LANCER","SIMULATION_VOL","TOUCHER_CIBLE","RATER_CIBLE"};
+    int mode_trace=MODE_DEBUT;              // mode de l'intervalle en cours dans la trace
+    int niveau_trace=PREMIER_NIVEAU;        // niveau au dbut de cet intervalle
+    Uint64 debut_mode=0;                    // dbut de cet intervalle (0: aucun)
+    Uint64 debut_trace;                     // dbut d'un pas de simulation ou d'un chargement de niveau
+
+    // animations de fin de lancer et niveau charg pendant l'animation
+    Uint32 debut_animation=0;               // temps (ms) au dbut de l'animation en cours (0: aucune)
+    int etape;                              // tape de l'animation (visible/invisible, 2 par clignotement)
+    t_niveau niv_suivant;                   // niveau recharg pendant l'animation d'un lancer rat
+    int niveau_precharge=-1;                // index du niveau charg dans niv_suivant (-1: aucun)
+    long nb_succes_cache,nb_lectures_niveaux;   // statistiques du cache des niveaux
+
+    // trace facultative: BONGalistix -trace partie.json
+    if (argc>=3 && strcmp(args[1],OPTION_TRACE)==0){
+        if (trace_demarrer(args[2])) printf("[ OK] - Trace vers %s\n",args[2]);
+        else printf("[ERR] - Trace impossible\n");
+    }
+
+    // niveaux lus gards en mmoire (un niveau rejou n'est pas relu)
+    choisir_lecture_niveau(lire_niveau_cache);
+
+#ifndef NIVEAUX_EMBARQUES
+    // niveaux dj prpars du paquet (sinon lus dans le dossier des niveaux)
+    if (ouvrir_paquet_niveaux(FICHIER_PAQUET_NIVEAUX)>=0) printf("[ OK] - Paquet de niveaux %s\n",FICHIER_PAQUET_NIVEAUX);
+#endif
 
+    // fil qui charge le niveau suivant pendant la partie
+    if (!demarrer_prechargement()) printf("[ERR] - Prechargement des niveaux impossible\n");
+#ifndef NIVEAUX_EMBARQUES
+    // fil qui recharge le niveau en cours quand son fichier est modifi
+    // (niveaux intgrs: pas de fichiers  surveiller)
+    if (!demarrer_rechargement()) printf("[ERR] - Rechargement a chaud des niveaux impossible\n");
+#endif
+
+    // niveau vide en attendant le premier chargement
+    initialiser_niveau(&niv);
+    initialiser_niveau(&niv_suivant);
+    initialiser_calque(&calque_murs,LARGEUR_FEN,HAUTEUR_FEN);
+    initialiser_redessin(&redessin,LARGEUR_FEN,HAUTEUR_FEN);
+
+    // tester plusieurs murs  la fois avec les instructions vectorielles du processeur
+    if (SDL_HasAVX2()) choisir_noyau_murs_simd(NOYAU_AVX2);
+    else if (SDL_HasSSE2()) choisir_noyau_murs_simd(NOYAU_SSE2);
 
     // initialiser le graphisme et ouvrir la fentre d'affichage du jeu
     if (!graph_init("BONGallistix: Balistique et rebonds",LARGEUR_FEN,HAUTEUR_FEN,
@@ -227,8 +284,29 @@ int main( int argc, char* args[] ){
         mode=MODE_CHARGEMENT_NIVEAU;
 
         // tant que le mode quitter n'est pas atteint, continuer le jeu
+        compteur_precedent=SDL_GetPerformanceCounter();
         while (mode!=MODE_QUITTER){
+            // si rien n'a chang  l'cran au tour prcdent (ou si la fentre est cache),
+            // dormir jusqu'au prochain vnement ou au plus tard jusqu'au prochain changement
+            // possible de l'affichage, plutt que de boucler sans arrt
+            if (!image_affichee || fenetre_cachee){
+                if (mode==MODE_AJUSTEMENT_LANCER) delai_attente=DELAI_ATTENTE_MAX;
+                else if (fenetre_cachee) delai_attente=DELAI_FENETRE_CACHEE;
+                // pendant un clignotement, l'affichage ne change qu' l'tape suivante
+                else if (debut_animation!=0) delai_attente=PERIODE_CLIGNOTEMENT-(SDL_GetTicks()-debut_animation)%PERIODE_CLIGNOTEMENT;
+                else delai_attente=DELAI_SANS_AFFICHAGE;
+                profil_debut(PROFIL_ATTENTE);
+                SDL_WaitEventTimeout(NULL,delai_attente);
+                profil_fin(PROFIL_ATTENTE);
+            }
+
+            // temps rel coul depuis le tour de boucle prcdent
+            compteur=SDL_GetPerformanceCounter();
+            accumulateur+=(double)(compteur-compteur_precedent)/SDL_GetPerformanceFrequency();
+            compteur_precedent=compteur;
+
             // grer les vnements de souris affectant la fentre graphique
+            profil_debut(PROFIL_EVENEMENTS);
             while(SDL_PollEvent(&event))
                 {
                     switch(event.type){
@@ -249,24 +327,82 @@ int main( int argc, char* args[] ){
                                     break;
                             }
                             break;
+                        case SDL_RENDER_TARGETS_RESET:
+                            // le contenu des textures de rendu a t perdu
+                            calque_invalider(&calque_murs);
+                            redessin_tout(&redessin);
+                            break;
+                        case SDL_RENDER_DEVICE_RESET:
+                            // les textures elles-mmes ont t perdues
+                            liberer_calque(&calque_murs);
+                            liberer_redessin(&redessin);
+                            break;
+                        case SDL_WINDOWEVENT:
+                            switch (event.window.event){
+                                case SDL_WINDOWEVENT_HIDDEN:
+                                case SDL_WINDOWEVENT_MINIMIZED:
+                                    // fentre cache ou rduite: ne plus dessiner
+                                    fenetre_cachee=1;
+                                    break;
+                                case SDL_WINDOWEVENT_SHOWN:
+                                case SDL_WINDOWEVENT_RESTORED:
+                                case SDL_WINDOWEVENT_EXPOSED:
+                                    // fentre dcouverte ou agrandie: son contenu doit tre rtabli
+                                    fenetre_cachee=0;
+                                    redessin_tout(&redessin);
+                                    break;
+                            }
+                            break;
+                        case SDL_KEYDOWN:
+                            if (event.key.keysym.sym==TOUCHE_PROFIL) profil_resume(stdout);
+                            break;
                     }
                 }
+            profil_fin(PROFIL_EVENEMENTS);
+
+            // fichier du niveau en cours modifi pendant la partie: appliquer les changements
+            // prpars par le fil de rechargement (sauf pendant le changement de niveau)
+            if (mode!=MODE_CHARGEMENT_NIVEAU) appliquer_niveau_modifie(&niv,&calque_murs,&redessin);
 
             // selon le mode mettre  jour le lanceur, projectile, ... et les lments qui doivent tre visibles  l'cran
+            // (le chargement du niveau suivant pendant une animation est compt dans cette phase)
+            profil_debut(PROFIL_LOGIQUE);
+            // un intervalle de la trace par sjour dans un mode (les clignotements en font partie)
+            if (mode!=mode_trace){
+                trace_fin("mode",tab_noms_modes[mode_trace],debut_mode,niveau_trace);
+                mode_trace=mode;
+                niveau_trace=niveau;
+                debut_mode=trace_debut();
+            }
 			switch (mode) {
 
 			case MODE_CHARGEMENT_NIVEAU:
 				// Charger le niveau en mmoire
-				nb_segments = lire_fichier_niveau(niveau, DOSSIER_NIVEAU, DEBUT_NOM_FICHIER_NIVEAU, FIN_NOM_FICHIER_NIVEAU,
-					tab_segments, tab_lanceur, tab_cible);
+				// (dj charg pendant l'animation de fin du lancer rat ou par le fil de
+				// prchargement, le cas chant)
+				if (niveau_precharge == niveau) echanger_niveaux(&niv, &niv_suivant);
+				else if (!prendre_niveau_precharge(niveau, &niv)) {
+					debut_trace = trace_debut();
+					charger_niveau(niveau, &niv);
+					trace_fin("niveau", "charger_niveau", debut_trace, niveau);
+				}
+				niveau_precharge = -1;
 
 				// si le chargement  fonctionn, l'afficher et passer au lancer
-				if (nb_segments < 0) {
+				if (niv.nb_segments < 0) {
 					printf("[ERR] - Mode CHARGEMENT_NIVEAU (niveau %d)\n", niveau);
 					mode = MODE_QUITTER;
 				}
 				else {
 					printf("[ OK] - Mode CHARGEMENT_NIVEAU (niveau %d)\n", niveau);
+					// les murs du nouveau niveau seront tracs dans le calque au prochain affichage
+					calque_invalider(&calque_murs);
+					// tableaux de travail de l'affichage des murs  la taille du niveau
+					if (!reserver_murs_affiches(niv.nb_segments)) printf("[ERR] - Memoire insuffisante pour afficher les murs\n");
+					// surveiller le fichier du niveau pour le recharger s'il est modifi
+					surveiller_niveau(niveau, &niv);
+					// prparer le niveau suivant en arrire-plan pendant la partie
+					demander_prechargement((niveau == DERNIER_NIVEAU) ? PREMIER_NIVEAU : niveau + 1);
 					// ajuster le titre de la fenetre en fonction du niveau charg
 					sprintf(titre_fenetre, "BONGallistix - Niveau %d", niveau);
 					graph_titre(titre_fenetre);
@@ -281,7 +417,7 @@ int main( int argc, char* args[] ){
 
 			case MODE_AJUSTEMENT_LANCER:
 				// calculer les paramtres du lanceur en fonction de la position de la souris
-				calcule_lanceur(mousex, mousey, V_INITIALE_MAX, tab_lanceur);
+				calcule_lanceur(mousex, mousey, V_INITIALE_MAX, niv.tab_lanceur);
 				// dfinir les lments qui sont visibles lors de l'ajustement du lancer pour le prochain affichage
 				elements_visibles = MURS_VISIBLE | CIBLE_VISIBLE | LANCEUR_VISIBLE;
 				break;
@@ -292,17 +428,24 @@ int main( int argc, char* args[] ){
 				printf("[ OK] - Mode DEPART_LANCER\n");
 				// initialiser la position (x1,y1) du projectile selon le point d'origine du lanceur,
 							
-				tab_projectile[POSITION][X1] = tab_lanceur[X0];
-				tab_projectile[POSITION][Y1] = tab_lanceur[Y0];
+				tab_projectile[POSITION][X1] = niv.tab_lanceur[X0];
+				tab_projectile[POSITION][Y1] = niv.tab_lanceur[Y0];
 
 				// la vitesse (vx1,vy1) du projectile selon la longueur du lanceur
 
-					tab_projectile[VITESSE][X1] = tab_lanceur[X1] - tab_lanceur[X0];
-					tab_projectile[VITESSE][Y1] = tab_lanceur[Y1] - tab_lanceur[Y0];
+					tab_projectile[VITESSE][X1] = niv.tab_lanceur[X1] - niv.tab_lanceur[X0];
+					tab_projectile[VITESSE][Y1] = niv.tab_lanceur[Y1] - niv.tab_lanceur[Y0];
+
+				// l'ancienne position est aussi celle du lanceur pour que l'affichage
+				// interpol parte du lanceur
 
-				// remise du temps a 0
+				tab_projectile[POSITION][X0] = tab_projectile[POSITION][X1];
+				tab_projectile[POSITION][Y0] = tab_projectile[POSITION][Y1];
+
+				// remise du temps a 0 (temps simul et temps rel pas encore simul)
 			
 				t = 0; 
+				accumulateur = 0;
 
                 // passer au mode de simulation de trajectoire
                  
@@ -322,54 +465,44 @@ int main( int argc, char* args[] ){
 
                     // recalculer la position du lanceur pour qu'il suive la souris pendant la simulation de vol
                 	
-					calcule_lanceur(mousex, mousey,V_INITIALE_MAX, tab_lanceur);
-
-                    // mise  jour ballistique de la position/vitesse (ignorer les rebonds pour le moment)
-                   
-					mise_a_jour_ballistique(tab_projectile, &t, dt);
-
-                    // corriger la nouvelle position/vitesse pour tenir compte des rebonds
-                    
-					mise_a_jour_rebond(tab_segments, nb_segments,
-						tab_projectile, &t, &dt);
-
-                    // appliquer un dlai  la simulation pour que l'coulement du temps soit raliste
-                    // Note: le delai est appliqu directement en secondes pour que la simulation
-                    // soit 1000 fois plus rapide que la ralit et ajoute du dynamisme au jeu
-                    graph_delai_ms(dt);
-
-                    // vrifier si la cible est atteinte et ventuellement changer le mode en consquence
-
-                    if (cible_atteinte(tab_projectile,tab_cible))
-					{
-                       mode = MODE_TOUCHER_CIBLE;
-                    }
-                    else{ // si la balle n'a pas boug d'un pixel,
-                          // chronomtrer le temps d'immobilit du projectile
-                        if (projectile_immobile(tab_projectile)){
-                            // si la balle n'a pas boug d'un pixel mettre  jour
-                            // le chronomtre d'immobilite
-                            chrono_immobile+=dt;
-                            // vrifier que le temps max d'immobilit n'est pas atteint
-                            if (chrono_immobile>=T_IMMOBILE_MAX){
-                                // la cible est rat passer au mode correspondant
-                                ///***  complter ***///
-								mode = MODE_RATER_CIBLE;
-
-                                // remettre le chronomtre  0
-                                ///***  complter ***///
-								chrono_immobile = 0;
-
-                                //printf("vx=%lf vy=%lf vx0=%lf vy0=%lf diff=%lf dt=%lf\n",vx,vy,vx0,vy0,sqrt(pow(vx-vx0,2)+pow(vy-vy0,2)),dt);
-
+					calcule_lanceur(mousex, mousey,V_INITIALE_MAX, niv.tab_lanceur);
+
+                    // simuler autant de pas de dure fixe (dt) que le temps rel coul en contient
+                    // pour que la vitesse du vol ne dpende pas de la frquence d'affichage.
+                    // Aprs un long blocage de l'affichage, le retard n'est pas rattrap au complet
+                    if (accumulateur>MAX_PAS_PAR_IMAGE*periode) accumulateur=MAX_PAS_PAR_IMAGE*periode;
+                    while (mode==MODE_SIMULATION_VOL && accumulateur>=periode){
+                        accumulateur-=periode;
+
+                        // mise  jour ballistique de la position/vitesse pendant un pas complet,
+                        // en tenant compte de tous les rebonds du pas
+                        debut_trace=trace_debut();
+                        mise_a_jour_vol(&niv, tab_projectile, &t, dt);
+                        trace_fin("physique","pas_vol",debut_trace,niveau);
+
+                        // vrifier si la cible est atteinte et ventuellement changer le mode en consquence
+                        if (cible_atteinte(tab_projectile,niv.tab_cible)){
+                            mode = MODE_TOUCHER_CIBLE;
+                        }
+                        else{ // si la balle n'a pas boug d'un pixel,
+                              // chronomtrer le temps d'immobilit du projectile
+                            if (projectile_immobile(tab_projectile)){
+                                // si la balle n'a pas boug d'un pixel mettre  jour
+                                // le chronomtre d'immobilite
+                                chrono_immobile+=dt;
+                                // vrifier que le temps max d'immobilit n'est pas atteint
+                                if (chrono_immobile>=T_IMMOBILE_MAX){
+                                    // la cible est rat passer au mode correspondant
+                                    mode = MODE_RATER_CIBLE;
+
+                                    // remettre le chronomtre  0
+                                    chrono_immobile = 0;
+                                }
                             }
+                            else chrono_immobile=0; // si la balle bouge encore, remettre le chrono d'immobilit  0
                         }
-                        else chrono_immobile=0; // si la balle bouge encore, remettre le chrono d'immobilit  0
                     }
 
-                    // remettre l'increment de temps  sa valeur par dfaut
-                    dt=DELTAT;
-
                     // dfinir les lments qui sont visibles lors de la simulation de vol pour le prochain affichage
                     ///***  complter ***///
 
@@ -378,167 +511,247 @@ int main( int argc, char* args[] ){
                     break;
 
                 case MODE_TOUCHER_CIBLE:
-                    printf("[ OK] - Mode TOUCHER_CIBLE\n");
-                    // en cas de russite, faire clignoter la cible selon
-                    // les paramtres NB_CLIGNOTEMENT et PERIODE_CLIGNOTEMENT
-                    					
-					if (cible_atteinte(tab_projectile, tab_cible))
-					{
-						for (i = 0; i < NB_CLIGNOTEMENT; i++)
-						{
-							elements_visibles = TOUS_VISIBLE;
-
-							afficher_elements(elements_visibles,
-								tab_segments, nb_segments,
-								tab_cible,
-								tab_lanceur,
-								tab_projectile);
-
-							graph_delai_ms(PERIODE_CLIGNOTEMENT);
-							
-							elements_visibles = MURS_VISIBLE | LANCEUR_VISIBLE | PROJECTILE_VISIBLE;
-							
-							afficher_elements(elements_visibles,
-								tab_segments, nb_segments,
-								tab_cible,
-								tab_lanceur,
-								tab_projectile);
-
-							graph_delai_ms(PERIODE_CLIGNOTEMENT);
-						}
-					}
-					
-					
-
-					printf("mode toucher cible");
-
-                    // passer au niveau suivant ou revenir au premier si fin des niveaux
-                    
-					if (niveau == DERNIER_NIVEAU)
-					{
-						niveau = PREMIER_NIVEAU;
-					}
-
-					else 
-					{
-						niveau += PREMIER_NIVEAU;
-					}
-
-					printf("Niveau = %d", niveau);
-
-                    //revenir au mode de chargement de niveau
-                    
-					
-					mode = MODE_CHARGEMENT_NIVEAU;
-
+                    // le niveau suivant est prpar par le fil de prchargement depuis le
+                    // dbut du niveau
+                    if (debut_animation==0){
+                        printf("[ OK] - Mode TOUCHER_CIBLE\n");
+                        debut_animation=SDL_GetTicks();
+                    }
+                    // faire clignoter la cible selon les paramtres NB_CLIGNOTEMENT et PERIODE_CLIGNOTEMENT,
+                    // sans bloquer la boucle: l'tape de l'animation dpend du temps coul
+                    etape=(SDL_GetTicks()-debut_animation)/PERIODE_CLIGNOTEMENT;
+                    if (etape<2*NB_CLIGNOTEMENT){
+                        elements_visibles=(etape%2==0)?TOUS_VISIBLE:MURS_VISIBLE|LANCEUR_VISIBLE|PROJECTILE_VISIBLE;
+                    }
+                    else{
+                        // passer au niveau suivant ou revenir au premier si fin des niveaux
+                        debut_animation=0;
+                        niveau=(niveau==DERNIER_NIVEAU)?PREMIER_NIVEAU:niveau+1;
+                        mode=MODE_CHARGEMENT_NIVEAU;
+                    }
                     break;
 
                 case MODE_RATER_CIBLE:
-                    printf("[ OK] - Mode RATER_CIBLE\n");
-                    // en cas d'chec du lancer, faire clignoter les murs selon
-                    // les paramtres NB_CLIGNOTEMENT et PERIODE_CLIGNOTEMENT
-                    
-					
-					if (projectile_immobile(tab_projectile))
-					{
-						for (i = 0; i < NB_CLIGNOTEMENT; i++)
-						{
-
-							elements_visibles = TOUS_VISIBLE;
-
-							afficher_elements(elements_visibles,
-								tab_segments, nb_segments,
-								tab_cible,
-								tab_lanceur,
-								tab_projectile);
-
-							graph_delai_ms(PERIODE_CLIGNOTEMENT);
-
-							elements_visibles =  LANCEUR_VISIBLE | PROJECTILE_VISIBLE | CIBLE_VISIBLE;
-
-							afficher_elements(elements_visibles,
-								tab_segments, nb_segments,
-								tab_cible,
-								tab_lanceur,
-								tab_projectile);
-
-							graph_delai_ms(PERIODE_CLIGNOTEMENT);
-
-						}
+                    // au premier tour, recharger le niveau pendant que les murs clignotent
+                    if (debut_animation==0){
+                        printf("[ OK] - Mode RATER_CIBLE\n");
+                        debut_animation=SDL_GetTicks();
+                        niveau_precharge=niveau;
+                        debut_trace=trace_debut();
+                        charger_niveau(niveau_precharge,&niv_suivant);
+                        trace_fin("niveau","charger_niveau",debut_trace,niveau_precharge);
+                    }
+                    // faire clignoter les murs selon les paramtres NB_CLIGNOTEMENT et PERIODE_CLIGNOTEMENT
+                    etape=(SDL_GetTicks()-debut_animation)/PERIODE_CLIGNOTEMENT;
+                    if (etape<2*NB_CLIGNOTEMENT){
+                        elements_visibles=(etape%2==0)?TOUS_VISIBLE:LANCEUR_VISIBLE|PROJECTILE_VISIBLE|CIBLE_VISIBLE;
+                    }
+                    else{
+                        debut_animation=0;
+                        mode=MODE_CHARGEMENT_NIVEAU;
+                    }
+                    break;
+            }
+            profil_fin(PROFIL_LOGIQUE);
+
+            // afficher/mettre  jour les lments qui doivent tre visibles.
+            // Pendant le vol, le projectile est affich entre ses deux dernires positions
+            // simules, selon la fraction de pas coule depuis le dernier pas
+            interpoler_projectile(tab_projectile,
+                                  (mode==MODE_SIMULATION_VOL)?accumulateur/periode:1,
+                                  tab_affichage);
+            // (rien n'est dessin quand la fentre est cache)
+            if (fenetre_cachee) image_affichee=0;
+            else image_affichee=afficher_elements(  elements_visibles,
+                                niv.tab_murs,niv.nb_segments,niv.bvh,&calque_murs,&redessin,
+                                niv.tab_cible,
+                                niv.tab_lanceur,
+                                tab_affichage);
+
+            // fin de l'image: ajouter le temps de chaque phase aux histogrammes
+            profil_image();
+        }
+    }
 
-						mode = MODE_CHARGEMENT_NIVEAU;
-					}
-					break;                                                                                    // TODO
+    // rsum du temps des images de la partie
+    profil_resume(stdout);
+    statistiques_cache_niveaux(&nb_succes_cache,&nb_lectures_niveaux);
+    printf("Niveaux: %ld recopies du cache, %ld fichiers lus\n",nb_succes_cache,nb_lectures_niveaux);
 
-            }
+    // terminer les fils de prchargement et de rechargement avant de fermer la trace (ils y crivent leurs intervalles)
+    arreter_prechargement();
+    arreter_rechargement();
 
-            // afficher/mettre  jour les lments qui doivent tre visibles
-            afficher_elements(  elements_visibles,
-                                tab_segments,nb_segments,
-                                tab_cible,
-                                tab_lanceur,
-                                tab_projectile);
-        }
+    // fermer l'intervalle du dernier mode et crire la trace
+    if (trace_active()){
+        trace_fin("mode",tab_noms_modes[mode_trace],debut_mode,niveau_trace);
+        if (trace_arreter()<0) printf("[ERR] - Ecriture de la trace impossible\n");
+        else printf("[ OK] - Trace ecrite\n");
     }
 
 
+    // librer les donnes du dernier niveau charg
+    liberer_niveau(&niv);
+    liberer_niveau(&niv_suivant);
+    fermer_paquet_niveaux();
+    liberer_murs_affiches();
+    liberer_calque(&calque_murs);
+    liberer_redessin(&redessin);
+
     // fin du graphisme
     graph_fin();
 
     return EXIT_SUCCESS;
 }
-// ---------------------------------------------
-/* fonction: projectile_immobile
-    Description:    Teste si le projectile est immobile en comparant l'ancienne et
-                    la nouvelle position
-    Note:           Le projectile est visuellement immobile s'il ne change pas de pixel,
-                    donc si la partie entire de ses coordonnes n'ont pas changes
-    Paramtre(s):   tab_projectile      Le tableau d'infos du projectile
-    Retour:         1 si le projectile est immobile 0 sinon
-    Ex. d'utilisation:
-                    // teste si le projectile est immobile
-                    if (projectile_immobile(tab_projectile))
-
-*/
-int projectile_immobile(double tab_projectile[][COL_TABPRO]){   //test si le projectile est immobile
-    return ((floor(tab_projectile[POSITION][X1])-floor(tab_projectile[POSITION][X0])==0)&&
-            (floor(tab_projectile[POSITION][Y1])-floor(tab_projectile[POSITION][Y0])==0));
-}
 
 // ---------------------------------------------
 /* fonction: afficher_elements
-    Description:    Trace les segments et rectangle de tous les lments qui doivent tre visible
+    Description:    Affiche tous les lments qui doivent tre visible.
                     Les consignes de visibilit pour tous les lments sont donnes une seule variable
+                    Seules les zones o un lment a chang (apparu, disparu ou dplac) depuis le
+                    dernier affichage sont redessines dans la scne conserve, puis la scne est
+                    affiche. Si rien n'a chang, rien n'est affich. Sans suivi des zones (ou si le
+                    renderer ne le permet pas), tout est redessin dans la fentre.
     Note:           Les constantes MURS_VISIBLE,CIBLE_VISIBLE,LANCEUR_VISIBLE et PROJECTILE_VISIBLE
                     sont dfinie pour construire la consigne de visibilit.
                     Par exemple, si element_visible=MURS_VISIBLE|CIBLE_VISIBLE seuls les murs et la cible
                     seront affich. Si element_visible=MURS_VISIBLE|CIBLE_VISIBLE|LANCEUR_VISIBLE , les murs,
                     la cible et le lanceur seront affichs.
     Paramtre(s):   elements_visibles     la consigne de visibilit pour tous les lments
-                    tab_murs            Le tableau d'infos des segments de murs
+                    tab_murs            Les murs compils du niveau (voir compiler_segment)
                     nb_murs             Le nombre de murs  tracer
+                    bvh_murs            L'arbre des murs (NULL pour tracer tous les murs)
+                    calque_murs         Le calque des murs, dessin au premier affichage puis
+                                        recopi tel quel (NULL pour tracer les murs  chaque fois)
+                    redessin            Le suivi des zones  redessiner (NULL pour tout redessiner)
                     tab_cible           Le tableau d'infos sur la cible
                     tab_lanceur         Le tableau d'infos sur le lanceur
                     tab_projectile      Le tableau d'infos sur le projectile
-    Retour:         aucun
+    Retour:         1 si la fentre a t mise  jour, 0 si rien n'a chang
     Ex. d'utilisation:
                     // afficher 10 segments de murs et le projectile
-                    afficher_elements(MURS_VISIBLE|PROJECTILE_VISIBLE,tab_murs,10,
+                    afficher_elements(MURS_VISIBLE|PROJECTILE_VISIBLE,tab_murs,10,NULL,NULL,NULL,
                                       tab_cible,tab_lanceur,tab_projectile);
 
 */
-void afficher_elements(int elements_visibles,
-                       int tab_murs[][COL_TABSEG],int nb_murs,
-                       int tab_cible[],
-                       int tab_lanceur[],
-                       double tab_projectile[][COL_TABPRO])
+int afficher_elements(int elements_visibles,
+                      t_segment_compile tab_murs[],int nb_murs,t_bvh* bvh_murs,
+                      t_calque* calque_murs,t_redessin* redessin,
+                      int tab_cible[],
+                      int tab_lanceur[],
+                      double tab_projectile[][COL_TABPRO])
+{
+    int nb_zones=-1;    // nb de zones  redessiner (-1: tout redessiner dans la fentre)
+    int i;
+
+    profil_debut(PROFIL_DESSIN);
+
+    // les murs ne changent pas pendant un niveau: les tracer une seule fois dans le calque
+    if ((elements_visibles&MURS_VISIBLE) && calque_murs!=NULL && !calque_pret(calque_murs) &&
+        calque_debut_dessin(calque_murs)){
+        afficher_murs(tab_murs,nb_murs,nb_murs,bvh_murs);
+        calque_fin_dessin(calque_murs);
+        if (redessin!=NULL) redessin_tout(redessin);
+    }
+
+    if (redessin!=NULL){
+        // bote englobante de chaque lment (les murs couvrent toute la fentre)
+        redessin_element(redessin,ELEMENT_MURS,elements_visibles&MURS_VISIBLE,
+                         0,0,LARGEUR_FEN-1,HAUTEUR_FEN-1);
+        redessin_element(redessin,ELEMENT_CIBLE,elements_visibles&CIBLE_VISIBLE,
+                         tab_cible[X0],tab_cible[Y0],tab_cible[X1],tab_cible[Y1]);
+        redessin_element(redessin,ELEMENT_LANCEUR,elements_visibles&LANCEUR_VISIBLE,
+                         tab_lanceur[X0],tab_lanceur[Y0],tab_lanceur[X1],tab_lanceur[Y1]);
+        redessin_element(redessin,ELEMENT_PROJECTILE,elements_visibles&PROJECTILE_VISIBLE,
+                         (int)floor(tab_projectile[POSITION][X1])-TAILLE_PRO,
+                         (int)floor(tab_projectile[POSITION][Y1])-TAILLE_PRO,
+                         (int)ceil(tab_projectile[POSITION][X1])+TAILLE_PRO,
+                         (int)ceil(tab_projectile[POSITION][Y1])+TAILLE_PRO);
+        nb_zones=redessin_debut(redessin);
+        if (nb_zones==0){
+            profil_fin(PROFIL_DESSIN);
+            return 0;
+        }
+    }
+
+    if (nb_zones<0){
+        graph_clear(COULEUR_BG_R,COULEUR_BG_G,COULEUR_BG_B,COULEUR_BG_A);
+        tracer_elements(elements_visibles,tab_murs,nb_murs,bvh_murs,calque_murs,
+                        tab_cible,tab_lanceur,tab_projectile);
+    }
+    else{
+        for (i=0;i<nb_zones;i++){
+            redessin_zone(redessin,i,COULEUR_BG_R,COULEUR_BG_G,COULEUR_BG_B,COULEUR_BG_A);
+            tracer_elements(elements_visibles,tab_murs,nb_murs,bvh_murs,calque_murs,
+                            tab_cible,tab_lanceur,tab_projectile);
+        }
+        redessin_fin(redessin);
+    }
+    profil_fin(PROFIL_DESSIN);
+
+    profil_debut(PROFIL_PRESENTATION);
+    graph_mise_a_jour();
+    profil_fin(PROFIL_PRESENTATION);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: appliquer_niveau_modifie
+    Description:    applique au niveau en cours les changements de son fichier prpars par
+                    le fil de rechargement (voir rechargement.h), s'il y en a. Si seuls
+                    quelques murs ont chang, seule la zone qui les contient est efface et
+                    redessine dans le calque des murs et dans la scne; sinon le calque est
+                    redessin au complet au prochain affichage. Le lanceur et la cible sont
+                    redessins par le suivi des zones modifies (voir afficher_elements).
+    Paramtre(s):   niv             niveau en cours
+                    calque_murs     calque des murs du niveau
+                    redessin        suivi des zones  redessiner
+    Retour:         aucun
+    Ex. d'utilisation:
+                    appliquer_niveau_modifie(&niv,&calque_murs,&redessin);
+*/
+void appliquer_niveau_modifie(t_niveau* niv,t_calque* calque_murs,t_redessin* redessin)
+{
+    int complet;        // 1 si tout le niveau a t remplac
+    int tab_zone[4];    // rectangle englobant les murs modifis (x1,y1,x2,y2)
+
+    if (!appliquer_rechargement(niv,&complet,tab_zone)) return;
+    printf("[ OK] - Niveau modifie (%s)\n",complet?"complet":"murs");
+
+    if (complet) calque_invalider(calque_murs);
+    else if (tab_zone[0]<=tab_zone[2] && calque_pret(calque_murs)){
+        if (calque_reprendre_dessin(calque_murs)){
+            // effacer les anciens murs de la zone et y retracer tous les murs qui la touchent
+            calque_effacer_zone(calque_murs,tab_zone[0]-REDESSIN_MARGE,tab_zone[1]-REDESSIN_MARGE,
+                                tab_zone[2]+REDESSIN_MARGE,tab_zone[3]+REDESSIN_MARGE);
+            afficher_murs(niv->tab_murs,niv->nb_segments,niv->nb_segments,niv->bvh);
+            calque_fin_dessin(calque_murs);
+            redessin_zone_modifiee(redessin,tab_zone[0],tab_zone[1],tab_zone[2],tab_zone[3]);
+        }
+        else calque_invalider(calque_murs);
+    }
+}
+
+// ---------------------------------------------
+/* fonction: tracer_elements
+    Description:    Trace les segments et rectangle de tous les lments qui doivent tre visible
+                    (voir afficher_elements), par-dessus ce qui est dj trac
+    Paramtre(s):   les mmes que afficher_elements
+    Retour:         aucun
+*/
+void tracer_elements(int elements_visibles,
+                     t_segment_compile tab_murs[],int nb_murs,t_bvh* bvh_murs,t_calque* calque_murs,
+                     int tab_cible[],
+                     int tab_lanceur[],
+                     double tab_projectile[][COL_TABPRO])
 {
-    graph_clear(COULEUR_BG_R,COULEUR_BG_G,COULEUR_BG_B,COULEUR_BG_A);
-    if (elements_visibles&MURS_VISIBLE) afficher_murs(tab_murs,nb_murs,MAXSEGMENT);
+    if (elements_visibles&MURS_VISIBLE){
+        if (calque_murs!=NULL && calque_pret(calque_murs)) calque_afficher(calque_murs);
+        else afficher_murs(tab_murs,nb_murs,nb_murs,bvh_murs);
+    }
     if (elements_visibles&CIBLE_VISIBLE) afficher_cible(tab_cible);
     if (elements_visibles&LANCEUR_VISIBLE) afficher_lanceur(tab_lanceur);
     if (elements_visibles&PROJECTILE_VISIBLE) afficher_projectile(tab_projectile);
-    graph_mise_a_jour();
 }
 
 // ---------------------------------------------
@@ -581,6 +794,31 @@ void afficher_projectile(double tab_projectile[][COL_TABPRO]){
 
 }
 
+// ---------------------------------------------
+/* fonction: interpoler_projectile
+    Description:    calcule l'tat du projectile  afficher entre sa position prcdente
+                    (x0,y0) et sa position actuelle (x1,y1)
+    Note:           la simulation avance par pas de dure fixe alors que l'affichage suit
+                    la frquence de l'cran; l'interpolation vite que le projectile
+                    semble avancer par saccades quand les deux frquences diffrent
+    Paramtre(s):   tab_projectile  le tableau d'info sur le projectile
+                    alpha           fraction du pas coule (0: position prcdente, 1: actuelle)
+                    tab_affichage   le tableau d'info  remplir pour l'affichage
+    Retour:         aucun
+    Ex. d'utilisation:
+                    interpoler_projectile(tab_projectile,0.5,tab_affichage);   //  mi-chemin
+*/
+void interpoler_projectile(double tab_projectile[][COL_TABPRO],double alpha,double tab_affichage[][COL_TABPRO]){
+    int i;
+
+    for (i=0;i<COL_TABPRO;i++){
+        tab_affichage[POSITION][i]=tab_projectile[POSITION][i];
+        tab_affichage[VITESSE][i]=tab_projectile[VITESSE][i];
+    }
+    tab_affichage[POSITION][X1]=tab_projectile[POSITION][X0]+alpha*(tab_projectile[POSITION][X1]-tab_projectile[POSITION][X0]);
+    tab_affichage[POSITION][Y1]=tab_projectile[POSITION][Y0]+alpha*(tab_projectile[POSITION][Y1]-tab_projectile[POSITION][Y0]);
+}
+
 // ---------------------------------------------
 /* fonction: afficher_lanceur
     Description:    trace le segment du lanceur dans la couleur prvue pour le lanceur
@@ -600,25 +838,74 @@ void afficher_lanceur(int tab_lanceur[] ){
 
 }
 
+// ---------------------------------------------
+/* fonction: reserver_murs_affiches
+    Description:    agrandit au besoin les tableaux de travail de afficher_murs pour un
+                    niveau de nb_murs murs (appele au chargement d'un niveau: les images
+                    suivantes n'allouent rien)
+    Paramtre(s):   nb_murs     nb de murs du niveau
+    Retour:         1 en cas de succs, 0 si la mmoire manque (les tableaux sont alors
+                    inchangs)
+    Ex. d'utilisation:
+                    reserver_murs_affiches(niv.nb_segments);
+*/
+int reserver_murs_affiches(int nb_murs)
+{
+    int* visibles;
+    int (*traces)[COL_TABSEG];
+
+    if (nb_murs<=capacite_murs_affiches) return 1;
+    visibles=(int*)realloc(tab_visibles,nb_murs*sizeof(*visibles));
+    if (visibles==NULL) return 0;
+    tab_visibles=visibles;
+    traces=(int (*)[COL_TABSEG])realloc(tab_traces,nb_murs*sizeof(*traces));
+    if (traces==NULL) return 0;
+    tab_traces=traces;
+    capacite_murs_affiches=nb_murs;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_murs_affiches
+    Description:    libre les tableaux de travail de afficher_murs
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void liberer_murs_affiches()
+{
+    free(tab_visibles);
+    free(tab_traces);
+    tab_visibles=NULL;
+    tab_traces=NULL;
+    capacite_murs_affiches=0;
+}
+
 // ---------------------------------------------
 /* fonction: afficher_murs
-    Description:    trace tous les segments de murs dcrits dans le tableau de segments
-                    en utilisant la couleur prvue pour les murs.
+    Description:    trace tous les murs compils du niveau en utilisant la couleur prvue
+                    pour les murs. Seuls les murs qui touchent la fentre sont tracs: ils
+                    sont trouvs avec l'arbre des murs s'il est fourni, sinon avec le
+                    rectangle englobant de chaque mur. Les tableaux de travail sont gards
+                    d'un appel  l'autre (voir reserver_murs_affiches) et agrandis si le
+                    niveau a grandi: le niveau n'a pas de nombre maximum de murs.
     Note:           les constantes COULEUR_MUR_R,COULEUR_MUR_G,COULEUR_MUR_B,COULEUR_MUR_A
                     dfinissent la couleur (RGBA) prvue pour les murs
                     Comme pour toutes les fonctions de dessin graphique, le dessin ne sera visible
                     qu'aprs un appel  la fonction graph_mise_a_jour();
-    Paramtre(s):   tab_segments    le tableau d'info sur les segments de murs
+    Paramtre(s):   tab_murs        les murs compils (voir compiler_segment)
                     nb_segments     le nombre de segments  tracer
                     max_segments    la nombre de segments maximum que peut contenir le tableau
-    Retour:         le nombre de segments tracs ou -1 en cas d'erreur
+                    bvh_murs        l'arbre des murs (NULL pour tracer tous les murs)
+    Retour:         le nombre de segments tracs ou -1 en cas d'erreur (ou de mmoire insuffisante)
     Ex. d'utilisation:
-                    afficher_mur(tab_segments,10,100);   // affiche les 10 premier segments d'un tableau
-                                                        // qui peut en contenir jusqu'a 100
+                    afficher_murs(niv.tab_murs,10,100,NULL);  // affiche les 10 premier segments d'un tableau
+                                                             // qui peut en contenir jusqu'a 100
 */
-int afficher_murs(int tab_segments[][COL_TABSEG],int nb_segments,int max_segments){
+int afficher_murs(t_segment_compile tab_murs[],int nb_segments,int max_segments,t_bvh* bvh_murs){
 
     int i;          // itrateur pour la boucle de parcours du tableau de segments
+    int mur;        // indice du mur  tracer
+    int nb_visibles;                // nb de murs qui touchent la fentre
     int retour=0;   // valeur de retour
 
     // slectionner la bonne couleur pour le dessin des murs
@@ -628,532 +915,53 @@ int afficher_murs(int tab_segments[][COL_TABSEG],int nb_segments,int max_segment
 
 	if (nb_segments > max_segments) // si le nombre de segments  dessiner dpasse le maximum permis la valeur de retour est -1
 	{
-		retour = -1;
+		return -1;
 	}
-
-	else						//sinon tracer les segments l'un aprs l'autre  et la valeur de retour est le nombre de segments.
-	{
-		for (i = 0; i < nb_segments; i++)
-		{
-			int j = 0;
-			for (j = 0; j < COL_TABSEG; j++)
-			{
-				graph_trace_segment(tab_segments[i][X0], tab_segments[i][Y0], tab_segments[i][X1], tab_segments[i][Y1]);
-				
-			}
-		}
-
-		retour = nb_segments;
-	}
-    // renvoyer le nombre de segments tracs ou -1 en cas d'erreur
-    
-
-	return retour;
-}
-
-// ---------------------------------------------
-/* fonction: cible_atteinte
-    Description:    Teste si la cible est atteinte par le projectile
-    Paramtre(s):   tab_projectile  tableau d'information du projectile
-                    tab_cible       tableau d'info sur la cible
-    Retour:         1 si la cible est touche, 0 sinon
-    Ex. d'utilisation:
-                    cible_atteinte(tabp,tabc);  // teste si la cible dcrite par le tableau tabc est
-                                                // touche par le projectile dcrit par le tableau tabp
-*/
-int cible_atteinte(double tab_projectile[][COL_TABPRO],int tab_cible[]){
-    
-	//si le projectile atteint la cible retourner 1, sinon retour 0.
-	if (tab_projectile[POSITION][X1] >= tab_cible[X0] && tab_projectile[POSITION][X1] <= tab_cible[X1] && tab_projectile[POSITION][Y1] <= tab_cible[Y1] && tab_projectile[POSITION][Y1] >= tab_cible[Y0])
-	{
-		return 1;
-	}
-
-	else
+	if (nb_segments <= 0)
 	{
 		return 0;
 	}
-}
-
-
-// ---------------------------------------------
-/* fonction: mise_a_jour_rebond
-    Description:    Mets--jour la  position et vitesse du projectile en tenant selon des
-                    ventuels rebonds.
-                    Analyse le dernier segment de trajectoire correspondant au dplacement depuis
-                    l'ancienne position (x0,y0) jusqu' la nouvelle (x1,y1) en 4 tapes:
-                    1-Dterminer le premier mur crois par le segment de trajectoire
-                    2-Calculer la distance du dernier segment et celle jusqu'au rebond (d,drf)
-                    3-Fixer la nouvelle position au point d'impact (x1,y1)
-                    4-Dterminer le temps, et la vitesse au moment de l'impact (t,dt,vx1,vy1)
-                    5.1-Inverser la vitesse horizontale ou verticale selon l'angle du mur touch
-                    5.2-Replacer le projectile lgrement  ct de la paroi (du bon ct)
-                    6-Rduire la vitesse pour modliser la perte d'nergie due  l'impact
-    Note:           Pour simplifier l'analyse et la mise  jour des rebonds,
-                    la fonction suppose:
-                    1-que seuls des murs horizontaux ou verticaux existent (pas de diagonale) De plus,
-                    2-que la taille du projectile est nulle. Le rebond  donc lieu quand
-                        le milieu du projectile touche la paroi. Cette simplification
-                        enlve un peu de ralisme  la simulation puisque le projectile entre
-                        un peu dans la paroi avant de rebondir.
-    Paramtre(s):   tab_segments    tableau d'informations des segments de murs
-                    nb_segments     nombre de segments de mur
-                    tab_projectile  tableau d'information du projectile
-                    t               adresse de la variable de temps pour pouvoir la modifier
-                    dt              deltat, increment de temps de la simulation
-    Retour:         Aucun. Les nouvelles valeurs calcules sont places dans le tableau
-                    tab_projectile et le temps (t) et son incrment (dt) peuvent
-                    tre modifis par la fonction
-    Ex. d'utilisation:
-                    // mettre a jour la position du projectile en fonction d'un ventuel rebond
-                    mise_a_jour_rebond(tab_segments,nb_segments,
-                                       tab_projectile,&t,&dt);
-*/
-void mise_a_jour_rebond(int tab_segments[][COL_TABSEG],int nb_segments,
-                        double tab_projectile[][COL_TABPRO],
-                        double *t,double *dt)
-{
-    double xr,yr,xrf,yrf; // point d'intersection (impact) intermdiaire, et final
-    double d,dr,drf;    // distance parcourue, distance au rebond, distance au rebond final
-    int segf=-1;        // segment ou le rebond a finalement lieu
-    int i;
-	double a, b, c;
-
-    // 1-dterminer le premier segment crois pendant le dernier segment de trajectoire
-    // mmoriser son index (segf),
-    // la position de l'impact qui est le point d'intersection (xrf,yrf),
-    // et la distance entre l'impact et la position prcdente (drf)
-    
-
-	for (i = 0; i < nb_segments && segf < 0; i++)
+	if (!reserver_murs_affiches(nb_segments))
 	{
-		/*intersection_segments(double ax1, double ay1, double bx1, double by1, double ax2, double ay2, double bx2, double by2, double* x, double* y*/
-		/*equation_droite(double x1, double y1, double x2, double y2, double* a, double* b, double* c)*/
-
-		if (intersection_segments(tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], tab_projectile[POSITION][X1], tab_projectile[POSITION][Y1], tab_segments[i][X0], tab_segments[i][Y0], tab_segments[i][X1], tab_segments[i][Y1], &xrf, &yrf))
-		{
-			segf = i;
-			equation_droite(tab_segments[i][X0], tab_segments[i][Y0], tab_segments[i][X1], tab_segments[i][Y1], &a, &b, &c);
-			drf = longueur(tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], xrf, yrf);
-			printf("TOUCHER");
-		}
+		retour = -1;
 	}
 
-
-
-    // s'il y a rebond, ajuster la position, la vitesse du projectile, et le temps
-    // pour correspondre aux valeurs qu'elle aurait du prendre suite  l'impact
-    if(segf>=0)
+	else						//sinon tracer les segments l'un aprs l'autre  et la valeur de retour est le nombre de segments.
 	{
-
-        // 2-calculer la distance parcourue (d) entre la position prcdente
-        // et la position actuelle du projectile (en ignorant le rebond)
-        
-		d = longueur(tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], tab_projectile[POSITION][X1], tab_projectile[POSITION][Y1]);
-
-
-        // 3-fixer la nouvelle position du projectile au point d'impact du rebond (xrf,yrf)
-        
-
-		tab_projectile[POSITION][X1] = xrf;
-		tab_projectile[POSITION][Y1] = yrf;
-
-        // 4.1-corriger le temps pour qu'il corresponde au moment de l'impact en utilisant le rapport de distance
-        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
-        
-		*t = *t - *dt + (drf / d ) * *dt;
-
-        // 4.2-ajuster le pas de temps pour qu'il corresponde  l'incrment qui mne  l'impact
-        // en utilisant le rapport de distance
-        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
-        // (cet ajustement est utile uniquement pour le ralisme de la simulation avec les delais)
-        
-		*dt *= (drf / d);
-
-        // 4.3-recalculer la vitesse au moment de l'impact par interpolation
-        // en utilisant le rapport de distance
-        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
-        		
-		tab_projectile[VITESSE][X1] = (tab_projectile[VITESSE][X0]) + (tab_projectile[VITESSE][X1] - tab_projectile[VITESSE][X0]) * (drf / d);
-		tab_projectile[VITESSE][Y1] = (tab_projectile[VITESSE][Y0]) + (tab_projectile[VITESSE][Y1] - tab_projectile[VITESSE][Y0]) * (drf / d);
-
-        // 5.1-inverser la vitesse horizontale/verticale selon la paroi
-        // rencontre (vertical/horizontale)
-        
-		if (c == 0)
-		{
-			tab_projectile[VITESSE][X1] *= -1;
-		}
-
-		if (c == 1)
+		// ne garder que les murs qui touchent la fentre (tous les murs sans arbre des murs)
+		if (bvh_murs != NULL)
 		{
-			tab_projectile[VITESSE][Y1] *= -1;
+			nb_visibles = bvh_murs_dans_rectangle(bvh_murs, tab_murs, 0, 0, LARGEUR_FEN - 1, HAUTEUR_FEN - 1,
+												  tab_visibles, nb_segments);
 		}
-
-
-        // 5.2-replacer le projectile lgrement du bon ct de la paroi (DECALAGE_REBOND)
-        
-		if (c == 0)
+		else
 		{
-			if (tab_projectile[POSITION][X0] <= xrf)
+			nb_visibles = 0;
+			for (i = 0; i < nb_segments; i++)
 			{
-				tab_projectile[POSITION][X1] -= DECALAGE_REBOND;
-			}
-			 if (tab_projectile[POSITION][X0] >= xrf)
-			{
-				tab_projectile[POSITION][X1] += DECALAGE_REBOND;
+				if (tab_murs[i].x_max >= 0 && tab_murs[i].x_min <= LARGEUR_FEN - 1 &&
+					tab_murs[i].y_max >= 0 && tab_murs[i].y_min <= HAUTEUR_FEN - 1) tab_visibles[nb_visibles++] = i;
 			}
 		}
 
-		if (c == 1)
+		// rassembler les murs visibles pour les tracer tous en un seul lot
+		// (les extrmits compiles sont les coordonnes entires du fichier)
+		for (i = 0; i < nb_visibles; i++)
 		{
-			if (tab_projectile[POSITION][Y0] <= yrf)
-			{
-				tab_projectile[POSITION][Y1] -= DECALAGE_REBOND;
-			}
-			else if (tab_projectile[POSITION][Y0] >= yrf)
-			{
-				tab_projectile[POSITION][Y1] += DECALAGE_REBOND;
-			}
+			mur = tab_visibles[i];
+			tab_traces[i][X0] = (int)tab_murs[mur].ax;
+			tab_traces[i][Y0] = (int)tab_murs[mur].ay;
+			tab_traces[i][X1] = (int)tab_murs[mur].bx;
+			tab_traces[i][Y1] = (int)tab_murs[mur].by;
 		}
+		graph_trace_segments(tab_traces, nb_visibles);
 
-        // 6-rduire la vitesse aprs le rebond selon le coefficient de
-        // restitution de la paroi (C_RESTITUTION)
-        
-		tab_projectile[VITESSE][X1] *= C_RESTITUTION;
-
-		tab_projectile[VITESSE][Y1] *= C_RESTITUTION;
-
-        //printf(" rebond x=%lf y=%lf vx=%lf vy=%lf dt=%lf\n",*x,*y,*vx,*vy, *dt);
-    }
-}
-// ---------------------------------------------
-/* fonction: mise_a_jour_ballistique
-    Description:     partir de la position et de la vitesse prcdente du projectile, calcule
-                    la nouvelle position et la nouvelle vitesse du projectile en 4 tapes:
-                    1-sauvegarder l'ancienne position/vitesse dans x0,y0,vx0,vy0
-                    2-effet du frottement de l'air: la vitesse horizontale et la vitesse verticale
-                        diminue  cause du frottement de l'air: vx1=vx0-vx0^2*cf/masse*deltat
-                                                                vy1=vy0-vy0^2*cf/masse*deltat
-                        o cf est le coefficient de frottement de l'air.
-                    3-effet de la gravit: la vitesse horizontale n'est pas affecte mais la vitesse
-                        verticale est modifie: vy1=vy1-g*deltat
-                    4-la nouvelle position est obtenue avec la nouvelle vitesse et l'ancienne position
-                        x1=x0+vx*deltat
-                        y1=y0+vy*deltat
-    Note:           Les murs sont compltement ignors par cette fonction. Attention,
-                    l'effet du frottement est toujours oppos  la vitesse, il est donc positif pour
-                    une vitesse ngative et ngatif quand la vitesse est positive.
-    Paramtre(s):   tab_projectile  tableau d'information du projectile
-                    t               adresse de la variable de temps pour pouvoir la modifier
-                    dt              deltat, increment de temps de la simulation
-    Retour:         Aucun, les nouvelles valeurs calcules sont places dans le tableau tab_projectile
-                    et le temps est modifi par la fonction
-    Ex. d'utilisation:
-                    calcule_lanceur(100,100,15,tab_lanceur);    // calcule l'extremit du lanceur
-                                                                // pour une position de souris de 100,100
-                                                                // et une vitesse max permise de 15 (m/s)
-*/
-void mise_a_jour_ballistique(double tab_projectile[][COL_TABPRO],double *t,double dt){
-
-    //avant calculer la nouvelle position/vitesse, sauvegarder l'ancienne position dans x0,y0,vx0,vy0
-    
-	tab_projectile[POSITION][X0] = tab_projectile[POSITION][X1];
-	tab_projectile[POSITION][Y0] = tab_projectile[POSITION][Y1];
-
-	tab_projectile[VITESSE][X0] = tab_projectile[VITESSE][X1];
-	tab_projectile[VITESSE][Y0] = tab_projectile[VITESSE][Y1];
-
-    // calcul de la nouvelle vitesse et nouvelle position sans rebond
-	// 1-effet du frottement de l'air sur la vitesse
-    
-	tab_projectile[VITESSE][X1] = (tab_projectile[VITESSE][X0]) - (((C_FROTTEMENT * pow(tab_projectile[VITESSE][X0], 2))) / MASSE) * (dt);
-	tab_projectile[VITESSE][Y1] = (tab_projectile[VITESSE][Y0]) - (((C_FROTTEMENT * pow(tab_projectile[VITESSE][Y0], 2))) / MASSE) * (dt);
-	
-
-	// 2-effet de la gravit sur la vitesse
-    
-	tab_projectile[VITESSE][Y1] = tab_projectile[VITESSE][Y1] - (GRAVITE * (dt));
-
-    // mise  jour de la position
-    
-	tab_projectile[POSITION][X1] = tab_projectile[POSITION][X0] + (tab_projectile[VITESSE][X1] * (dt));
-	tab_projectile[POSITION][Y1] = tab_projectile[POSITION][Y0] + (tab_projectile[VITESSE][Y1] * (dt));
-
-    // mise  jour du temps de la simulation: ajouter dt au temps
-    	
-	*t += dt;
-
-    //printf("info projectile: %lf %lf %lf %lf\n",tab_projectile[POSITION][X1],tab_projectile[POSITION][Y1],tab_projectile[VITESSE][X1],tab_projectile[VITESSE][Y1]);
-
-}
-
-// ---------------------------------------------
-/* fonction: calcule_lanceur
-    Description:    calcule les coordonnes de l'extremit mobile du lanceur
-                    en fonction des coordonnes de la souris et en prenant soin
-                    de limiter la longueur du lanceur selon la vitesse maximale
-                    spcifie.
-    Note:           La longueur du segment du lanceur correspond directement 
-                    la vitesse initiale qui sera donne au projectile. Une vitesse
-                    initiale de 10 est reprsente par un segment de 10 pixels de longueur
-    Paramtre(s):   mousex      coordonne en x de la souris
-                    mousey      coordonne en y de la souris
-                    vmax        vitesse max permise ou longueur max du lanceur
-                    tab_lanceur tableau d'info du lanceur (coordonnes des deux extrmits)
-    Retour:         Aucun, les nouvelles valeurs calcules sont places dans le tableau tab_lanceur
-    Ex. d'utilisation:
-                    calcule_lanceur(100,100,15,tab_lanceur);    // calcule l'extremit du lanceur
-                                                                // pour une position de souris de 100,100
-                                                                // et une vitesse max permise de 15 (m/s)
-*/
-void calcule_lanceur(int mousex,int mousey,int vmax,int tab_lanceur[])
-{
-
-    double l;   // longueur du segment du lanceur
-
-    // placer la fin du lanceur  la position de la souris.
-	tab_lanceur[X1] = mousex;
-	tab_lanceur[Y1] = mousey;
-
-    // calculer la longueur du segment du lanceur (l)
-
-	l = longueur(tab_lanceur[X0], tab_lanceur[Y0], tab_lanceur[X1], tab_lanceur[Y1]);
-
-
-    // si cette longueur dpasse la vitesse maximale (vmax) ajuster
-    // l'extrmit (x1,y1) en utilisant le facteur (vmax/longueur)
-	if (l > vmax)
-	{
-		tab_lanceur[X1] = ((vmax * (mousex - tab_lanceur[X0])) / l) + tab_lanceur[X0];
-		tab_lanceur[Y1] = ((vmax * (mousey - tab_lanceur[Y0])) / l) + tab_lanceur[Y0];
+		retour = nb_visibles;
 	}
-}
-
-// ---------------------------------------------
-/* fonction: affiche_tab2D
-    Description:    affiche le contenu du tableau de segments (tableau d'entier 2D) dans la console
-    Paramtre(s):   tab_segments    le tableau d'info sur les segments de murs
-                    nb_segments     le nombre de segments  tracer  afficher
-    Retour:         aucun
-    Ex. d'utilisation:
-                    affiche_tab2D(tab_segments,10);   // affiche les 10 premier segments de tab_segments
-*/
-
-void affiche_tab2D(int tab_segments[][COL_TABSEG],int nb_segments){
-    int i,j;
-    printf("\n");
-    for (i=0; i<nb_segments; i++){
-        for(j=0;j<COL_TABSEG;j++){
-            printf("%5d",tab_segments[i][j]);
-        }
-        printf("\n");
-    }
-}
-
-
-// ---------------------------------------------
-/* fonction: lire_fichier_niveau
-    Description:    lit un fichier de description de niveau et rempli les tableaux
-                    d'information de segments de mur, de lanceur et de cible
-    Paramtre(s):   niveau      # du niveau
-                    dossier     nom du dossier dans lequel se trouve le fichier de niveau
-                                ex: "dossierNiveaux"
-                    txt_debut_fichier
-                                prfixe du fichier de niveau (ex: "niveau" si le fichier
-                                s'appelle "niveau3.txt"
-                    txt_fin_fichier
-                                suffixe/extension du fichier de niveau (ex: ".txt" si le fichier
-                                s'appelle "niveau3.txt"
-                    tab_seg     tableau  remplir avec les infos de segments de murs
-                    tab_lanceur tableau  remplir avec les infos de position du lanceur
-                    tab_cible   tableau  remplir avec les infos de la cibles
-    Retour:         le nombre de segments de murs lu, ou -1 en cas d'erreur de lecture du fichier
-    Ex. d'utilisation:
-                    // charge le fichier "level/level3.niv" en mettant les information trouves
-                    // dans les tableaux tab_seg,tab_lan,tab_cible
-                    nb=lire_fichier_niveau(3,"niv","level",".niv",tab_seg,tab_lan,tab_cible);
-
-*/
-int lire_fichier_niveau(int niveau, char* dossier, char* txt_debut_fichier, char* txt_fin_fichier,
-                        int tab_seg[][COL_TABSEG],int tab_lanceur[], int tab_cible[])
-{
-
-    int nb_segments=0;          // nombre de segments trouvs
-    char ligne[MAX_CHAR];       // chaine de caractre contenant une ligne du fichier
-    FILE* fp;                   // pointeur au fichier  lire
-    int ns,nsv,nsh;             // nb de segments  lire dans le fichier (vert./hor.)
-    int x1,y1,x2,y2;            // coord. des points lus dans le fichier
-    int idxseg=0;               // index de ligne du tableau de segments
-    char nom_fichier[MAX_CHAR]; // nom du fichier de description du niveau
-
-
-    // creation du nom de fichier
-    sprintf(nom_fichier,"%s/%s%d%s",dossier,DEBUT_NOM_FICHIER_NIVEAU,niveau,FIN_NOM_FICHIER_NIVEAU);
-
-    // ouverture du fichier et vrification du succs de l'ouverture
-    fp = fopen(nom_fichier,"r"); // en mode lecture seulement
-    if( fp == NULL ){
-        nb_segments=-1;
-    }
-    else{
-
-        // ------------- En tte ---------------------------
-        // sauter les deux lignes d'en-tte
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // ------------- Dimension de la zone ---------------
-        // obtenir les dimensions de la zone limite du niveau
-        // et creer les segments du tour de la zone
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture d'un point et identification des 4 champs attendus:
-            //  x1, y1, x2, y2
-            if (sscanf(ligne,"%d,%d,%d,%d",&x1,&y1,&x2,&y2)==4){
-                // ajout des 4 segments de limite de zone dans le tableau des segments
-                tab_seg[idxseg][X0]=x1;tab_seg[idxseg][Y0]=y1;
-                tab_seg[idxseg][X1]=x1;tab_seg[idxseg][Y1]=y2;
-                idxseg++;
-                tab_seg[idxseg][X0]=x1;tab_seg[idxseg][Y0]=y2;
-                tab_seg[idxseg][X1]=x2;tab_seg[idxseg][Y1]=y2;
-                idxseg++;
-                tab_seg[idxseg][X0]=x2;tab_seg[idxseg][Y0]=y2;
-                tab_seg[idxseg][X1]=x2;tab_seg[idxseg][Y1]=y1;
-                idxseg++;
-                tab_seg[idxseg][X0]=x2;tab_seg[idxseg][Y0]=y1;
-                tab_seg[idxseg][X1]=x1;tab_seg[idxseg][Y1]=y1;
-                idxseg++;
-            }
-            else
-                nb_segments=-1;
-        }
-
-        // ------------- Segments verticaux --------------
-        // sauter l'en tte des nb de segments verticaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // obtenir le nombre de void graph_select_couleur(int r, int g, int b, int a)segments verticaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture du nombre:
-            if (sscanf(ligne,"%d",&nsv)!=1) {
-                nsv=-1;
-                nb_segments=-1;
-            }
-        }
-        // sauter l'en tte des coordonnes de segments verticaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // boucle pour obtenir les coordonnes des segments verticaux (un par ligne)
-        ns=0;
-        while((ns<nsv)){
-            // lecture d'un segment et identification des 4 champs attendus:
-            //  x1, y1, x2, y2
-            if (fgets(ligne,MAX_CHAR-1,fp)!=NULL)
-                if (sscanf(ligne,"%d,%d,%d,%d",&x1,&y1,&x2,&y2)==4){
-                    // ajout du segment dans le tableau des segments
-                    tab_seg[idxseg][X0]=x1;tab_seg[idxseg][Y0]=y1;
-                    tab_seg[idxseg][X1]=x2;tab_seg[idxseg][Y1]=y2;
-                    idxseg++;
-                    ns++;
-                }
-                else nb_segments=-1;
-            else nb_segments=-1;
-
-        }
-
-        // ------------- Segments horizontaux --------------
-        // sauter l'en tte des nb de segments horizontaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // obtenir le nombre de segments horizontaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture du nombre:
-            if (sscanf(ligne,"%d",&nsh)!=1) {
-                nsh=-1;
-                nb_segments=-1;
-            }
-        }
-        // sauter l'en tte des coordonnes de segments horizontaux
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // boucle pour obtenir les coordonnes des segments horizontaux (un par ligne)
-        ns=0;
-        while((ns<nsh)){
-            // lecture d'un segment et identification des 4 champs attendus:
-            //  x1, y1, x2, y2
-            if (fgets(ligne,MAX_CHAR-1,fp)!=NULL)
-                if (sscanf(ligne,"%d,%d,%d,%d",&x1,&y1,&x2,&y2)==4){
-                    // ajout du segment dans le tableau des segments
-                    tab_seg[idxseg][X0]=x1;tab_seg[idxseg][Y0]=y1;
-                    tab_seg[idxseg][X1]=x2;tab_seg[idxseg][Y1]=y2;
-                    idxseg++;
-                    ns++;
-                }
-                else nb_segments=-1;
-            else nb_segments=-1;
-
-        }
-
-        // ------------- Position du lanceur --------------
-        // sauter l'en tte de position du lanceur
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // obtenir la position du lanceur
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture du nombre:
-            if (sscanf(ligne,"%d,%d",&tab_lanceur[X0],&tab_lanceur[Y0])!=2) {
-                nb_segments=-1;
-            }
-            else{
-                tab_lanceur[X1]=tab_lanceur[X0];
-                tab_lanceur[Y1]=tab_lanceur[Y0];
-            }
-        }
-
-        // ------------- Position de la cible --------------
-        // sauter l'en tte de position de la cible
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // obtenir la position de la cible (point inferieur gauche)
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture du nombre:
-            if (sscanf(ligne,"%d,%d",&tab_cible[X0],&tab_cible[Y0])!=2) {
-                nb_segments=-1;
-            }
-            else{
-                tab_cible[X1]=tab_cible[X0];
-                tab_cible[Y1]=tab_cible[Y0];
-            }
-        }
-
-        // ------------- Taille de la cible --------------
-        // sauter l'en tte de la taille de la cible
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        // obtenir la taille de la cible (carr)
-        if (fgets(ligne,MAX_CHAR-1,fp)==NULL) nb_segments=-1;
-        else{
-            // lecture du nombre:
-            if (sscanf(ligne,"%d",&x1)!=1) {
-                nb_segments=-1;
-            }
-            else{
-                tab_cible[X1]=tab_cible[X0]+x1;
-                tab_cible[Y1]=tab_cible[Y0]+x1;
-            }
-        }
-
-        // fermeture du fichier
-        fclose(fp);
-    }
-    // si la lecture du fichier s'est bien passe,
-    // il faut renvoyer le nombre de segments mis en mmoire
-    if (nb_segments!=-1)
-        nb_segments=idxseg;
+    // renvoyer le nombre de segments tracs ou -1 en cas d'erreur
+    
 
-    //renvoi du nb de points trouvs
-    return nb_segments;
+	return retour;
 }
 
 
-
-
-
-
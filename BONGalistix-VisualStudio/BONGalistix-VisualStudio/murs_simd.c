@@ -0,0 +1,329 @@
+// -------------------------------------------
+/*
+librairie murs_simd.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Murs rangs en structure de tableaux et recherche vectorielle du mur
+             le plus proche crois par un segment de trajectoire.
+Note: les prototypes des fonctions se trouvent dans le fichier murs_simd.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "murs_simd.h"
+
+// ---------------------------------------------
+// instructions vectorielles disponibles  la compilation
+// les fonctions SSE2 et AVX2 sont compiles pour leur jeu d'instructions mme si le
+// reste du programme ne l'utilise pas: elles ne sont appeles que si le programme
+// a vrifi que le processeur les supporte (voir choisir_noyau_murs_simd)
+// ---------------------------------------------
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#define MURS_AVEC_SSE2
+#define MURS_AVEC_AVX2
+#define CIBLE_SSE2
+#define CIBLE_AVX2
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MURS_AVEC_SSE2
+#define MURS_AVEC_AVX2
+#define CIBLE_SSE2 __attribute__((target("sse2")))
+#define CIBLE_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define MURS_SIMD_ALIGNEMENT    32      // alignement des tableaux (taille d'un registre AVX)
+
+static int noyau_courant=NOYAU_SCALAIRE;    // noyau utilis par murs_simd_premier_mur
+
+// ---------------------------------------------
+/* fonction: construire_murs_simd
+    Description:    range les murs d'un niveau par coordonne, en rels. Les tableaux
+                    sont complts par des murs dont les coordonnes ne sont pas des
+                    nombres (NAN): toute comparaison avec eux est fausse, ils ne sont
+                    donc jamais croiss.
+    Paramtre(s):   tab_segments    tableau des segments de murs
+                    nb_segments     nombre de segments de murs
+    Retour:         l'adresse des murs rangs, NULL en cas d'erreur
+    Ex. d'utilisation:
+                    niv->murs_simd=construire_murs_simd(niv->tab_segments,niv->nb_segments);
+*/
+t_murs_simd* construire_murs_simd(int tab_segments[][COL_TABSEG], int nb_segments)
+{
+    t_murs_simd* murs;
+    uintptr_t adresse;
+    int i;
+
+    if (nb_segments<=0) return NULL;
+    murs=(t_murs_simd*)calloc(1,sizeof(t_murs_simd));
+    if (murs==NULL) return NULL;
+
+    murs->nb_murs=nb_segments;
+    murs->nb_places=(nb_segments+MURS_SIMD_LARGEUR-1)/MURS_SIMD_LARGEUR*MURS_SIMD_LARGEUR;
+    murs->memoire=malloc(4*(size_t)murs->nb_places*sizeof(double)+MURS_SIMD_ALIGNEMENT);
+    if (murs->memoire==NULL){
+        free(murs);
+        return NULL;
+    }
+    adresse=((uintptr_t)murs->memoire+MURS_SIMD_ALIGNEMENT-1)&~(uintptr_t)(MURS_SIMD_ALIGNEMENT-1);
+    murs->tab_ax=(double*)adresse;
+    murs->tab_ay=murs->tab_ax+murs->nb_places;
+    murs->tab_ex=murs->tab_ay+murs->nb_places;
+    murs->tab_ey=murs->tab_ex+murs->nb_places;
+
+    for (i=0;i<murs->nb_places;i++){
+        if (i<nb_segments) murs_simd_modifier_mur(murs,i,tab_segments[i]);
+        else murs->tab_ax[i]=murs->tab_ay[i]=murs->tab_ex[i]=murs->tab_ey[i]=NAN;
+    }
+    return murs;
+}
+
+// ---------------------------------------------
+/* fonction: murs_simd_modifier_mur
+    Description:    remplace les coordonnes d'un mur (ex: niveau modifi pendant la partie)
+    Paramtre(s):   murs    murs rangs par coordonne
+                    mur     indice du mur (moins que murs->nb_murs)
+                    seg     nouveau segment du mur
+    Retour:         aucun
+*/
+void murs_simd_modifier_mur(t_murs_simd* murs, int mur, int seg[COL_TABSEG])
+{
+    murs->tab_ax[mur]=seg[X0];
+    murs->tab_ay[mur]=seg[Y0];
+    murs->tab_ex[mur]=seg[X1]-seg[X0];
+    murs->tab_ey[mur]=seg[Y1]-seg[Y0];
+}
+
+// ---------------------------------------------
+/* fonction: liberer_murs_simd
+    Description:    libre la mmoire des murs rangs par coordonne
+    Paramtre(s):   murs    murs  librer (NULL accept)
+    Retour:         aucun
+*/
+void liberer_murs_simd(t_murs_simd* murs)
+{
+    if (murs==NULL) return;
+    free(murs->memoire);
+    free(murs);
+}
+
+// ---------------------------------------------
+/* fonction: noyau_murs_simd_disponible
+    Description:    indique si un noyau a t compil dans le programme (cela ne garantit
+                    pas que le processeur supporte ses instructions)
+    Paramtre(s):   noyau   NOYAU_SCALAIRE, NOYAU_SSE2 ou NOYAU_AVX2
+    Retour:         1 si le noyau est disponible, 0 sinon
+*/
+int noyau_murs_simd_disponible(int noyau)
+{
+    if (noyau==NOYAU_SCALAIRE) return 1;
+#ifdef MURS_AVEC_SSE2
+    if (noyau==NOYAU_SSE2) return 1;
+#endif
+#ifdef MURS_AVEC_AVX2
+    if (noyau==NOYAU_AVX2) return 1;
+#endif
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: choisir_noyau_murs_simd
+    Description:    choisit le noyau utilis par murs_simd_premier_mur. Le programme doit
+                    d'abord vrifier que le processeur supporte les instructions du noyau
+                    (ex: SDL_HasAVX2). Le choix vaut pour tous les fils d'excution et doit
+                    tre fait avant de lancer les simulations.
+    Paramtre(s):   noyau   NOYAU_SCALAIRE, NOYAU_SSE2 ou NOYAU_AVX2
+    Retour:         1 si le noyau est choisi, 0 s'il n'est pas disponible (le noyau
+                    courant est alors conserv)
+    Ex. d'utilisation:
+                    if (SDL_HasAVX2()) choisir_noyau_murs_simd(NOYAU_AVX2);
+*/
+int choisir_noyau_murs_simd(int noyau)
+{
+    if (!noyau_murs_simd_disponible(noyau)) return 0;
+    noyau_courant=noyau;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: noyau_murs_simd
+    Description:    noyau utilis par murs_simd_premier_mur
+    Paramtre(s):   aucun
+    Retour:         NOYAU_SCALAIRE, NOYAU_SSE2 ou NOYAU_AVX2
+*/
+int noyau_murs_simd()
+{
+    return noyau_courant;
+}
+
+// ---------------------------------------------
+/* fonction: premier_mur_scalaire
+    Description:    recherche du mur le plus proche, un mur  la fois.
+                    Pour la trajectoire P+s.D et le mur A+u.E, avec W=A-P:
+                    s=(W x E)/(D x E) et u=(W x D)/(D x E) (x: produit vectoriel 2D).
+                    Le mur est crois si s et u sont entre 0 et 1. Pour des segments
+                    parallles, D x E est nul: s et u sont infinis ou indfinis et les
+                    comparaisons sont fausses.
+    Paramtre(s):   murs        murs rangs par coordonne
+                    x0,y0       dbut du segment de trajectoire
+                    dx,dy       dplacement du segment de trajectoire
+                    s_min       adresse o placer la fraction du segment parcourue  l'impact
+    Retour:         l'indice du mur crois le plus proche, -1 si aucun mur n'est crois
+*/
+static int premier_mur_scalaire(t_murs_simd* murs, double x0, double y0, double dx, double dy,
+                                double* s_min)
+{
+    double wx,wy,d,s,u,s_mur=HUGE_VAL;
+    int i,mur=-1;
+
+    for (i=0;i<murs->nb_murs;i++){
+        wx=murs->tab_ax[i]-x0;
+        wy=murs->tab_ay[i]-y0;
+        d=dx*murs->tab_ey[i]-dy*murs->tab_ex[i];
+        s=(wx*murs->tab_ey[i]-wy*murs->tab_ex[i])/d;
+        u=(wx*dy-wy*dx)/d;
+        if (s>=0 && s<=1 && u>=0 && u<=1 && s<s_mur){
+            s_mur=s;
+            mur=i;
+        }
+    }
+    *s_min=s_mur;
+    return mur;
+}
+
+// ---------------------------------------------
+/* fonction: choisir_voie
+    Description:    rduit les rsultats des voies d'un registre: la voie dont l'impact
+                    est le plus proche est choisie, et en cas d'galit celle du mur de
+                    plus petit indice (comme pour un test des murs dans l'ordre)
+    Paramtre(s):   tab_s       fraction parcourue  l'impact de chaque voie
+                    tab_murs    indice du mur de chaque voie (-1 si aucun)
+                    nb_voies    nb de voies
+                    s_min       adresse o placer la fraction parcourue  l'impact choisi
+    Retour:         l'indice du mur choisi, -1 si aucun mur n'est crois
+*/
+static int choisir_voie(double tab_s[], double tab_murs[], int nb_voies, double* s_min)
+{
+    double s_mur=HUGE_VAL;
+    int i,mur=-1;
+
+    for (i=0;i<nb_voies;i++){
+        if (tab_murs[i]<0) continue;
+        if (tab_s[i]<s_mur || (tab_s[i]==s_mur && (int)tab_murs[i]<mur)){
+            s_mur=tab_s[i];
+            mur=(int)tab_murs[i];
+        }
+    }
+    *s_min=s_mur;
+    return mur;
+}
+
+#ifdef MURS_AVEC_SSE2
+// ---------------------------------------------
+/* fonction: premier_mur_sse2
+    Description:    mme calcul que premier_mur_scalaire, 2 murs  la fois. Chaque voie
+                    garde son meilleur impact et l'indice du mur correspondant, les voies
+                    sont rduites  la fin.
+    Paramtre(s):   voir premier_mur_scalaire
+    Retour:         voir premier_mur_scalaire
+*/
+CIBLE_SSE2 static int premier_mur_sse2(t_murs_simd* murs, double x0, double y0, double dx, double dy,
+                                       double* s_min)
+{
+    __m128d v_x0=_mm_set1_pd(x0),v_y0=_mm_set1_pd(y0);
+    __m128d v_dx=_mm_set1_pd(dx),v_dy=_mm_set1_pd(dy);
+    __m128d v_zero=_mm_setzero_pd(),v_un=_mm_set1_pd(1.0);
+    __m128d v_s_mur=_mm_set1_pd(HUGE_VAL),v_mur=_mm_set1_pd(-1.0);
+    __m128d v_indice=_mm_set_pd(1.0,0.0),v_pas=_mm_set1_pd(2.0);
+    __m128d wx,wy,ex,ey,d,s,u,croise;
+    double tab_s[2],tab_murs[2];
+    int i;
+
+    for (i=0;i<murs->nb_places;i+=2){
+        ex=_mm_load_pd(murs->tab_ex+i);
+        ey=_mm_load_pd(murs->tab_ey+i);
+        wx=_mm_sub_pd(_mm_load_pd(murs->tab_ax+i),v_x0);
+        wy=_mm_sub_pd(_mm_load_pd(murs->tab_ay+i),v_y0);
+        d=_mm_sub_pd(_mm_mul_pd(v_dx,ey),_mm_mul_pd(v_dy,ex));
+        s=_mm_div_pd(_mm_sub_pd(_mm_mul_pd(wx,ey),_mm_mul_pd(wy,ex)),d);
+        u=_mm_div_pd(_mm_sub_pd(_mm_mul_pd(wx,v_dy),_mm_mul_pd(wy,v_dx)),d);
+        croise=_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(s,v_zero),_mm_cmple_pd(s,v_un)),
+                          _mm_and_pd(_mm_cmpge_pd(u,v_zero),_mm_cmple_pd(u,v_un)));
+        croise=_mm_and_pd(croise,_mm_cmplt_pd(s,v_s_mur));
+        v_s_mur=_mm_or_pd(_mm_and_pd(croise,s),_mm_andnot_pd(croise,v_s_mur));
+        v_mur=_mm_or_pd(_mm_and_pd(croise,v_indice),_mm_andnot_pd(croise,v_mur));
+        v_indice=_mm_add_pd(v_indice,v_pas);
+    }
+    _mm_storeu_pd(tab_s,v_s_mur);
+    _mm_storeu_pd(tab_murs,v_mur);
+    return choisir_voie(tab_s,tab_murs,2,s_min);
+}
+#endif
+
+#ifdef MURS_AVEC_AVX2
+// ---------------------------------------------
+/* fonction: premier_mur_avx2
+    Description:    mme calcul que premier_mur_scalaire, 4 murs  la fois
+    Paramtre(s):   voir premier_mur_scalaire
+    Retour:         voir premier_mur_scalaire
+*/
+CIBLE_AVX2 static int premier_mur_avx2(t_murs_simd* murs, double x0, double y0, double dx, double dy,
+                                       double* s_min)
+{
+    __m256d v_x0=_mm256_set1_pd(x0),v_y0=_mm256_set1_pd(y0);
+    __m256d v_dx=_mm256_set1_pd(dx),v_dy=_mm256_set1_pd(dy);
+    __m256d v_zero=_mm256_setzero_pd(),v_un=_mm256_set1_pd(1.0);
+    __m256d v_s_mur=_mm256_set1_pd(HUGE_VAL),v_mur=_mm256_set1_pd(-1.0);
+    __m256d v_indice=_mm256_set_pd(3.0,2.0,1.0,0.0),v_pas=_mm256_set1_pd(4.0);
+    __m256d wx,wy,ex,ey,d,s,u,croise;
+    double tab_s[4],tab_murs[4];
+    int i;
+
+    for (i=0;i<murs->nb_places;i+=4){
+        ex=_mm256_load_pd(murs->tab_ex+i);
+        ey=_mm256_load_pd(murs->tab_ey+i);
+        wx=_mm256_sub_pd(_mm256_load_pd(murs->tab_ax+i),v_x0);
+        wy=_mm256_sub_pd(_mm256_load_pd(murs->tab_ay+i),v_y0);
+        d=_mm256_sub_pd(_mm256_mul_pd(v_dx,ey),_mm256_mul_pd(v_dy,ex));
+        s=_mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(wx,ey),_mm256_mul_pd(wy,ex)),d);
+        u=_mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(wx,v_dy),_mm256_mul_pd(wy,v_dx)),d);
+        croise=_mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(s,v_zero,_CMP_GE_OQ),_mm256_cmp_pd(s,v_un,_CMP_LE_OQ)),
+                             _mm256_and_pd(_mm256_cmp_pd(u,v_zero,_CMP_GE_OQ),_mm256_cmp_pd(u,v_un,_CMP_LE_OQ)));
+        croise=_mm256_and_pd(croise,_mm256_cmp_pd(s,v_s_mur,_CMP_LT_OQ));
+        v_s_mur=_mm256_blendv_pd(v_s_mur,s,croise);
+        v_mur=_mm256_blendv_pd(v_mur,v_indice,croise);
+        v_indice=_mm256_add_pd(v_indice,v_pas);
+    }
+    _mm256_storeu_pd(tab_s,v_s_mur);
+    _mm256_storeu_pd(tab_murs,v_mur);
+    return choisir_voie(tab_s,tab_murs,4,s_min);
+}
+#endif
+
+// ---------------------------------------------
+/* fonction: murs_simd_premier_mur
+    Description:    trouve le mur le plus proche crois par le segment de trajectoire
+                    (x0,y0)-(x1,y1) avec le noyau choisi. En cas d'galit (coin entre
+                    deux murs), le mur de plus petit indice est choisi.
+    Paramtre(s):   murs    murs rangs par coordonne
+                    x0,y0   position de dpart du segment de trajectoire
+                    x1,y1   position d'arrive du segment de trajectoire
+                    s       adresse o placer la fraction du segment parcourue  l'impact
+                            (le point d'impact est (x0+s.(x1-x0),y0+s.(y1-y0)))
+    Retour:         l'indice du mur crois, -1 si aucun mur n'est crois
+    Ex. d'utilisation:
+                    mur=murs_simd_premier_mur(niv->murs_simd,x0,y0,x1,y1,&s);
+*/
+int murs_simd_premier_mur(t_murs_simd* murs, double x0, double y0, double x1, double y1, double* s)
+{
+#ifdef MURS_AVEC_AVX2
+    if (noyau_courant==NOYAU_AVX2) return premier_mur_avx2(murs,x0,y0,x1-x0,y1-y0,s);
+#endif
+#ifdef MURS_AVEC_SSE2
+    if (noyau_courant==NOYAU_SSE2) return premier_mur_sse2(murs,x0,y0,x1-x0,y1-y0,s);
+#endif
+    return premier_mur_scalaire(murs,x0,y0,x1-x0,y1-y0,s);
+}
@@ -0,0 +1,64 @@
+#ifndef MURS_SIMD_H
+#define MURS_SIMD_H
+
+// -------------------------------------------
+/*
+librairie murs_simd.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Murs d'un niveau rangs en structure de tableaux (un tableau de rels
+             par coordonne) et recherche du mur le plus proche crois par un segment
+             de trajectoire en testant plusieurs murs  la fois avec les instructions
+             vectorielles du processeur (SSE2: 2 murs, AVX2: 4 murs par instruction).
+             Le test est le mme pour tous les murs, sans branchement: les deux
+             paramtres du point de croisement (sur la trajectoire et sur le mur) sont
+             calculs par produits vectoriels et compars  l'intervalle [0,1].
+             Une version scalaire est toujours disponible. Le noyau utilis est choisi
+             par le programme (voir choisir_noyau_murs_simd) puisque cette librairie
+             n'utilise pas SDL pour dtecter les instructions disponibles.
+Note: les implmentations des fonctions se trouvent dans le fichier murs_simd.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// noyaux de calcul
+// ---------------------------------------------
+#define NOYAU_SCALAIRE      0       // un mur  la fois, sans instruction vectorielle
+#define NOYAU_SSE2          1       // 2 murs par instruction (registres de 128 bits)
+#define NOYAU_AVX2          2       // 4 murs par instruction (registres de 256 bits)
+
+#define MURS_SIMD_LARGEUR   4       // les tableaux sont complts  un multiple de ce nb de murs
+
+// ---------------------------------------------
+// murs rangs par coordonne
+// le mur i va de (tab_ax[i],tab_ay[i])  (tab_ax[i]+tab_ex[i],tab_ay[i]+tab_ey[i])
+// les murs de remplissage (aprs nb_murs) ne sont jamais croiss
+// ---------------------------------------------
+typedef struct s_murs_simd {
+    int nb_murs;            // nb de murs
+    int nb_places;          // nb de murs allous (multiple de MURS_SIMD_LARGEUR)
+    double* tab_ax;         // abscisse de la premire extrmit de chaque mur
+    double* tab_ay;         // ordonne de la premire extrmit de chaque mur
+    double* tab_ex;         // dplacement en x de la premire  la deuxime extrmit
+    double* tab_ey;         // dplacement en y de la premire  la deuxime extrmit
+    void* memoire;          // bloc allou contenant les 4 tableaux (aligns sur 32 octets), NULL si
+                            // les tableaux appartiennent au paquet de niveaux (voir paquet_niveaux.h)
+} t_murs_simd;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+t_murs_simd* construire_murs_simd(int tab_segments[][COL_TABSEG], int nb_segments);
+void liberer_murs_simd(t_murs_simd* murs);
+void murs_simd_modifier_mur(t_murs_simd* murs, int mur, int seg[COL_TABSEG]);
+
+int noyau_murs_simd_disponible(int noyau);
+int choisir_noyau_murs_simd(int noyau);
+int noyau_murs_simd();
+
+int murs_simd_premier_mur(t_murs_simd* murs, double x0, double y0, double x1, double y1, double* s);
+
+#endif // MURS_SIMD_H
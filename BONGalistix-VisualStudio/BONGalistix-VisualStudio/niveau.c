@@ -0,0 +1,775 @@
+// -------------------------------------------
+/*
+librairie niveau.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Chargement des fichiers de description de niveau (murs, lanceur et cible).
+Note: les prototypes des fonctions se trouvent dans le fichier niveau.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "geometrie.h"
+#include "niveau.h"
+#include "grille.h"
+#include "bvh.h"
+#include "murs_simd.h"
+#include "paquet_niveaux.h"
+#include "niveaux_embarques.h"
+
+// ---------------------------------------------
+/* fonction: affiche_tab2D
+    Description:    affiche le contenu du tableau de segments (tableau d'entier 2D) dans la console
+    Paramtre(s):   tab_segments    le tableau d'info sur les segments de murs
+                    nb_segments     le nombre de segments  tracer  afficher
+    Retour:         aucun
+    Ex. d'utilisation:
+                    affiche_tab2D(tab_segments,10);   // affiche les 10 premier segments de tab_segments
+*/
+
+void affiche_tab2D(int tab_segments[][COL_TABSEG],int nb_segments){
+    int i,j;
+    printf("\n");
+    for (i=0; i<nb_segments; i++){
+        for(j=0;j<COL_TABSEG;j++){
+            printf("%5d",tab_segments[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+
+// ---------------------------------------------
+// lecture du texte d'un fichier de niveau
+// ---------------------------------------------
+typedef struct {
+    const char* p;              // prochain caractre  lire
+    const char* fin;            // fin du texte
+    const char* debut_ligne;    // dbut de la ligne en cours
+    int ligne;                  // # de la ligne en cours ( partir de 1)
+    t_erreur_niveau* erreur;    // erreur  remplir (NULL accept)
+} t_lecteur;
+
+// ---------------------------------------------
+/* fonction: erreur_lecture
+    Description:    note une erreur  la position en cours du texte
+    Paramtre(s):   lecteur     position dans le texte
+                    message     description de l'erreur
+    Retour:         0 (pour terminer la lecture: return erreur_lecture(...);)
+*/
+static int erreur_lecture(t_lecteur* lecteur, const char* message)
+{
+    if (lecteur->erreur!=NULL){
+        lecteur->erreur->ligne=lecteur->ligne;
+        lecteur->erreur->colonne=(int)(lecteur->p-lecteur->debut_ligne)+1;
+        strncpy(lecteur->erreur->message,message,MAX_CHAR-1);
+        lecteur->erreur->message[MAX_CHAR-1]='\0';
+    }
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: sauter_ligne
+    Description:    passe au dbut de la ligne suivante (le reste de la ligne en cours est
+                    ignor, comme les lignes d'en-tte du fichier)
+    Paramtre(s):   lecteur     position dans le texte
+    Retour:         1 en cas de succs, 0 si le texte est termin (aucune ligne  sauter)
+*/
+static int sauter_ligne(t_lecteur* lecteur)
+{
+    const char* p;
+
+    if (lecteur->p==lecteur->fin) return erreur_lecture(lecteur,"fin de fichier inattendue");
+    p=(const char*)memchr(lecteur->p,'\n',lecteur->fin-lecteur->p);
+    lecteur->p=(p==NULL)?lecteur->fin:p+1;
+    lecteur->debut_ligne=lecteur->p;
+    lecteur->ligne++;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: lire_entier
+    Description:    lit un nombre entier (signe facultatif) aprs d'ventuels espaces
+    Paramtre(s):   lecteur     position dans le texte (avance aprs le nombre)
+                    valeur      adresse o placer le nombre lu
+    Retour:         1 en cas de succs, 0 s'il n'y a pas de nombre ou s'il est trop grand
+*/
+static int lire_entier(t_lecteur* lecteur, int* valeur)
+{
+    const char* p=lecteur->p;
+    long long n=0;
+    int negatif=0;
+    int nb_chiffres=0;
+
+    while (p<lecteur->fin && (*p==' ' || *p=='\t')) p++;
+    lecteur->p=p;
+    if (p<lecteur->fin && (*p=='-' || *p=='+')){
+        negatif=(*p=='-');
+        p++;
+    }
+    if (p==lecteur->fin || *p<'0' || *p>'9') return erreur_lecture(lecteur,"nombre entier attendu");
+    // au plus 10 chiffres: le nombre ne peut pas dpasser n pendant la lecture
+    while (p<lecteur->fin && (unsigned int)(*p-'0')<10 && nb_chiffres<=10){
+        n=n*10+(*p-'0');
+        nb_chiffres++;
+        p++;
+    }
+    if (negatif) n=-n;
+    if (nb_chiffres>10 || n>INT_MAX || n<INT_MIN) return erreur_lecture(lecteur,"nombre entier trop grand");
+    *valeur=(int)n;
+    lecteur->p=p;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: lire_ligne_entiers
+    Description:    lit une ligne de nombres entiers spars par des virgules
+                    (ex: "10,10,389,389") puis passe  la ligne suivante; la suite de
+                    la ligne aprs le dernier nombre est ignore
+    Paramtre(s):   lecteur     position dans le texte
+                    nb          nb d'entiers attendus
+                    tab_valeurs tableau  remplir avec les entiers lus
+    Retour:         1 en cas de succs, 0 en cas d'erreur
+*/
+static int lire_ligne_entiers(t_lecteur* lecteur, int nb, int tab_valeurs[])
+{
+    int i;
+
+    if (lecteur->p==lecteur->fin) return erreur_lecture(lecteur,"fin de fichier inattendue");
+    for (i=0;i<nb;i++){
+        if (i>0){
+            while (lecteur->p<lecteur->fin && (*lecteur->p==' ' || *lecteur->p=='\t')) lecteur->p++;
+            if (lecteur->p==lecteur->fin || *lecteur->p!=',') return erreur_lecture(lecteur,"virgule attendue");
+            lecteur->p++;
+        }
+        if (!lire_entier(lecteur,&tab_valeurs[i])) return 0;
+    }
+    if (lecteur->p<lecteur->fin) sauter_ligne(lecteur);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: ajouter_mur_lu
+    Description:    ajoute un mur  la fin du tableau dynamique d'un niveau lu (la
+                    capacit du tableau est double quand il est plein)
+    Paramtre(s):   lu          niveau lu
+                    x1,y1,x2,y2 extrmits du mur
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation
+*/
+static int ajouter_mur_lu(t_niveau_lu* lu, int x1, int y1, int x2, int y2)
+{
+    if (lu->nb_segments==lu->capacite &&
+        !reserver_niveau_lu(lu,(lu->capacite==0)?NB_SEGMENTS_INITIAL:2*lu->capacite)) return 0;
+    lu->tab_segments[lu->nb_segments][X0]=x1;
+    lu->tab_segments[lu->nb_segments][Y0]=y1;
+    lu->tab_segments[lu->nb_segments][X1]=x2;
+    lu->tab_segments[lu->nb_segments][Y1]=y2;
+    lu->nb_segments++;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: lire_murs
+    Description:    lit une section de murs: une ligne d'en-tte, le nb de murs, une ligne
+                    d'en-tte puis un mur par ligne (x1,y1,x2,y2)
+    Paramtre(s):   lecteur     position dans le texte
+                    lu          niveau lu auquel ajouter les murs
+    Retour:         1 en cas de succs, 0 en cas d'erreur
+*/
+static int lire_murs(t_lecteur* lecteur, t_niveau_lu* lu)
+{
+    int nb,i;
+    int tab_mur[COL_TABSEG];
+
+    if (!sauter_ligne(lecteur)) return 0;
+    if (lecteur->p==lecteur->fin) return erreur_lecture(lecteur,"fin de fichier inattendue");
+    if (!lire_entier(lecteur,&nb)) return 0;
+    if (nb<0) return erreur_lecture(lecteur,"nb de segments negatif");
+    if (!sauter_ligne(lecteur) || !sauter_ligne(lecteur)) return 0;
+    for (i=0;i<nb;i++){
+        if (!lire_ligne_entiers(lecteur,COL_TABSEG,tab_mur)) return 0;
+        if (!ajouter_mur_lu(lu,tab_mur[X0],tab_mur[Y0],tab_mur[X1],tab_mur[Y1])) return erreur_lecture(lecteur,"memoire insuffisante");
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: initialiser_niveau_lu
+    Description:    initialise un niveau lu vide (aucun tableau allou)
+    Paramtre(s):   lu      niveau lu  initialiser
+    Retour:         aucun
+*/
+void initialiser_niveau_lu(t_niveau_lu* lu)
+{
+    lu->tab_segments=NULL;
+    lu->nb_segments=0;
+    lu->capacite=0;
+}
+
+// ---------------------------------------------
+/* fonction: reserver_niveau_lu
+    Description:    agrandit au besoin le tableau de murs d'un niveau lu pour qu'il puisse
+                    contenir capacite murs (les murs dj lus sont gards)
+    Paramtre(s):   lu          niveau lu
+                    capacite    nb de murs que le tableau doit pouvoir contenir
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation (lu est inchang)
+    Ex. d'utilisation:
+                    if (reserver_niveau_lu(&lu,nb)) memcpy(lu.tab_segments,tab_seg,nb*sizeof(tab_seg[0]));
+*/
+int reserver_niveau_lu(t_niveau_lu* lu, int capacite)
+{
+    int (*tab_segments)[COL_TABSEG];
+
+    if (capacite<=lu->capacite) return 1;
+    tab_segments=(int (*)[COL_TABSEG])realloc(lu->tab_segments,capacite*sizeof(*tab_segments));
+    if (tab_segments==NULL) return 0;
+    lu->tab_segments=tab_segments;
+    lu->capacite=capacite;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_niveau_lu
+    Description:    libre le tableau de murs d'un niveau lu (le niveau lu est vide ensuite)
+    Paramtre(s):   lu      niveau lu  librer
+    Retour:         aucun
+*/
+void liberer_niveau_lu(t_niveau_lu* lu)
+{
+    free(lu->tab_segments);
+    initialiser_niveau_lu(lu);
+}
+
+// ---------------------------------------------
+/* fonction: analyser_niveau
+    Description:    dcode le texte complet d'un fichier de niveau, dj en mmoire: les
+                    nombres sont lus directement dans le texte, sans copie ligne par ligne.
+                    Les murs sont placs dans un tableau dynamique (aucune limite de taille,
+                    voir t_niveau_lu); les 4 premiers sont les cts de la zone limite.
+    Paramtre(s):   texte       texte du fichier (pas forcment termin par '\0')
+                    taille      nb de caractres du texte
+                    lu          niveau lu  remplir (initialis avec initialiser_niveau_lu;
+                                son tableau de murs est rutilis)
+                    erreur      adresse o placer la position et la description de la
+                                premire erreur (NULL accept)
+    Retour:         le nombre de segments de murs lus, ou -1 en cas d'erreur
+    Ex. d'utilisation:
+                    nb=analyser_niveau(texte,taille,&lu,&erreur);
+                    if (nb<0) printf("ligne %d, colonne %d: %s\n",erreur.ligne,erreur.colonne,erreur.message);
+*/
+int analyser_niveau(const char* texte, size_t taille, t_niveau_lu* lu, t_erreur_niveau* erreur)
+{
+    t_lecteur lecteur;
+    int tab_zone[COL_TABSEG];   // zone limite (x1,y1,x2,y2)
+    int tab_point[2];           // position du lanceur ou de la cible
+    int cote;                   // taille de la cible
+
+    lecteur.p=lecteur.debut_ligne=texte;
+    lecteur.fin=texte+taille;
+    lecteur.ligne=1;
+    lecteur.erreur=erreur;
+    if (erreur!=NULL){
+        erreur->ligne=erreur->colonne=0;
+        erreur->message[0]='\0';
+    }
+    lu->nb_segments=0;
+
+    // en-tte (2 lignes) puis zone limite: ses 4 cts sont les premiers murs
+    if (!sauter_ligne(&lecteur) || !sauter_ligne(&lecteur)) return -1;
+    if (!lire_ligne_entiers(&lecteur,COL_TABSEG,tab_zone)) return -1;
+    if (!ajouter_mur_lu(lu,tab_zone[X0],tab_zone[Y0],tab_zone[X0],tab_zone[Y1]) ||
+        !ajouter_mur_lu(lu,tab_zone[X0],tab_zone[Y1],tab_zone[X1],tab_zone[Y1]) ||
+        !ajouter_mur_lu(lu,tab_zone[X1],tab_zone[Y1],tab_zone[X1],tab_zone[Y0]) ||
+        !ajouter_mur_lu(lu,tab_zone[X1],tab_zone[Y0],tab_zone[X0],tab_zone[Y0])){
+        erreur_lecture(&lecteur,"memoire insuffisante");
+        return -1;
+    }
+
+    // murs verticaux puis horizontaux
+    if (!lire_murs(&lecteur,lu) || !lire_murs(&lecteur,lu)) return -1;
+
+    // position du lanceur (le bout du lanceur est  la mme position)
+    if (!sauter_ligne(&lecteur) || !lire_ligne_entiers(&lecteur,2,tab_point)) return -1;
+    lu->tab_lanceur[X0]=lu->tab_lanceur[X1]=tab_point[0];
+    lu->tab_lanceur[Y0]=lu->tab_lanceur[Y1]=tab_point[1];
+
+    // coin infrieur gauche et taille de la cible (carre)
+    if (!sauter_ligne(&lecteur) || !lire_ligne_entiers(&lecteur,2,tab_point)) return -1;
+    if (!sauter_ligne(&lecteur) || !lire_ligne_entiers(&lecteur,1,&cote)) return -1;
+    lu->tab_cible[X0]=tab_point[0];
+    lu->tab_cible[Y0]=tab_point[1];
+    lu->tab_cible[X1]=tab_point[0]+cote;
+    lu->tab_cible[Y1]=tab_point[1]+cote;
+
+    return lu->nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: lire_niveau_texte
+    Description:    lit un fichier de niveau d'un seul bloc puis le dcode (voir
+                    analyser_niveau)
+    Paramtre(s):   nom_fichier chemin du fichier de niveau
+                    lu          niveau lu  remplir (voir analyser_niveau)
+                    erreur      adresse o placer la description de l'erreur (NULL accept;
+                                ligne 0 si le fichier ne peut pas tre lu)
+    Retour:         le nombre de segments de murs lus, ou -1 en cas d'erreur
+    Ex. d'utilisation:
+                    nb=lire_niveau_texte("Niveaux/niveau3.txt",&lu,&erreur);
+*/
+int lire_niveau_texte(const char* nom_fichier, t_niveau_lu* lu, t_erreur_niveau* erreur)
+{
+    FILE* fp;
+    char* texte=NULL;
+    long taille=-1;
+    int nb_segments=-1;
+
+    if (erreur!=NULL){
+        erreur->ligne=erreur->colonne=0;
+        strcpy(erreur->message,"lecture du fichier impossible");
+    }
+    // mode binaire: le texte est lu tel quel, les fins de ligne "\r\n" sont traites au dcodage
+    fp=fopen(nom_fichier,"rb");
+    if (fp==NULL) return -1;
+    if (fseek(fp,0,SEEK_END)==0) taille=ftell(fp);
+    if (taille>=0 && fseek(fp,0,SEEK_SET)==0) texte=(char*)malloc(taille>0?taille:1);
+    if (texte!=NULL && fread(texte,1,taille,fp)==(size_t)taille) nb_segments=analyser_niveau(texte,taille,lu,erreur);
+    free(texte);
+    fclose(fp);
+    return nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: lire_fichier_niveau
+    Description:    lit un fichier de description de niveau et rempli le niveau lu avec
+                    les segments de mur, le lanceur et la cible
+    Paramtre(s):   niveau      # du niveau
+                    dossier     nom du dossier dans lequel se trouve le fichier de niveau
+                                ex: "dossierNiveaux"
+                    txt_debut_fichier
+                                prfixe du fichier de niveau (ex: "niveau" si le fichier
+                                s'appelle "niveau3.txt"
+                    txt_fin_fichier
+                                suffixe/extension du fichier de niveau (ex: ".txt" si le fichier
+                                s'appelle "niveau3.txt"
+                    lu          niveau lu  remplir (initialis avec initialiser_niveau_lu;
+                                son tableau de murs est rutilis et agrandi au besoin)
+    Note:           le fichier est dcod par lire_niveau_texte; une erreur de format est
+                    affiche avec sa ligne et sa colonne. Le nb de murs n'est pas limit.
+    Retour:         le nombre de segments de murs lu, ou -1 en cas d'erreur de lecture du fichier
+    Ex. d'utilisation:
+                    // charge le fichier "level/level3.niv" dans le niveau lu
+                    nb=lire_fichier_niveau(3,"niv","level",".niv",&lu);
+
+*/
+int lire_fichier_niveau(int niveau, char* dossier, char* txt_debut_fichier, char* txt_fin_fichier,
+                        t_niveau_lu* lu)
+{
+    char nom_fichier[MAX_CHAR]; // nom du fichier de description du niveau
+    t_erreur_niveau erreur;     // position et description d'une erreur de lecture
+    int nb_segments;            // nombre de segments trouvs
+
+    // creation du nom de fichier
+    sprintf(nom_fichier,"%s/%s%d%s",dossier,txt_debut_fichier,niveau,txt_fin_fichier);
+
+    // lecture et dcodage du fichier complet
+    nb_segments=lire_niveau_texte(nom_fichier,lu,&erreur);
+    if (nb_segments<0 && erreur.ligne>0){
+        printf("[ERR] - %s, ligne %d, colonne %d: %s\n",nom_fichier,erreur.ligne,erreur.colonne,erreur.message);
+    }
+
+    //renvoi du nb de segments trouvs
+    return nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: initialiser_niveau
+    Description:    initialise une structure de niveau vide (sans murs ni donnes calcules).
+                    Doit tre appele une fois avant le premier chargement du niveau.
+                    L'index spatial des murs est INDEX_MURS_DEFAUT; il peut tre chang
+                    avant le chargement (champ index_murs).
+    Paramtre(s):   niv     adresse de la structure de niveau
+    Retour:         aucun
+    Ex. d'utilisation:
+                    initialiser_niveau(&niv);
+*/
+void initialiser_niveau(t_niveau* niv)
+{
+    niv->tab_segments=NULL;
+    niv->tab_murs=NULL;
+    niv->nb_segments=0;
+    niv->capacite=0;
+    niv->index_murs=INDEX_MURS_DEFAUT;
+    niv->grille=NULL;
+    niv->bvh=NULL;
+    niv->murs_simd=NULL;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_index_niveau
+    Description:    libre les donnes calcules au chargement d'un niveau (les murs sont
+                    gards)
+    Paramtre(s):   niv     adresse de la structure de niveau
+    Retour:         aucun
+*/
+static void liberer_index_niveau(t_niveau* niv)
+{
+    liberer_grille(niv->grille);
+    niv->grille=NULL;
+    liberer_bvh(niv->bvh);
+    niv->bvh=NULL;
+    liberer_murs_simd(niv->murs_simd);
+    niv->murs_simd=NULL;
+}
+
+// ---------------------------------------------
+/* fonction: reserver_murs_niveau
+    Description:    agrandit au besoin les tableaux de murs d'un niveau (segments et murs
+                    compils) pour qu'ils puissent contenir capacite murs; les murs dj
+                    prsents sont gards
+    Paramtre(s):   niv         niveau
+                    capacite    nb de murs que les tableaux doivent pouvoir contenir
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation (la capacit est
+                    inchange)
+    Ex. d'utilisation:
+                    if (reserver_murs_niveau(&niv,nb)) memcpy(niv.tab_segments,tab_seg,nb*sizeof(tab_seg[0]));
+*/
+int reserver_murs_niveau(t_niveau* niv, int capacite)
+{
+    int (*tab_segments)[COL_TABSEG];
+    t_segment_compile* tab_murs;
+
+    if (capacite<=niv->capacite) return 1;
+    tab_segments=(int (*)[COL_TABSEG])realloc(niv->tab_segments,capacite*sizeof(*tab_segments));
+    if (tab_segments==NULL) return 0;
+    niv->tab_segments=tab_segments;
+    tab_murs=(t_segment_compile*)realloc(niv->tab_murs,capacite*sizeof(*tab_murs));
+    if (tab_murs==NULL) return 0;
+    niv->tab_murs=tab_murs;
+    niv->capacite=capacite;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: installer_niveau_lu
+    Description:    remplace les murs, le lanceur et la cible d'un niveau par ceux d'un
+                    niveau lu. Le tableau de murs du niveau lu passe au niveau sans tre
+                    recopi (le niveau lu est vide ensuite); seul le tableau des murs
+                    compils est agrandi au besoin. Les donnes calcules ne sont pas
+                    mises  jour (voir preparer_niveau).
+    Paramtre(s):   niv     niveau  remplir (initialis avec initialiser_niveau)
+                    lu      niveau lu  installer
+    Retour:         le nombre de segments de murs, ou -1 en cas d'erreur d'allocation
+                    (niv et lu sont alors inchangs)
+    Ex. d'utilisation:
+                    if (lire_fichier_niveau(3,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,&lu)>=0 &&
+                        installer_niveau_lu(&niv,&lu)>=0) preparer_niveau(&niv);
+*/
+int installer_niveau_lu(t_niveau* niv, t_niveau_lu* lu)
+{
+    t_segment_compile* tab_murs=NULL;
+
+    if (lu->capacite>0){
+        tab_murs=(t_segment_compile*)realloc(niv->tab_murs,lu->capacite*sizeof(*tab_murs));
+        if (tab_murs==NULL) return -1;
+    }
+    else free(niv->tab_murs);
+    free(niv->tab_segments);
+    niv->tab_segments=lu->tab_segments;
+    niv->tab_murs=tab_murs;
+    niv->nb_segments=lu->nb_segments;
+    niv->capacite=lu->capacite;
+    memcpy(niv->tab_lanceur,lu->tab_lanceur,sizeof(lu->tab_lanceur));
+    memcpy(niv->tab_cible,lu->tab_cible,sizeof(lu->tab_cible));
+    initialiser_niveau_lu(lu);
+    return niv->nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: preparer_niveau
+    Description:    calcule les donnes qui ne dpendent que des murs du niveau et qui
+                    acclrent la simulation et l'affichage. Chaque mur est compil
+                    (voir compiler_segment): les collisions et l'affichage utilisent ses
+                    coordonnes relles, son quation de droite, son rectangle englobant et
+                    son orientation (test d'intersection adapt) sans les recalculer.
+                    L'arbre des murs est toujours construit (il sert aussi  trouver les
+                    murs visibles), la grille uniforme
+                    seulement si elle est l'index choisi pour les collisions. Sans index,
+                    les murs sont rangs par coordonne pour tre tests plusieurs  la fois.
+                    Les anciennes donnes calcules sont libres.
+    Paramtre(s):   niv     niveau dont les murs viennent d'tre chargs
+    Retour:         1 en cas de succs, 0 si les donnes n'ont pas pu tre calcules
+                    (la simulation reste possible, sans acclration)
+*/
+int preparer_niveau(t_niveau* niv)
+{
+    int i;
+
+    liberer_index_niveau(niv);
+    for (i=0;i<niv->nb_segments;i++){
+        compiler_segment(niv->tab_segments[i][X0],niv->tab_segments[i][Y0],
+                         niv->tab_segments[i][X1],niv->tab_segments[i][Y1],&niv->tab_murs[i]);
+    }
+    niv->bvh=construire_bvh(niv->tab_segments,niv->nb_segments);
+    if (niv->bvh==NULL) return 0;
+    if (niv->index_murs==INDEX_MURS_GRILLE){
+        niv->grille=construire_grille(niv->tab_segments,niv->nb_segments);
+        if (niv->grille==NULL) return 0;
+    }
+    if (niv->index_murs==INDEX_MURS_AUCUN){
+        niv->murs_simd=construire_murs_simd(niv->tab_segments,niv->nb_segments);
+        if (niv->murs_simd==NULL) return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_niveau
+    Description:    libre les murs d'un niveau et les donnes calcules  son chargement
+                    (le niveau est vide ensuite et peut tre charg  nouveau)
+    Paramtre(s):   niv     adresse de la structure de niveau
+    Retour:         aucun
+*/
+void liberer_niveau(t_niveau* niv)
+{
+    liberer_index_niveau(niv);
+    free(niv->tab_segments);
+    niv->tab_segments=NULL;
+    free(niv->tab_murs);
+    niv->tab_murs=NULL;
+    niv->nb_segments=0;
+    niv->capacite=0;
+}
+
+// ---------------------------------------------
+/* fonction: echanger_niveaux
+    Description:    change le contenu de deux structures de niveau, y compris les tableaux
+                    de murs et les donnes d'acclration, sans rien recopier (ex: mettre
+                    en jeu un niveau charg  l'avance)
+    Paramtre(s):   niv1,niv2   adresses des deux structures de niveau
+    Retour:         aucun
+    Ex. d'utilisation:
+                    echanger_niveaux(&niv,&niv_suivant);
+*/
+void echanger_niveaux(t_niveau* niv1, t_niveau* niv2)
+{
+    t_niveau tmp=*niv1;
+
+    *niv1=*niv2;
+    *niv2=tmp;
+}
+
+// ---------------------------------------------
+/* fonction: modifier_murs_niveau
+    Description:    remplace des murs d'un niveau prpar (ex: fichier du niveau modifi
+                    pendant la partie) en mettant  jour ses index sans les reconstruire:
+                    chaque mur est dplac dans la grille, sa place dans les murs rangs par
+                    coordonne est rcrite et les rectangles de l'arbre sont recalculs.
+                    La grille est reconstruite si un mur sort de la zone qu'elle couvre.
+    Paramtre(s):   niv             niveau prpar  modifier
+                    nb              nb de murs  remplacer
+                    tab_indices     indice de chaque mur  remplacer (moins que niv->nb_segments)
+                    tab_murs        nouveau segment de chaque mur  remplacer
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'allocation (niv doit alors tre
+                    prpar  nouveau, voir preparer_niveau)
+    Ex. d'utilisation:
+                    if (!modifier_murs_niveau(&niv,1,tab_indices,tab_murs)) preparer_niveau(&niv);
+*/
+int modifier_murs_niveau(t_niveau* niv, int nb, int tab_indices[], int tab_murs[][COL_TABSEG])
+{
+    int i,j,mur;
+    int reconstruire_grille=0;
+
+    // index lus dans le paquet de niveaux (lecture seule): les reconstruire au complet
+    if ((niv->bvh!=NULL && niv->bvh->emprunte) || (niv->murs_simd!=NULL && niv->murs_simd->memoire==NULL)){
+        for (i=0;i<nb;i++){
+            for (j=0;j<COL_TABSEG;j++) niv->tab_segments[tab_indices[i]][j]=tab_murs[i][j];
+        }
+        return preparer_niveau(niv);
+    }
+
+    for (i=0;i<nb;i++){
+        mur=tab_indices[i];
+        if (niv->grille!=NULL && !reconstruire_grille)
+            reconstruire_grille=!grille_deplacer_mur(niv->grille,niv->tab_segments[mur],tab_murs[i],mur);
+        for (j=0;j<COL_TABSEG;j++) niv->tab_segments[mur][j]=tab_murs[i][j];
+        compiler_segment(niv->tab_segments[mur][X0],niv->tab_segments[mur][Y0],
+                         niv->tab_segments[mur][X1],niv->tab_segments[mur][Y1],&niv->tab_murs[mur]);
+        if (niv->murs_simd!=NULL) murs_simd_modifier_mur(niv->murs_simd,mur,niv->tab_segments[mur]);
+    }
+    if (niv->bvh!=NULL) ajuster_bvh(niv->bvh,niv->tab_segments);
+    if (reconstruire_grille){
+        liberer_grille(niv->grille);
+        niv->grille=construire_grille(niv->tab_segments,niv->nb_segments);
+        if (niv->grille==NULL) return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: lire_niveau_dossier
+    Description:    lecture par dfaut de charger_niveau: le fichier du niveau dans le
+                    dossier DOSSIER_NIVEAU (voir lire_fichier_niveau)
+    Paramtre(s):   niveau  # du niveau
+                    lu      niveau lu  remplir
+    Retour:         le nombre de segments de murs, ou -1 en cas d'erreur de lecture du fichier
+*/
+static int lire_niveau_dossier(int niveau, t_niveau_lu* lu)
+{
+    return lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,lu);
+}
+
+static t_lecture_niveau lecture_niveau=lire_niveau_dossier;    // lecture utilise par charger_niveau
+
+// ---------------------------------------------
+/* fonction: choisir_lecture_niveau
+    Description:    choisit la fonction qui lit les fichiers de niveau pour charger_niveau
+                    (ex: lire_niveau_cache, qui garde les niveaux lus en mmoire). Cette
+                    librairie n'utilise pas SDL: le programme branche lui-mme le cache,
+                    qui en dpend. Le choix vaut pour tous les fils d'excution et doit
+                    tre fait avant de lancer ceux qui chargent des niveaux.
+    Paramtre(s):   lecture     fonction de lecture, NULL pour lire directement le fichier
+    Retour:         aucun
+    Ex. d'utilisation:
+                    choisir_lecture_niveau(lire_niveau_cache);
+*/
+void choisir_lecture_niveau(t_lecture_niveau lecture)
+{
+    lecture_niveau=(lecture!=NULL)?lecture:lire_niveau_dossier;
+}
+
+// ---------------------------------------------
+/* fonction: charger_niveau
+    Description:    charge le niveau demand des tableaux intgrs  l'excutable si le
+                    programme est compil avec NIVEAUX_EMBARQUES (voir niveaux_embarques.h),
+                    du paquet de niveaux s'il est ouvert (voir paquet_niveaux.h), sinon le fichier de niveau (dans le dossier DOSSIER_NIVEAU)
+                    avec la fonction de lecture choisie (voir choisir_lecture_niveau; ex: sa copie
+                    en mmoire s'il n'a pas chang, voir cache_niveau.h), rempli la structure de niveau correspondante et calcule les donnes
+                    d'acclration de la simulation (voir preparer_niveau)
+    Paramtre(s):   niveau      # du niveau
+                    niv         adresse de la structure de niveau  remplir
+                                (initialise avec initialiser_niveau)
+    Retour:         le nombre de segments de murs lu, ou -1 en cas d'erreur de lecture du fichier
+    Ex. d'utilisation:
+                    // charge le fichier "Niveaux/niveau3.txt"
+                    if (charger_niveau(3,&niv)<0) printf("erreur");
+*/
+int charger_niveau(int niveau, t_niveau* niv)
+{
+    t_niveau_lu lu;     // niveau lu (ses murs passent ensuite  niv, sans copie)
+    int nb_segments;
+
+    initialiser_niveau_lu(&lu);
+#ifdef NIVEAUX_EMBARQUES
+    // niveaux intgrs: aucun fichier
+    nb_segments=lire_niveau_embarque(niveau,&lu);
+#else
+    // niveau du paquet: dj prpar
+    if (charger_niveau_paquet(niveau,niv)>=0) return niv->nb_segments;
+
+    nb_segments=lecture_niveau(niveau,&lu);
+#endif
+    if (nb_segments>=0) nb_segments=installer_niveau_lu(niv,&lu);
+    liberer_niveau_lu(&lu);
+    if (nb_segments<0){
+        // niveau vide, marqu comme non charg
+        liberer_niveau(niv);
+        niv->nb_segments=-1;
+        return -1;
+    }
+    preparer_niveau(niv);
+    return niv->nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: nom_fichier_niveau
+    Description:    construit le nom d'un fichier associ  un niveau, dans le dossier
+                    DOSSIER_NIVEAU, avec l'extension demande
+    Paramtre(s):   niveau          # du niveau
+                    txt_fin_fichier suffixe/extension du fichier (ex: ".txt")
+                    nom_fichier     chaine  remplir (au moins MAX_CHAR caractres)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    nom_fichier_niveau(3,".txt",nom);   // nom vaut "Niveaux/niveau3.txt"
+*/
+void nom_fichier_niveau(int niveau, char* txt_fin_fichier, char nom_fichier[])
+{
+    sprintf(nom_fichier,"%s/%s%d%s",DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,niveau,txt_fin_fichier);
+}
+
+// ---------------------------------------------
+/* fonction: empreinte_fichier
+    Description:    calcule l'empreinte (hachage FNV-1a sur 32 bits) du contenu d'un
+                    fichier. Deux fichiers de contenus diffrents ont presque toujours
+                    des empreintes diffrentes, ce qui permet de dtecter la modification
+                    d'un fichier de niveau.
+    Paramtre(s):   nom_fichier     nom du fichier
+                    empreinte       adresse o placer l'empreinte calcule
+    Retour:         1 en cas de succs, 0 si le fichier ne peut pas tre lu
+    Ex. d'utilisation:
+                    if (empreinte_fichier("Niveaux/niveau3.txt",&empreinte)) ...
+*/
+int empreinte_fichier(char* nom_fichier, unsigned int* empreinte)
+{
+    unsigned char tampon[4096];     // bloc du fichier en cours de lecture
+    size_t nb_lus,i;                // nb d'octets lus dans le bloc
+    unsigned int h=2166136261u;     // empreinte FNV-1a en cours de calcul
+    FILE* fp;
+
+    fp = fopen(nom_fichier,"rb");
+    if (fp==NULL) return 0;
+
+    while ((nb_lus=fread(tampon,1,sizeof(tampon),fp))>0){
+        for (i=0;i<nb_lus;i++){
+            h^=tampon[i];
+            h*=16777619u;
+        }
+    }
+    fclose(fp);
+
+    *empreinte=h;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: fichier_modifie
+    Description:    indique si un fichier a chang depuis la version connue et met cette
+                    version  jour. La date de modification et la taille suffisent quand la
+                    date prcde d'au moins MARGE_DATE_FICHIER la dernire vrification:
+                    une criture plus rcente aurait chang la date. Sinon (criture dans
+                    la mme seconde, avec la mme taille) ou si verifier_contenu le demande
+                    (ex: changement signal par le systme), l'empreinte du contenu est
+                    compare  celle de la version connue.
+    Paramtre(s):   nom_fichier         nom du fichier
+                    version             version connue du fichier (connue=0: aucune), mise  jour
+                    verifier_contenu    1 pour toujours comparer l'empreinte du contenu
+    Retour:         1 si le fichier a chang (ou si aucune version n'tait connue), 0 s'il
+                    est inchang, -1 s'il ne peut pas tre lu
+    Ex. d'utilisation:
+                    if (fichier_modifie("Niveaux/niveau3.txt",&version,0)==1) ...
+*/
+int fichier_modifie(char* nom_fichier, t_version_fichier* version, int verifier_contenu)
+{
+    struct stat infos;
+    unsigned int empreinte;
+    int modifie;
+
+    if (stat(nom_fichier,&infos)!=0) return -1;
+    if (version->connue && !verifier_contenu &&
+        version->date_modification==infos.st_mtime && version->taille==(long)infos.st_size &&
+        infos.st_mtime+MARGE_DATE_FICHIER<=version->date_verification) return 0;
+
+    if (!empreinte_fichier(nom_fichier,&empreinte)) return -1;
+    modifie=!version->connue || version->empreinte!=empreinte;
+    version->connue=1;
+    version->date_modification=infos.st_mtime;
+    version->taille=(long)infos.st_size;
+    version->empreinte=empreinte;
+    version->date_verification=time(NULL);
+    return modifie;
+}
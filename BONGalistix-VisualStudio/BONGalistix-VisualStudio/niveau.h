@@ -0,0 +1,155 @@
+#ifndef NIVEAU_H
+#define NIVEAU_H
+
+// -------------------------------------------
+/*
+librairie niveau.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Description d'un niveau de jeu (murs, lanceur et cible) et fonctions
+             de chargement des fichiers de niveau. Cette librairie n'utilise pas la
+             librairie SDL et peut donc servir hors de la fentre graphique
+             (ex: simulation de tirs en lot).
+Note: les implmentations des fonctions se trouvent dans le fichier niveau.c
+*/
+// -------------------------------------------
+
+#include <stddef.h>
+#include <time.h>
+#include "geometrie.h"
+
+// -----------------------------------------
+// contantes utiles au chargement des diffrents niveaux
+// tous les niveaux doivent se trouver dans un dossier au mme endroit que l'excutable
+// le nom des fichiers de niveau est toujours le mme, seul l'index varie
+// ex: "Niveaux\niveau1.text" ... "Niveaux\niveau10.text"
+// Le premier niveau est le plus facile.
+// -----------------------------------------
+
+#define DOSSIER_NIVEAU              "Niveaux" // dossier dans lequel se trouvent les fichiers de niveaux
+#define DEBUT_NOM_FICHIER_NIVEAU    "niveau"  // prfixe du nom de ficher de niveau (ex:niveau4.txt)
+#define FIN_NOM_FICHIER_NIVEAU      ".txt"    // extension du nom de fichier de niveau (ex:niveau4.txt)
+#define PREMIER_NIVEAU              1         // index du premier niveau (ex: "Niveaux\niveau1.text")
+#define DERNIER_NIVEAU              18        // index du dernier niveau (ex: "Niveaux\niveau17.text")
+
+// ---------------------------------------------
+// dimensions du tableau des segments de murs du niveau en cours
+// ---------------------------------------------
+#define DIMENSION_POINT     2       // nb de dimension pour les coordonnes des points 2 pour 2D, 3 pour 3D
+#define POINT_PAR_SEGMENT   2       // nb de points pour dfinir un segment (mur)
+#define NB_SEGMENTS_INITIAL 100     // capacit initiale des tableaux de murs (agrandis au besoin)
+
+#define COL_TABSEG  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau de segments de murs
+#define COL_TABCIB  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur la cible
+#define COL_TABLAN  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur le lanceur
+
+// indices de colonne d'accs aux lment des tableau
+#define X0                  0
+#define Y0                  1
+#define X1                  2
+#define Y1                  3
+
+// ---------------------------------------------
+// limite de taille pour les chaines de caractres
+// ---------------------------------------------
+#define MAX_CHAR    100
+
+// ---------------------------------------------
+// index spatial utilis pour trouver les murs croiss par le projectile
+// ---------------------------------------------
+#define INDEX_MURS_AUCUN    0       // tous les murs sont tests (plusieurs  la fois, voir murs_simd.h)
+#define INDEX_MURS_GRILLE   1       // grille uniforme (voir grille.h)
+#define INDEX_MURS_BVH      2       // hirarchie de volumes englobants (voir bvh.h)
+#define INDEX_MURS_DEFAUT   INDEX_MURS_AUCUN    // les niveaux du jeu ont peu de murs
+
+// ---------------------------------------------
+// niveau charg en mmoire: murs, lanceur et cible
+// ainsi que les donnes calcules au chargement
+// ---------------------------------------------
+struct s_grille;    // grille uniforme des murs (voir grille.h)
+struct s_bvh;       // hirarchie de volumes englobants des murs (voir bvh.h)
+struct s_murs_simd; // murs rangs par coordonne pour les tests vectoriels (voir murs_simd.h)
+
+typedef struct {
+    int (*tab_segments)[COL_TABSEG];            // tableau de segments de murs (dynamique, NULL si vide)
+    int nb_segments;                            // nb de segments de murs valides dans le tableau
+    int capacite;                               // nb de murs que tab_segments et tab_murs peuvent contenir
+    t_segment_compile* tab_murs;                // donnes de chaque mur calcules au chargement: quation, normale,
+                                                // rectangle englobant et orientation (voir compiler_segment)
+    int tab_lanceur[COL_TABLAN];                // coordonnes de la position et du bout du lanceur
+    int tab_cible[COL_TABCIB];                  // coordonnes de la cible (coin infrieur gauche et coin suprieur droit)
+    int index_murs;                             // index spatial des murs  utiliser (INDEX_MURS_...)
+    struct s_grille* grille;                    // grille uniforme des murs (NULL si absente)
+    struct s_bvh* bvh;                          // arbre des murs (NULL si absent)
+    struct s_murs_simd* murs_simd;              // murs rangs par coordonne (NULL si absents)
+} t_niveau;
+
+// ---------------------------------------------
+// niveau dcod d'un fichier texte, sans limite du nb de murs
+// (les niveaux gnrs peuvent avoir des millions de murs)
+// ---------------------------------------------
+typedef struct {
+    int (*tab_segments)[COL_TABSEG];            // segments de murs (tableau dynamique, NULL si vide)
+    int nb_segments;                            // nb de segments de murs lus
+    int capacite;                               // nb de segments que le tableau peut contenir
+    int tab_lanceur[COL_TABLAN];                // coordonnes de la position et du bout du lanceur
+    int tab_cible[COL_TABCIB];                  // coordonnes de la cible
+} t_niveau_lu;
+
+// ---------------------------------------------
+// position et description d'une erreur de lecture de fichier de niveau
+// ---------------------------------------------
+typedef struct {
+    int ligne;                  // ligne de l'erreur ( partir de 1, 0 si le fichier n'a pas pu tre lu)
+    int colonne;                // colonne de l'erreur ( partir de 1)
+    char message[MAX_CHAR];     // description de l'erreur
+} t_erreur_niveau;
+
+// ---------------------------------------------
+// version d'un fichier de niveau, pour savoir s'il a chang depuis sa dernire lecture
+// (voir fichier_modifie)
+// ---------------------------------------------
+#define MARGE_DATE_FICHIER  2       // cart (s) en de duquel une date de modification proche de la
+                                    // vrification n'est pas fiable (dates  la seconde, 2 s en FAT)
+
+typedef struct {
+    int connue;                     // 1 si les champs dcrivent une version vrifie du fichier
+    time_t date_modification;       // date de modification du fichier
+    long taille;                    // taille du fichier (octets)
+    unsigned int empreinte;         // empreinte du contenu (voir empreinte_fichier)
+    time_t date_verification;       // date du calcul de l'empreinte
+} t_version_fichier;
+
+// ---------------------------------------------
+// lecture d'un niveau du dossier DOSSIER_NIVEAU par charger_niveau
+// (voir choisir_lecture_niveau; ex: lire_niveau_cache de cache_niveau.h)
+// ---------------------------------------------
+typedef int (*t_lecture_niveau)(int niveau, t_niveau_lu* lu);
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int lire_fichier_niveau(int niveau, char* dossier, char* txt_debut_fichier, char* txt_fin_fichier,
+                        t_niveau_lu* lu);
+void initialiser_niveau_lu(t_niveau_lu* lu);
+int reserver_niveau_lu(t_niveau_lu* lu, int capacite);
+int analyser_niveau(const char* texte, size_t taille, t_niveau_lu* lu, t_erreur_niveau* erreur);
+int lire_niveau_texte(const char* nom_fichier, t_niveau_lu* lu, t_erreur_niveau* erreur);
+void liberer_niveau_lu(t_niveau_lu* lu);
+void initialiser_niveau(t_niveau* niv);
+int reserver_murs_niveau(t_niveau* niv, int capacite);
+int installer_niveau_lu(t_niveau* niv, t_niveau_lu* lu);
+int preparer_niveau(t_niveau* niv);
+void liberer_niveau(t_niveau* niv);
+void choisir_lecture_niveau(t_lecture_niveau lecture);
+int charger_niveau(int niveau, t_niveau* niv);
+void echanger_niveaux(t_niveau* niv1, t_niveau* niv2);
+int modifier_murs_niveau(t_niveau* niv, int nb, int tab_indices[], int tab_murs[][COL_TABSEG]);
+void nom_fichier_niveau(int niveau, char* txt_fin_fichier, char nom_fichier[]);
+int empreinte_fichier(char* nom_fichier, unsigned int* empreinte);
+int fichier_modifie(char* nom_fichier, t_version_fichier* version, int verifier_contenu);
+
+void affiche_tab2D(int tab_segments[][COL_TABSEG],int nb_segments);
+
+#endif // NIVEAU_H
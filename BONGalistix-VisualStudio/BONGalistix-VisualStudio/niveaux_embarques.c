@@ -0,0 +1,163 @@
+// -------------------------------------------
+/*
+librairie niveaux_embarques.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Niveaux intgrs  l'excutable, tableaux constants gnrs et vrifis  la compilation.
+Note: les prototypes des fonctions se trouvent dans le fichier niveaux_embarques.h
+*/
+// -------------------------------------------
+
+#include <string.h>
+#include "niveaux_embarques.h"
+
+// ---------------------------------------------
+// niveau intgr: lanceur et cible rangs comme dans t_niveau
+// ---------------------------------------------
+typedef struct {
+    int niveau;                     // # du niveau
+    int tab_zone[COL_TABSEG];       // zone limite (x0,y0,x1,y1): ses 4 cts sont les premiers murs
+    int tab_lanceur[COL_TABLAN];    // position et bout du lanceur
+    int tab_cible[COL_TABCIB];      // coin infrieur gauche et coin suprieur droit de la cible
+    int nb_murs;                    // nb de murs intrieurs (dans tab_murs_embarques)
+} t_niveau_embarque;
+
+// ---------------------------------------------
+// vrifications  la compilation: un tableau de taille ngative arrte la compilation
+// (le nom du type indique la vrification et le niveau en cause)
+// ---------------------------------------------
+#define VERIFIER_EMBARQUE(condition,nom)    typedef char nom[(condition)?1:-1];
+
+// zone non vide (4 cts ferms), lanceur et cible dans la zone, nb de murs du niveau
+// entre 0 et NB_MURS_EMBARQUES_MAX
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs) \
+    enum { zone_x0_niveau##n=(zx0), zone_y0_niveau##n=(zy0), zone_x1_niveau##n=(zx1), zone_y1_niveau##n=(zy1), \
+           nb_murs_niveau##n=(nb_murs) }; \
+    VERIFIER_EMBARQUE((zx0)<(zx1) && (zy0)<(zy1),zone_fermee_niveau##n) \
+    VERIFIER_EMBARQUE((nb_murs)>=0 && (nb_murs)<=NB_MURS_EMBARQUES_MAX,nb_murs_valide_niveau##n) \
+    VERIFIER_EMBARQUE((zx0)<=(lx) && (lx)<=(zx1) && (zy0)<=(ly) && (ly)<=(zy1),lanceur_dans_zone_niveau##n) \
+    VERIFIER_EMBARQUE((cote)>0 && (zx0)<=(cx) && (cx)+(cote)<=(zx1) && (zy0)<=(cy) && (cy)+(cote)<=(zy1), \
+                      cible_dans_zone_niveau##n)
+// mur du niveau n dans sa zone et numro de mur infrieur au nb de murs dclar
+#define MUR(n,i,x0,y0,x1,y1) \
+    VERIFIER_EMBARQUE((i)>=0 && (i)<nb_murs_niveau##n,mur_declare_niveau##n##_##i) \
+    VERIFIER_EMBARQUE(zone_x0_niveau##n<=(x0) && (x0)<=zone_x1_niveau##n && zone_x0_niveau##n<=(x1) && (x1)<=zone_x1_niveau##n && \
+                      zone_y0_niveau##n<=(y0) && (y0)<=zone_y1_niveau##n && zone_y0_niveau##n<=(y1) && (y1)<=zone_y1_niveau##n, \
+                      mur_dans_zone_niveau##n##_##i)
+#include "niveaux_embarques.inc"
+#undef NIVEAU
+#undef MUR
+
+// position de chaque mur dans le fichier gnr (en ne comptant que les lignes MUR):
+// premier_mur_niveau<n> est la position de la ligne MUR qui suit NIVEAU(n,...)
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs) \
+    premier_mur_niveau##n, reprise_niveau##n=premier_mur_niveau##n-1,
+#define MUR(n,i,x0,y0,x1,y1)    position_mur_niveau##n##_##i,
+enum {
+#include "niveaux_embarques.inc"
+    fin_positions_murs
+};
+#undef NIVEAU
+#undef MUR
+
+// premier mur de chaque niveau selon les nb de murs dclars des niveaux prcdents
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs) \
+    premier_mur_declare_niveau##n, dernier_mur_declare_niveau##n=premier_mur_declare_niveau##n+(nb_murs)-1,
+#define MUR(n,i,x0,y0,x1,y1)
+enum {
+#include "niveaux_embarques.inc"
+    fin_murs_declares
+};
+#undef NIVEAU
+#undef MUR
+
+// les murs de chaque niveau commencent l o l'annoncent les niveaux prcdents et
+// le mur i est le i-me mur aprs la ligne NIVEAU (un doublon redclare une constante)
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs) \
+    VERIFIER_EMBARQUE((int)premier_mur_niveau##n==(int)premier_mur_declare_niveau##n,murs_contigus_niveau##n)
+#define MUR(n,i,x0,y0,x1,y1) \
+    VERIFIER_EMBARQUE(position_mur_niveau##n##_##i==premier_mur_niveau##n+(i),mur_en_place_niveau##n##_##i)
+#include "niveaux_embarques.inc"
+#undef NIVEAU
+#undef MUR
+
+// nb de murs intrieurs dclars par tous les niveaux
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs)  +(nb_murs)
+#define MUR(n,i,x0,y0,x1,y1)
+enum { NB_MURS_EMBARQUES=0
+#include "niveaux_embarques.inc"
+};
+#undef NIVEAU
+#undef MUR
+
+// ---------------------------------------------
+// tableaux constants des niveaux
+// ---------------------------------------------
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs) \
+    {(n),{(zx0),(zy0),(zx1),(zy1)},{(lx),(ly),(lx),(ly)},{(cx),(cy),(cx)+(cote),(cy)+(cote)},(nb_murs)},
+#define MUR(n,i,x0,y0,x1,y1)
+static const t_niveau_embarque tab_niveaux_embarques[]={
+#include "niveaux_embarques.inc"
+};
+#undef NIVEAU
+#undef MUR
+
+// murs intrieurs de tous les niveaux, dans l'ordre des niveaux
+// (le dernier lment permet un fichier gnr sans murs intrieurs)
+#define NIVEAU(n,zx0,zy0,zx1,zy1,lx,ly,cx,cy,cote,nb_murs)
+#define MUR(n,i,x0,y0,x1,y1)    {(x0),(y0),(x1),(y1)},
+static const int tab_murs_embarques[][COL_TABSEG]={
+#include "niveaux_embarques.inc"
+    {0,0,0,0}
+};
+#undef NIVEAU
+#undef MUR
+
+#define NB_NIVEAUX_EMBARQUES    ((int)(sizeof(tab_niveaux_embarques)/sizeof(tab_niveaux_embarques[0])))
+
+// chaque niveau a exactement le nb de murs dclar (avec la vrification de MUR)
+VERIFIER_EMBARQUE(sizeof(tab_murs_embarques)/sizeof(tab_murs_embarques[0])==NB_MURS_EMBARQUES+1,nb_murs_embarques_exact)
+
+// ---------------------------------------------
+/* fonction: lire_niveau_embarque
+    Description:    comme lire_fichier_niveau, mais  partir des tableaux intgrs 
+                    l'excutable: rempli le niveau lu avec les segments de murs (les 4 cts
+                    de la zone limite puis les murs intrieurs), le lanceur et la cible.
+                    Aucune lecture ni vrification: les niveaux ont t vrifis  la
+                    compilation.
+    Paramtre(s):   niveau      # du niveau
+                    lu          niveau lu  remplir (initialis avec initialiser_niveau_lu;
+                                son tableau de murs est rutilis et agrandi au besoin)
+    Retour:         le nombre de segments de murs, ou -1 si le niveau n'est pas intgr
+                    (ou en cas d'erreur d'allocation)
+    Ex. d'utilisation:
+                    nb=lire_niveau_embarque(3,&lu);
+*/
+int lire_niveau_embarque(int niveau, t_niveau_lu* lu)
+{
+    const t_niveau_embarque* e;
+    const int* zone;
+    int (*tab_seg)[COL_TABSEG];
+    int i,premier_mur=0;
+
+    for (i=0;i<NB_NIVEAUX_EMBARQUES && tab_niveaux_embarques[i].niveau!=niveau;i++){
+        premier_mur+=tab_niveaux_embarques[i].nb_murs;
+    }
+    if (i==NB_NIVEAUX_EMBARQUES) return -1;
+    e=&tab_niveaux_embarques[i];
+    if (!reserver_niveau_lu(lu,4+e->nb_murs)) return -1;
+    tab_seg=lu->tab_segments;
+
+    // les 4 cts de la zone limite, dans l'ordre de lire_fichier_niveau
+    zone=e->tab_zone;
+    tab_seg[0][X0]=zone[X0]; tab_seg[0][Y0]=zone[Y0]; tab_seg[0][X1]=zone[X0]; tab_seg[0][Y1]=zone[Y1];
+    tab_seg[1][X0]=zone[X0]; tab_seg[1][Y0]=zone[Y1]; tab_seg[1][X1]=zone[X1]; tab_seg[1][Y1]=zone[Y1];
+    tab_seg[2][X0]=zone[X1]; tab_seg[2][Y0]=zone[Y1]; tab_seg[2][X1]=zone[X1]; tab_seg[2][Y1]=zone[Y0];
+    tab_seg[3][X0]=zone[X1]; tab_seg[3][Y0]=zone[Y0]; tab_seg[3][X1]=zone[X0]; tab_seg[3][Y1]=zone[Y0];
+    memcpy(tab_seg[4],tab_murs_embarques[premier_mur],e->nb_murs*sizeof(tab_murs_embarques[0]));
+    memcpy(lu->tab_lanceur,e->tab_lanceur,sizeof(e->tab_lanceur));
+    memcpy(lu->tab_cible,e->tab_cible,sizeof(e->tab_cible));
+    lu->nb_segments=4+e->nb_murs;
+    return lu->nb_segments;
+}
+
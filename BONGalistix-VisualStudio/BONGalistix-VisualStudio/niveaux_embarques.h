@@ -0,0 +1,43 @@
+#ifndef NIVEAUX_EMBARQUES_H
+#define NIVEAUX_EMBARQUES_H
+
+// -------------------------------------------
+/*
+librairie niveaux_embarques.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Niveaux intgrs  l'excutable, pour les versions sans systme de fichiers
+             (borne de jeu). Les fichiers du dossier DOSSIER_NIVEAU sont convertis hors du
+             jeu (outil  embarquer  de BONGalistix-Outils) en un fichier gnr,
+             FICHIER_NIVEAUX_EMBARQUES, qui ne contient que des appels de macros:
+                 NIVEAU(niveau, zone x0,y0,x1,y1, lanceur x,y, cible x,y,ct, nb_murs)
+                 MUR(niveau, i, x0,y0,x1,y1)     (mur intrieur i du niveau, i=0  nb_murs-1)
+             niveaux_embarques.c inclut ce fichier plusieurs fois pour construire des
+             tableaux constants et pour vrifier chaque niveau  la compilation: la
+             compilation choue si la zone limite est vide (ses 4 cts ne ferment pas le
+             niveau), si un mur, le lanceur ou la cible sort de la zone, si le nb de
+             murs dclar est ngatif ou dpasse NB_MURS_EMBARQUES_MAX, ou si ses lignes
+             MUR ne suivent pas sa ligne NIVEAU dans l'ordre, sans trou ni doublon (les
+             murs sont rangs par position). niveaux_embarques.c fait partie de toutes
+             les versions du jeu: les niveaux sont vrifis  chaque compilation.
+             Compil avec NIVEAUX_EMBARQUES dfini, le jeu charge les niveaux de ces
+             tableaux (voir charger_niveau) sans paquet, sans fichiers et sans
+             rechargement  chaud. Le fichier gnr est conserv avec les sources: il
+             faut relancer l'outil aprs avoir modifi un niveau.
+Note: les implmentations des fonctions se trouvent dans le fichier niveaux_embarques.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+#define FICHIER_NIVEAUX_EMBARQUES   "niveaux_embarques.inc" // tableaux gnrs,  ct des sources
+#define NB_MURS_EMBARQUES_MAX       65536   // nb max de murs intrieurs d'un niveau intgr (chaque mur
+                                            // ajoute des dclarations compiles et des donnes  l'excutable)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int lire_niveau_embarque(int niveau, t_niveau_lu* lu);
+
+#endif // NIVEAUX_EMBARQUES_H
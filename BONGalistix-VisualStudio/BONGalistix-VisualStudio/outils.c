@@ -0,0 +1,556 @@
+/*
+outils hors-ligne de BONGallistix
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Programme console regroupant les outils utiliss hors du jeu, sans fentre
+             graphique. Le premier argument choisit l'outil:
+             solveur    rsolution exhaustive des niveaux (tables de tirs)
+             banc       bancs d'essai sur des niveaux gnrs
+             rendu      images d'un tir dessines sans cran (rendu logiciel)
+             paquet     compilation du paquet de niveaux (voir paquet_niveaux.h)
+             embarquer  gnration des niveaux intgrs au jeu (voir niveaux_embarques.h)
+             Le programme est li avec graph_logiciel.c: les fonctions graph_* dessinent
+             dans une image en mmoire.
+             Prcd de  -trace fichier.json , l'outil enregistre une trace chronologique
+             (chargements de niveau, lignes rsolues par chaque fil du solveur...).
+*/
+
+// -------------------------------------------
+// librairie standard d'entre/sortie
+// -------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// mesure du temps coul et dtection des instructions du processeur
+// (la fentre graphique SDL n'est pas utilise)
+#include <SDL_timer.h>
+#include <SDL_cpuinfo.h>
+
+// -------------------------------------------
+// rendu logiciel des fonctions graph_* (images en mmoire, sans cran)
+// -------------------------------------------
+#include "graph_logiciel.h"
+
+// -------------------------------------------
+// librairies du jeu
+// -------------------------------------------
+#include "niveau.h"
+#include "cache_niveau.h"
+#include "simulation.h"
+#include "solveur.h"
+#include "murs_simd.h"
+#include "banc.h"
+#include "bvh.h"
+#include "paquet_niveaux.h"
+#include "niveaux_embarques.h"
+#include "trace.h"
+
+// ---------------------------------------------
+// couleurs des images du rendu logiciel (RGB, les mmes que le jeu)
+// ---------------------------------------------
+#define COULEUR_RENDU_MUR       255,255,255
+#define COULEUR_RENDU_LANCEUR   255,0,0
+#define COULEUR_RENDU_PROJECTILE 0,255,0
+#define COULEUR_RENDU_CIBLE     0,255,255
+#define TAILLE_RENDU_PROJECTILE 2       // nb pixels ajouts de chaque ct du centre du projectile
+#define PAQUET_NB_CHARGEMENTS   1000    // nb de chargements mesurs par niveau (fichier texte et paquet)
+
+// ---------------------------------------------
+// prototypes des fonctions
+// ---------------------------------------------
+int outil_solveur(int argc, char* args[]);
+int outil_banc(int argc, char* args[]);
+int outil_rendu(int argc, char* args[]);
+int outil_paquet(int argc, char* args[]);
+int outil_embarquer(int argc, char* args[]);
+void dessiner_tir(t_niveau* niv, double tab_projectile[][COL_TABPRO]);
+void afficher_usage();
+
+// ---------------------------------------------
+// programme principal
+// ---------------------------------------------
+int main(int argc, char* args[])
+{
+    int retour=2;
+
+    // trace facultative: BONGalistix-Outils -trace fichier.json <outil> [arguments]
+    if (argc>=3 && strcmp(args[1],"-trace")==0){
+        if (!trace_demarrer(args[2])) printf("[ERR] - Trace impossible\n");
+        argc-=2;
+        args+=2;
+    }
+
+    // tester plusieurs murs  la fois avec les instructions vectorielles du processeur
+    if (SDL_HasAVX2()) choisir_noyau_murs_simd(NOYAU_AVX2);
+    else if (SDL_HasSSE2()) choisir_noyau_murs_simd(NOYAU_SSE2);
+
+    // niveaux lus gards en mmoire (un niveau rejou n'est pas relu)
+    choisir_lecture_niveau(lire_niveau_cache);
+
+    if (argc>=2 && strcmp(args[1],"solveur")==0) retour=outil_solveur(argc-2,args+2);
+    else if (argc>=2 && strcmp(args[1],"banc")==0) retour=outil_banc(argc-2,args+2);
+    else if (argc>=2 && strcmp(args[1],"rendu")==0) retour=outil_rendu(argc-2,args+2);
+    else if (argc>=2 && strcmp(args[1],"paquet")==0) retour=outil_paquet(argc-2,args+2);
+    else if (argc>=2 && strcmp(args[1],"embarquer")==0) retour=outil_embarquer(argc-2,args+2);
+    else afficher_usage();
+
+    if (trace_active() && trace_arreter()<0) printf("[ERR] - Ecriture de la trace impossible\n");
+
+    return retour;
+}
+
+// ---------------------------------------------
+/* fonction: afficher_usage
+    Description:    affiche la liste des outils et leurs arguments
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void afficher_usage()
+{
+    printf("usage: BONGalistix-Outils [-trace fichier.json] <outil> [arguments]\n");
+    printf("  solveur <niveau|tous> [-f nb_fils] [-r]\n");
+    printf("      simule tous les tirs possibles du ou des niveaux et sauvegarde les tables\n");
+    printf("      de tirs (-f: nb de fils d'execution, -r: ignorer les tables sauvegardees)\n");
+    printf("  banc index [nb_murs ...]\n");
+    printf("      compare la grille uniforme et l'arbre des murs (construction, recherche du\n");
+    printf("      premier mur croise, murs visibles) sur des niveaux generes (defaut: 1000\n");
+    printf("      10000 100000 murs)\n");
+    printf("  banc noyau\n");
+    printf("      compare le test d'intersection generique et les tests specialises des murs\n");
+    printf("      horizontaux et verticaux, par test et par tir\n");
+    printf("  banc integrateur\n");
+    printf("      compare les integrateurs numeriques du vol (precision et temps) a une\n");
+    printf("      simulation de reference a petits pas, en vol libre et par tir\n");
+    printf("  banc simd\n");
+    printf("      compare les noyaux de recherche du mur le plus proche (scalaire, SSE2,\n");
+    printf("      AVX2) a la recherche de reference, par segment et par tir\n");
+    printf("  banc rendu\n");
+    printf("      mesure le temps de dessin d'une image par le rendu logiciel (segments un\n");
+    printf("      a la fois et en lot) sur les niveaux du jeu et des niveaux generes\n");
+    printf("  banc lecture [nb_murs ...]\n");
+    printf("      compare la lecture ligne par ligne et la lecture en bloc de fichiers de\n");
+    printf("      niveau generes (defaut: 1000 10000 100000 1000000 murs)\n");
+    printf("  rendu <niveau> <vx> <vy> [modele]\n");
+    printf("      simule un tir en dessinant chaque pas sans ecran et mesure le temps de\n");
+    printf("      dessin; les images sont sauvegardees si un modele de nom est donne\n");
+    printf("      (ex: tir%%04d.ppm ou tir%%04d.png)\n");
+    printf("  paquet [fichier]\n");
+    printf("      compile les niveaux du dossier %s en un paquet binaire (defaut: %s),\n",DOSSIER_NIVEAU,FICHIER_PAQUET_NIVEAUX);
+    printf("      verifie chaque niveau du paquet et compare le temps de chargement\n");
+    printf("      (fichier texte et paquet)\n");
+    printf("  embarquer [fichier]\n");
+    printf("      convertit les niveaux du dossier %s en tableaux a integrer au jeu\n",DOSSIER_NIVEAU);
+    printf("      (defaut: %s, a placer avec les sources du jeu puis recompiler)\n",FICHIER_NIVEAUX_EMBARQUES);
+}
+
+// ---------------------------------------------
+/* fonction: outil_solveur
+    Description:    rsout un niveau ou tous les niveaux, affiche le nombre de tirs russis
+                    de chacun et classe les niveaux du plus facile au plus difficile
+                    (proportion de tirs russis dcroissante).
+    Paramtre(s):   argc,args   arguments de l'outil (sans le nom de l'outil)
+    Retour:         0 si tous les niveaux rsolus ont au moins un tir russi,
+                    1 si un niveau est insoluble ou ne peut pas tre charg, 2 si les
+                    arguments sont invalides
+*/
+int outil_solveur(int argc, char* args[])
+{
+    int premier,dernier;            // niveaux  rsoudre
+    int nb_fils=0;                  // nb de fils d'excution (0: tous les processeurs)
+    int recalculer=0;               // 1 pour ignorer les tables sauvegardes
+    int tab_niveaux[DERNIER_NIVEAU+1];      // niveaux rsolus, tris par difficult
+    double tab_taux[DERNIER_NIVEAU+1];      // proportion de tirs russis par niveau
+    int nb_resolus=0;
+    int niveau,i,j,en_cache,nb_touches,tmp;
+    int retour=0;
+    double taux;
+    Uint64 debut,debut_total;
+    t_table_tirs table;
+
+    if (argc<1){
+        afficher_usage();
+        return 2;
+    }
+    if (strcmp(args[0],"tous")==0){
+        premier=PREMIER_NIVEAU;
+        dernier=DERNIER_NIVEAU;
+    }
+    else{
+        premier=dernier=atoi(args[0]);
+        if (premier<PREMIER_NIVEAU || premier>DERNIER_NIVEAU){
+            afficher_usage();
+            return 2;
+        }
+    }
+    for (i=1;i<argc;i++){
+        if (strcmp(args[i],"-f")==0 && i+1<argc) nb_fils=atoi(args[++i]);
+        else if (strcmp(args[i],"-r")==0) recalculer=1;
+        else{
+            afficher_usage();
+            return 2;
+        }
+    }
+
+    debut_total=SDL_GetPerformanceCounter();
+    for (niveau=premier;niveau<=dernier;niveau++){
+        debut=SDL_GetPerformanceCounter();
+        nb_touches=obtenir_table_tirs(niveau,nb_fils,recalculer,&table,&en_cache);
+        if (nb_touches<0){
+            printf("[ERR] - Niveau %d: chargement impossible\n",niveau);
+            retour=1;
+            continue;
+        }
+
+        taux=(double)nb_touches/table.nb_tirs;
+        printf("[%s] - Niveau %2d: %6d tirs, %6d reussis (%5.2lf%%) en %7.3lf s%s\n",
+               nb_touches>0?" OK":"ERR",niveau,table.nb_tirs,nb_touches,100*taux,
+               (double)(SDL_GetPerformanceCounter()-debut)/SDL_GetPerformanceFrequency(),
+               en_cache?" (table sauvegardee)":"");
+        if (nb_touches==0) retour=1;
+
+        tab_niveaux[nb_resolus]=niveau;
+        tab_taux[nb_resolus]=taux;
+        nb_resolus++;
+        liberer_table_tirs(&table);
+    }
+
+    if (nb_resolus>1){
+        // tri par insertion: du plus grand taux de russite au plus petit
+        for (i=1;i<nb_resolus;i++){
+            for (j=i;j>0 && tab_taux[j]>tab_taux[j-1];j--){
+                taux=tab_taux[j]; tab_taux[j]=tab_taux[j-1]; tab_taux[j-1]=taux;
+                tmp=tab_niveaux[j]; tab_niveaux[j]=tab_niveaux[j-1]; tab_niveaux[j-1]=tmp;
+            }
+        }
+        printf("Classement du plus facile au plus difficile:\n");
+        for (i=0;i<nb_resolus;i++){
+            printf("  %2d. niveau %2d (%5.2lf%%)\n",i+1,tab_niveaux[i],100*tab_taux[i]);
+        }
+        printf("Temps total: %.3lf s\n",
+               (double)(SDL_GetPerformanceCounter()-debut_total)/SDL_GetPerformanceFrequency());
+    }
+
+    return retour;
+}
+
+// ---------------------------------------------
+/* fonction: outil_banc
+    Description:    lance le banc d'essai demand
+    Paramtre(s):   argc,args   arguments de l'outil (sans le nom de l'outil)
+    Retour:         0 si les rsultats des bancs concordent avec la rfrence, 1 sinon,
+                    2 si les arguments sont invalides
+*/
+int outil_banc(int argc, char* args[])
+{
+    int tab_nb_murs_defaut[]={1000,10000,100000};
+    int tab_nb_murs_lus_defaut[]={1000,10000,100000,1000000};
+    int i,nb_murs,retour=0;
+
+    if (argc>=1 && strcmp(args[0],"index")==0){
+        if (argc==1){
+            for (i=0;i<3;i++){
+                if (banc_index_murs(tab_nb_murs_defaut[i])!=0) retour=1;
+            }
+        }
+        for (i=1;i<argc;i++){
+            nb_murs=atoi(args[i]);
+            if (nb_murs<4){
+                afficher_usage();
+                return 2;
+            }
+            if (banc_index_murs(nb_murs)!=0) retour=1;
+        }
+        return retour;
+    }
+
+    if (argc==1 && strcmp(args[0],"noyau")==0){
+        return (banc_noyau_collision()!=0);
+    }
+
+    if (argc==1 && strcmp(args[0],"integrateur")==0){
+        return (banc_integrateurs()!=0);
+    }
+
+    if (argc==1 && strcmp(args[0],"simd")==0){
+        return (banc_noyau_simd()!=0);
+    }
+
+    if (argc==1 && strcmp(args[0],"rendu")==0){
+        return (banc_rendu()!=0);
+    }
+
+    if (argc>=1 && strcmp(args[0],"lecture")==0){
+        if (argc==1){
+            for (i=0;i<4;i++){
+                if (banc_lecture_niveau(tab_nb_murs_lus_defaut[i])!=0) retour=1;
+            }
+        }
+        for (i=1;i<argc;i++){
+            nb_murs=atoi(args[i]);
+            if (nb_murs<4){
+                afficher_usage();
+                return 2;
+            }
+            if (banc_lecture_niveau(nb_murs)!=0) retour=1;
+        }
+        return retour;
+    }
+
+    afficher_usage();
+    return 2;
+}
+
+// ---------------------------------------------
+/* fonction: dessiner_tir
+    Description:    dessine une image du tir (murs, cible, lanceur et projectile) avec les
+                    fonctions graph_*
+    Paramtre(s):   niv             niveau du tir
+                    tab_projectile  position actuelle du projectile
+    Retour:         aucun
+*/
+void dessiner_tir(t_niveau* niv, double tab_projectile[][COL_TABPRO])
+{
+    int x=(int)tab_projectile[POSITION][X1],y=(int)tab_projectile[POSITION][Y1];
+
+    graph_clear(0,0,0,255);
+    graph_select_couleur(COULEUR_RENDU_MUR,255);
+    graph_trace_segments(niv->tab_segments,niv->nb_segments);
+    graph_select_couleur(COULEUR_RENDU_CIBLE,255);
+    graph_trace_rectangle(niv->tab_cible[X0],niv->tab_cible[Y0],niv->tab_cible[X1],niv->tab_cible[Y1]);
+    graph_select_couleur(COULEUR_RENDU_LANCEUR,255);
+    graph_trace_segment(niv->tab_lanceur[X0],niv->tab_lanceur[Y0],niv->tab_lanceur[X1],niv->tab_lanceur[Y1]);
+    graph_select_couleur(COULEUR_RENDU_PROJECTILE,255);
+    graph_trace_rectangle(x-TAILLE_RENDU_PROJECTILE,y-TAILLE_RENDU_PROJECTILE,
+                          x+TAILLE_RENDU_PROJECTILE,y+TAILLE_RENDU_PROJECTILE);
+}
+
+// ---------------------------------------------
+/* fonction: outil_rendu
+    Description:    simule un tir pas  pas comme le jeu (mise_a_jour_vol, cible atteinte,
+                    immobilit) en dessinant une image par pas avec le rendu logiciel,
+                    sans cran. Affiche l'issue du tir, le nb d'images et le temps moyen
+                    de dessin d'une image (sans la sauvegarde des fichiers).
+    Paramtre(s):   argc,args   arguments de l'outil: niveau, vitesse initiale (vx,vy) et
+                                modle facultatif du nom des images (voir
+                                graph_logiciel_capturer)
+    Retour:         0 si le tir est simul, 1 si le niveau ne peut pas tre charg ou
+                    l'image cre, 2 si les arguments sont invalides
+*/
+int outil_rendu(int argc, char* args[])
+{
+    double tab_projectile[LIG_TABPRO][COL_TABPRO]={{0}};
+    double t=0,chrono_immobile=0;
+    int niveau,vx,vy,touche=0,fin=0;
+    Uint64 debut,duree=0;
+    t_niveau niv;
+
+    if (argc<3 || argc>4){
+        afficher_usage();
+        return 2;
+    }
+    niveau=atoi(args[0]);
+    vx=atoi(args[1]);
+    vy=atoi(args[2]);
+
+    initialiser_niveau(&niv);
+    if (charger_niveau(niveau,&niv)<0){
+        printf("[ERR] - Niveau %d: chargement impossible\n",niveau);
+        return 1;
+    }
+    if (!graph_init("BONGallistix",LARGEUR_FEN,HAUTEUR_FEN,0,0,0,255)){
+        liberer_niveau(&niv);
+        return 1;
+    }
+    if (argc==4 && !graph_logiciel_capturer(args[3])){
+        printf("[ERR] - Modele de nom d'image invalide (un seul %%d attendu): %s\n",args[3]);
+        graph_fin();
+        liberer_niveau(&niv);
+        return 2;
+    }
+
+    niv.tab_lanceur[X1]=niv.tab_lanceur[X0]+vx;
+    niv.tab_lanceur[Y1]=niv.tab_lanceur[Y0]+vy;
+    tab_projectile[POSITION][X1]=niv.tab_lanceur[X0];
+    tab_projectile[POSITION][Y1]=niv.tab_lanceur[Y0];
+    tab_projectile[VITESSE][X1]=vx;
+    tab_projectile[VITESSE][Y1]=vy;
+
+    while (!fin){
+        // le temps de sauvegarde des images (graph_mise_a_jour) n'est pas compt:
+        // il dpend du disque
+        debut=SDL_GetPerformanceCounter();
+        dessiner_tir(&niv,tab_projectile);
+        duree+=SDL_GetPerformanceCounter()-debut;
+        graph_mise_a_jour();
+
+        mise_a_jour_vol(&niv,tab_projectile,&t,DELTAT);
+        if (cible_atteinte(tab_projectile,niv.tab_cible)){
+            touche=1;
+            fin=1;
+        }
+        else{
+            if (projectile_immobile(tab_projectile)){
+                chrono_immobile+=DELTAT;
+                if (chrono_immobile>=T_IMMOBILE_MAX) fin=1;
+            }
+            else chrono_immobile=0;
+            if (t>=T_VOL_MAX) fin=1;
+        }
+    }
+    dessiner_tir(&niv,tab_projectile);
+    graph_mise_a_jour();
+
+    printf("[ OK] - Niveau %d, tir (%d,%d): %s en %.2lf s, %d images, %.2lf us/image\n",
+           niveau,vx,vy,touche?"cible atteinte":"cible ratee",t,graph_logiciel_nb_images(),
+           1e6*(double)duree/SDL_GetPerformanceFrequency()/(graph_logiciel_nb_images()-1));
+
+    graph_fin();
+    liberer_niveau(&niv);
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: niveaux_identiques
+    Description:    compare deux niveaux prpars sans grille: segments, murs compils,
+                    lanceur, cible, arbre des murs et murs rangs par coordonne
+    Paramtre(s):   a,b     niveaux  comparer
+    Retour:         1 si les niveaux sont identiques, 0 sinon
+*/
+static int niveaux_identiques(t_niveau* a, t_niveau* b)
+{
+    if (a->nb_segments!=b->nb_segments ||
+        memcmp(a->tab_segments,b->tab_segments,a->nb_segments*sizeof(a->tab_segments[0]))!=0 ||
+        memcmp(a->tab_murs,b->tab_murs,a->nb_segments*sizeof(t_segment_compile))!=0 ||
+        memcmp(a->tab_lanceur,b->tab_lanceur,sizeof(a->tab_lanceur))!=0 ||
+        memcmp(a->tab_cible,b->tab_cible,sizeof(a->tab_cible))!=0) return 0;
+    if (a->bvh==NULL || b->bvh==NULL || a->murs_simd==NULL || b->murs_simd==NULL) return 0;
+    return a->bvh->nb_noeuds==b->bvh->nb_noeuds &&
+           memcmp(a->bvh->tab_noeuds,b->bvh->tab_noeuds,a->bvh->nb_noeuds*sizeof(t_noeud_bvh))==0 &&
+           memcmp(a->bvh->tab_murs,b->bvh->tab_murs,a->nb_segments*sizeof(int))==0 &&
+           a->murs_simd->nb_places==b->murs_simd->nb_places &&
+           memcmp(a->murs_simd->tab_ax,b->murs_simd->tab_ax,4*(size_t)a->murs_simd->nb_places*sizeof(double))==0;
+}
+
+// ---------------------------------------------
+/* fonction: outil_paquet
+    Description:    compile le paquet de niveaux  partir des fichiers texte, l'ouvre et
+                    vrifie que chaque niveau du paquet est identique au niveau lu et
+                    prpar  partir de son fichier. Affiche le temps moyen de chargement
+                    de chaque niveau (lecture du fichier et prparation, puis paquet).
+    Paramtre(s):   argc,args   arguments de l'outil: nom facultatif du paquet
+    Retour:         0 si le paquet est crit et vrifi, 1 en cas d'erreur, 2 si les
+                    arguments sont invalides
+*/
+int outil_paquet(int argc, char* args[])
+{
+    const char* nom_fichier=FICHIER_PAQUET_NIVEAUX;
+    int nb_niveaux,niveau,i,identique,retour=0;
+    Uint64 debut,duree_texte,duree_paquet;
+    t_niveau niv_texte,niv_paquet;
+    t_niveau_lu lu;
+
+    if (argc>1){
+        afficher_usage();
+        return 2;
+    }
+    if (argc==1) nom_fichier=args[0];
+
+    nb_niveaux=compiler_paquet_niveaux(nom_fichier,PREMIER_NIVEAU,DERNIER_NIVEAU);
+    if (nb_niveaux<0 || ouvrir_paquet_niveaux(nom_fichier)!=nb_niveaux){
+        printf("[ERR] - Paquet %s: ecriture ou ouverture impossible\n",nom_fichier);
+        return 1;
+    }
+    printf("[ OK] - Paquet %s: %d niveaux\n",nom_fichier,nb_niveaux);
+
+    initialiser_niveau(&niv_texte);
+    initialiser_niveau(&niv_paquet);
+    initialiser_niveau_lu(&lu);
+    niv_texte.index_murs=INDEX_MURS_AUCUN;
+    niv_paquet.index_murs=INDEX_MURS_AUCUN;
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        if (charger_niveau_paquet(niveau,&niv_paquet)<0) continue;
+
+        // chargement sans paquet ni cache: lecture du fichier et prparation
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<PAQUET_NB_CHARGEMENTS;i++){
+            if (lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,&lu)>=0 &&
+                installer_niveau_lu(&niv_texte,&lu)>=0) preparer_niveau(&niv_texte);
+            else liberer_niveau(&niv_texte);
+        }
+        duree_texte=SDL_GetPerformanceCounter()-debut;
+
+        debut=SDL_GetPerformanceCounter();
+        for (i=0;i<PAQUET_NB_CHARGEMENTS;i++) charger_niveau_paquet(niveau,&niv_paquet);
+        duree_paquet=SDL_GetPerformanceCounter()-debut;
+
+        identique=niveaux_identiques(&niv_texte,&niv_paquet);
+        if (!identique) retour=1;
+        printf("[%s] - Niveau %2d: %4d murs, fichier %8.2lf us, paquet %6.2lf us%s\n",
+               identique?" OK":"ERR",niveau,niv_paquet.nb_segments,
+               1e6*(double)duree_texte/SDL_GetPerformanceFrequency()/PAQUET_NB_CHARGEMENTS,
+               1e6*(double)duree_paquet/SDL_GetPerformanceFrequency()/PAQUET_NB_CHARGEMENTS,
+               identique?"":" (different du fichier)");
+    }
+    liberer_niveau_lu(&lu);
+    liberer_niveau(&niv_texte);
+    liberer_niveau(&niv_paquet);
+    fermer_paquet_niveaux();
+    return retour;
+}
+
+// ---------------------------------------------
+/* fonction: outil_embarquer
+    Description:    lit les fichiers texte des niveaux et crit le fichier d'appels de
+                    macros inclus par niveaux_embarques.c (voir niveaux_embarques.h). Les
+                    niveaux absents ou illisibles ne sont pas intgrs. Les niveaux sont
+                    vrifis  la compilation du jeu, pas par cet outil: il doit pouvoir
+                    tre compil quel que soit le contenu du fichier gnr.
+    Paramtre(s):   argc,args   arguments de l'outil: nom facultatif du fichier gnr
+    Retour:         0 si le fichier est crit, 1 en cas d'erreur d'criture, 2 si les
+                    arguments sont invalides
+*/
+int outil_embarquer(int argc, char* args[])
+{
+    const char* nom_fichier=FICHIER_NIVEAUX_EMBARQUES;
+    t_niveau_lu lu;
+    int (*tab_seg)[COL_TABSEG];
+    int niveau,nb_segments,i,nb_niveaux=0;
+    FILE* fp;
+
+    if (argc>1){
+        afficher_usage();
+        return 2;
+    }
+    if (argc==1) nom_fichier=args[0];
+
+    fp=fopen(nom_fichier,"w");
+    if (fp==NULL){
+        printf("[ERR] - %s: ecriture impossible\n",nom_fichier);
+        return 1;
+    }
+    fprintf(fp,"// Fichier genere par \"BONGalistix-Outils embarquer\" a partir du dossier %s: ne pas modifier.\n",DOSSIER_NIVEAU);
+    fprintf(fp,"// NIVEAU(niveau, zone x0,y0,x1,y1, lanceur x,y, cible x,y,cote, nb_murs)\n");
+    fprintf(fp,"// MUR(niveau, numero, x0,y0,x1,y1)    (murs interieurs, apres les 4 cotes de la zone)\n");
+    initialiser_niveau_lu(&lu);
+    for (niveau=PREMIER_NIVEAU;niveau<=DERNIER_NIVEAU;niveau++){
+        nb_segments=lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,&lu);
+        if (nb_segments<4) continue;
+        tab_seg=lu.tab_segments;
+        // zone limite: coin de dpart du 1er ct et du 3e ct (voir lire_fichier_niveau)
+        fprintf(fp,"NIVEAU(%d, %d,%d,%d,%d, %d,%d, %d,%d,%d, %d)\n",niveau,
+                tab_seg[0][X0],tab_seg[0][Y0],tab_seg[2][X0],tab_seg[2][Y0],lu.tab_lanceur[X0],lu.tab_lanceur[Y0],
+                lu.tab_cible[X0],lu.tab_cible[Y0],lu.tab_cible[X1]-lu.tab_cible[X0],nb_segments-4);
+        for (i=4;i<nb_segments;i++){
+            fprintf(fp,"MUR(%d, %d, %d,%d,%d,%d)\n",niveau,i-4,tab_seg[i][X0],tab_seg[i][Y0],tab_seg[i][X1],tab_seg[i][Y1]);
+        }
+        nb_niveaux++;
+    }
+    liberer_niveau_lu(&lu);
+    if (fclose(fp)!=0){
+        printf("[ERR] - %s: ecriture impossible\n",nom_fichier);
+        return 1;
+    }
+    printf("[ OK] - %s: %d niveaux (recompiler le jeu avec NIVEAUX_EMBARQUES pour les integrer)\n",nom_fichier,nb_niveaux);
+    return 0;
+}
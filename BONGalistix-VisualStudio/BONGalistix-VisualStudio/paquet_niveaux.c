@@ -0,0 +1,568 @@
+// -------------------------------------------
+/*
+librairie paquet_niveaux.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Paquet de niveaux compil, projet en mmoire et utilis sur place.
+Note: les prototypes des fonctions se trouvent dans le fichier paquet_niveaux.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// projection d'un fichier en mmoire
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define PAQUET_MMAP
+#endif
+
+#include "grille.h"
+#include "bvh.h"
+#include "murs_simd.h"
+#include "paquet_niveaux.h"
+
+// ---------------------------------------------
+// en-tte du paquet (au dbut du fichier)
+// ---------------------------------------------
+typedef struct {
+    char signature[8];          // PAQUET_SIGNATURE
+    int32_t version;            // PAQUET_VERSION
+    int32_t ordre_octets;       // PAQUET_ORDRE_OCTETS, tel qu'crit par la machine qui a compil le paquet
+    int32_t taille_noeud;       // sizeof(t_noeud_bvh) de la machine qui a compil le paquet
+    int32_t taille_mur;         // sizeof(t_segment_compile) de la machine qui a compil le paquet
+    int32_t largeur_simd;       // MURS_SIMD_LARGEUR
+    int32_t nb_niveaux;         // nb d'entres de l'index (aprs l'en-tte)
+    int64_t taille_fichier;     // taille totale du paquet (octets)
+} t_entete_paquet;
+
+// ---------------------------------------------
+// entre de l'index: un niveau du paquet
+// (les dcalages sont compts depuis le dbut du fichier et multiples de PAQUET_ALIGNEMENT)
+// ---------------------------------------------
+typedef struct {
+    int32_t niveau;                     // # du niveau
+    int32_t nb_segments;                // nb de segments de murs
+    int32_t nb_places;                  // nb de murs des tableaux rangs par coordonne (avec le remplissage)
+    int32_t nb_noeuds;                  // nb de noeuds de l'arbre des murs
+    uint32_t empreinte;                 // empreinte du fichier texte compil (voir empreinte_fichier)
+    int32_t tab_lanceur[COL_TABLAN];    // lanceur
+    int32_t tab_cible[COL_TABCIB];      // cible
+    int64_t decalage_simd;              // 4 tableaux de nb_places double: ax, ay, ex, ey
+    int64_t decalage_noeuds;            // nb_noeuds t_noeud_bvh
+    int64_t decalage_murs_bvh;          // nb_segments int: murs rangs par feuille
+    int64_t decalage_segments;          // nb_segments x COL_TABSEG int
+    int64_t decalage_murs_compiles;     // nb_segments t_segment_compile
+} t_index_paquet;
+
+// ---------------------------------------------
+// fichier texte d'un niveau du paquet, vrifi  l'ouverture du paquet
+// ---------------------------------------------
+#define SOURCE_ABSENTE  0       // pas de fichier texte: le niveau du paquet est utilis
+#define SOURCE_A_JOUR   1       // mme contenu que le fichier compil (tant que sa date et sa taille ne changent pas)
+#define SOURCE_PERIMEE  2       // fichier modifi depuis la compilation du paquet
+
+typedef struct {
+    int etat;                           // SOURCE_ABSENTE, SOURCE_A_JOUR ou SOURCE_PERIMEE
+    time_t date_modification;           // date de modification du fichier vrifi
+    long taille;                        // taille du fichier vrifi (octets)
+} t_source_niveau;
+
+static const char* paquet=NULL;                     // dbut du paquet en mmoire (NULL s'il n'est pas ouvert)
+static size_t taille_paquet=0;                      // taille du paquet (octets)
+static const t_index_paquet* tab_index=NULL;        // index des niveaux du paquet
+static int nb_niveaux_paquet=0;                     // nb de niveaux du paquet
+static t_source_niveau* tab_sources=NULL;           // fichier texte de chaque niveau de l'index
+static void* memoire_paquet=NULL;                   // bloc allou si le paquet a t lu plutt que projet
+#if defined(_WIN32)
+static HANDLE fichier_paquet=INVALID_HANDLE_VALUE;  // fichier projet
+static HANDLE projection_paquet=NULL;               // projection du fichier
+#endif
+
+// ---------------------------------------------
+/* fonction: aligner
+    Description:    arrondit un dcalage au multiple de PAQUET_ALIGNEMENT suivant
+    Paramtre(s):   decalage    dcalage (octets)
+    Retour:         le dcalage align
+*/
+static int64_t aligner(int64_t decalage)
+{
+    return (decalage+PAQUET_ALIGNEMENT-1)/PAQUET_ALIGNEMENT*PAQUET_ALIGNEMENT;
+}
+
+// ---------------------------------------------
+/* fonction: ecrire_bloc
+    Description:    crit des octets nuls jusqu' un dcalage du fichier puis un bloc de donnes
+    Paramtre(s):   fp          fichier en cours d'criture
+                    position    adresse de la position actuelle dans le fichier (mise  jour)
+                    decalage    position du bloc (au moins *position)
+                    donnees     donnes  crire
+                    taille      taille des donnes (octets)
+    Retour:         1 en cas de succs, 0 en cas d'erreur d'criture
+*/
+static int ecrire_bloc(FILE* fp, int64_t* position, int64_t decalage, const void* donnees, size_t taille)
+{
+    static const char zeros[PAQUET_ALIGNEMENT]={0};
+
+    while (*position<decalage){
+        if (fwrite(zeros,1,1,fp)!=1) return 0;
+        (*position)++;
+    }
+    if (taille>0 && fwrite(donnees,1,taille,fp)!=taille) return 0;
+    *position+=taille;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: compiler_paquet_niveaux
+    Description:    lit et prpare les fichiers texte des niveaux premier  dernier (dossier
+                    DOSSIER_NIVEAU) puis crit le paquet de niveaux. Les niveaux absents ou
+                    illisibles ne sont pas mis dans le paquet.
+    Paramtre(s):   nom_fichier     fichier du paquet  crire
+                    premier,dernier # du premier et du dernier niveau
+    Retour:         le nb de niveaux mis dans le paquet, -1 en cas d'erreur d'allocation
+                    ou d'criture
+    Ex. d'utilisation:
+                    compiler_paquet_niveaux(FICHIER_PAQUET_NIVEAUX,PREMIER_NIVEAU,DERNIER_NIVEAU);
+*/
+int compiler_paquet_niveaux(const char* nom_fichier, int premier, int dernier)
+{
+    t_niveau* tab_niveaux;
+    t_index_paquet* tab_entrees;
+    t_entete_paquet entete;
+    t_index_paquet* e;
+    t_niveau* niv;
+    FILE* fp;
+    char nom_source[MAX_CHAR];
+    unsigned int empreinte;
+    t_niveau_lu lu;
+    int64_t decalage,position=0;
+    int niveau,nb=0,i,reussite;
+
+    if (dernier<premier) return -1;
+    tab_niveaux=(t_niveau*)malloc((dernier-premier+1)*sizeof(t_niveau));
+    tab_entrees=(t_index_paquet*)calloc(dernier-premier+1,sizeof(t_index_paquet));
+    if (tab_niveaux==NULL || tab_entrees==NULL){
+        free(tab_niveaux);
+        free(tab_entrees);
+        return -1;
+    }
+
+    // lire et prparer chaque niveau (murs rangs par coordonne et arbre des murs)
+    initialiser_niveau_lu(&lu);
+    for (niveau=premier;niveau<=dernier;niveau++){
+        niv=&tab_niveaux[nb];
+        nom_fichier_niveau(niveau,FIN_NOM_FICHIER_NIVEAU,nom_source);
+        if (!empreinte_fichier(nom_source,&empreinte)) continue;
+        initialiser_niveau(niv);
+        niv->index_murs=INDEX_MURS_AUCUN;
+        if (lire_fichier_niveau(niveau,DOSSIER_NIVEAU,DEBUT_NOM_FICHIER_NIVEAU,FIN_NOM_FICHIER_NIVEAU,&lu)<=0 ||
+            installer_niveau_lu(niv,&lu)<=0 || !preparer_niveau(niv)){
+            liberer_niveau(niv);
+            continue;
+        }
+        tab_entrees[nb].niveau=niveau;
+        tab_entrees[nb].empreinte=empreinte;
+        nb++;
+    }
+    liberer_niveau_lu(&lu);
+
+    // position des tableaux de chaque niveau
+    decalage=aligner(sizeof(t_entete_paquet)+nb*sizeof(t_index_paquet));
+    for (i=0;i<nb;i++){
+        niv=&tab_niveaux[i];
+        e=&tab_entrees[i];
+        e->nb_segments=niv->nb_segments;
+        e->nb_places=niv->murs_simd->nb_places;
+        e->nb_noeuds=niv->bvh->nb_noeuds;
+        memcpy(e->tab_lanceur,niv->tab_lanceur,sizeof(e->tab_lanceur));
+        memcpy(e->tab_cible,niv->tab_cible,sizeof(e->tab_cible));
+        e->decalage_simd=decalage;
+        decalage=aligner(decalage+4*(int64_t)e->nb_places*sizeof(double));
+        e->decalage_noeuds=decalage;
+        decalage=aligner(decalage+e->nb_noeuds*(int64_t)sizeof(t_noeud_bvh));
+        e->decalage_murs_bvh=decalage;
+        decalage=aligner(decalage+e->nb_segments*(int64_t)sizeof(int));
+        e->decalage_segments=decalage;
+        decalage=aligner(decalage+e->nb_segments*(int64_t)sizeof(niv->tab_segments[0]));
+        e->decalage_murs_compiles=decalage;
+        decalage=aligner(decalage+e->nb_segments*(int64_t)sizeof(t_segment_compile));
+    }
+
+    memset(&entete,0,sizeof(entete));
+    strcpy(entete.signature,PAQUET_SIGNATURE);
+    entete.version=PAQUET_VERSION;
+    entete.ordre_octets=PAQUET_ORDRE_OCTETS;
+    entete.taille_noeud=sizeof(t_noeud_bvh);
+    entete.taille_mur=sizeof(t_segment_compile);
+    entete.largeur_simd=MURS_SIMD_LARGEUR;
+    entete.nb_niveaux=nb;
+    entete.taille_fichier=decalage;
+
+    // criture: en-tte, index puis tableaux de chaque niveau
+    fp=fopen(nom_fichier,"wb");
+    reussite=(fp!=NULL) && ecrire_bloc(fp,&position,0,&entete,sizeof(entete)) &&
+             ecrire_bloc(fp,&position,position,tab_entrees,nb*sizeof(t_index_paquet));
+    for (i=0;i<nb && reussite;i++){
+        niv=&tab_niveaux[i];
+        e=&tab_entrees[i];
+        // les 4 tableaux des murs rangs par coordonne se suivent en mmoire
+        reussite=ecrire_bloc(fp,&position,e->decalage_simd,niv->murs_simd->tab_ax,4*(size_t)e->nb_places*sizeof(double)) &&
+                 ecrire_bloc(fp,&position,e->decalage_noeuds,niv->bvh->tab_noeuds,e->nb_noeuds*sizeof(t_noeud_bvh)) &&
+                 ecrire_bloc(fp,&position,e->decalage_murs_bvh,niv->bvh->tab_murs,e->nb_segments*sizeof(int)) &&
+                 ecrire_bloc(fp,&position,e->decalage_segments,niv->tab_segments,e->nb_segments*sizeof(niv->tab_segments[0])) &&
+                 ecrire_bloc(fp,&position,e->decalage_murs_compiles,niv->tab_murs,e->nb_segments*sizeof(t_segment_compile));
+    }
+    reussite=reussite && ecrire_bloc(fp,&position,decalage,NULL,0);
+    if (fp!=NULL && fclose(fp)!=0) reussite=0;
+    if (!reussite) remove(nom_fichier);
+
+    for (i=0;i<nb;i++) liberer_niveau(&tab_niveaux[i]);
+    free(tab_niveaux);
+    free(tab_entrees);
+    return reussite?nb:-1;
+}
+
+// ---------------------------------------------
+/* fonction: bloc_valide
+    Description:    vrifie qu'un tableau du paquet est align et entirement dans le fichier
+    Paramtre(s):   decalage    position du tableau (octets)
+                    taille      taille du tableau (octets)
+    Retour:         1 si le tableau est valide, 0 sinon
+*/
+static int bloc_valide(int64_t decalage, int64_t taille)
+{
+    return decalage>=0 && taille>=0 && decalage%PAQUET_ALIGNEMENT==0 && decalage+taille<=(int64_t)taille_paquet;
+}
+
+// ---------------------------------------------
+/* fonction: arbre_valide
+    Description:    vrifie l'arbre des murs d'un niveau du paquet avant qu'il soit parcouru
+                    sur place: enfants de chaque noeud interne aprs lui dans le tableau
+                    (pas de cycle) et dans le tableau, profondeur infrieure 
+                    BVH_MAX_PROFONDEUR (taille de la pile de parcours), murs des feuilles
+                    dans le tableau des murs rangs et indices de ces murs valides
+    Paramtre(s):   e   entre de l'index du niveau (blocs dj vrifis par bloc_valide)
+    Retour:         1 si l'arbre peut tre parcouru, 0 sinon
+*/
+static int arbre_valide(const t_index_paquet* e)
+{
+    const t_noeud_bvh* tab_noeuds=(const t_noeud_bvh*)(paquet+e->decalage_noeuds);
+    const int* tab_murs=(const int*)(paquet+e->decalage_murs_bvh);
+    unsigned char* tab_profondeurs;     // profondeur de chaque noeud (racine: 0)
+    const t_noeud_bvh* n;
+    int i,valide=1;
+
+    for (i=0;i<e->nb_segments;i++){
+        if (tab_murs[i]<0 || tab_murs[i]>=e->nb_segments) return 0;
+    }
+    tab_profondeurs=(unsigned char*)calloc(e->nb_noeuds,1);
+    if (tab_profondeurs==NULL) return 0;
+    for (i=0;i<e->nb_noeuds && valide;i++){
+        n=&tab_noeuds[i];
+        if (n->nb_murs>0){
+            valide=(n->premier>=0 && n->premier<=e->nb_segments-n->nb_murs);
+        }
+        else{
+            valide=(n->nb_murs==0 && n->premier>i && n->premier<e->nb_noeuds-1 &&
+                    tab_profondeurs[i]<BVH_MAX_PROFONDEUR-1);
+            if (valide) tab_profondeurs[n->premier]=tab_profondeurs[n->premier+1]=tab_profondeurs[i]+1;
+        }
+    }
+    free(tab_profondeurs);
+    return valide;
+}
+
+// ---------------------------------------------
+/* fonction: paquet_valide
+    Description:    vrifie l'en-tte et l'index du paquet en mmoire: signature, version,
+                    compatibilit avec ce programme, position de chaque tableau et arbre
+                    des murs de chaque niveau (voir arbre_valide). Un paquet tronqu ou
+                    corrompu est ainsi refus  l'ouverture plutt que lu hors limites.
+    Paramtre(s):   aucun
+    Retour:         1 si le paquet peut tre utilis, 0 sinon
+*/
+static int paquet_valide()
+{
+    const t_entete_paquet* entete=(const t_entete_paquet*)paquet;
+    const t_index_paquet* e;
+    int i;
+
+    if (taille_paquet<sizeof(t_entete_paquet)) return 0;
+    if (memcmp(entete->signature,PAQUET_SIGNATURE,sizeof(entete->signature))!=0 ||
+        entete->version!=PAQUET_VERSION || entete->ordre_octets!=PAQUET_ORDRE_OCTETS ||
+        entete->taille_noeud!=(int32_t)sizeof(t_noeud_bvh) ||
+        entete->taille_mur!=(int32_t)sizeof(t_segment_compile) || entete->largeur_simd!=MURS_SIMD_LARGEUR ||
+        entete->taille_fichier!=(int64_t)taille_paquet ||
+        entete->nb_niveaux<0 ||
+        sizeof(t_entete_paquet)+entete->nb_niveaux*sizeof(t_index_paquet)>taille_paquet) return 0;
+
+    tab_index=(const t_index_paquet*)(paquet+sizeof(t_entete_paquet));
+    for (i=0;i<entete->nb_niveaux;i++){
+        e=&tab_index[i];
+        if (e->nb_segments<=0 ||
+            e->nb_places!=(e->nb_segments+MURS_SIMD_LARGEUR-1)/MURS_SIMD_LARGEUR*MURS_SIMD_LARGEUR ||
+            e->nb_noeuds<1 || e->nb_noeuds>2*e->nb_segments-1 ||
+            !bloc_valide(e->decalage_simd,4*(int64_t)e->nb_places*sizeof(double)) ||
+            !bloc_valide(e->decalage_noeuds,e->nb_noeuds*(int64_t)sizeof(t_noeud_bvh)) ||
+            !bloc_valide(e->decalage_murs_bvh,e->nb_segments*(int64_t)sizeof(int)) ||
+            !bloc_valide(e->decalage_segments,e->nb_segments*(int64_t)COL_TABSEG*sizeof(int)) ||
+            !bloc_valide(e->decalage_murs_compiles,e->nb_segments*(int64_t)sizeof(t_segment_compile)) ||
+            !arbre_valide(e)) return 0;
+    }
+    nb_niveaux_paquet=entete->nb_niveaux;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: verifier_sources
+    Description:    compare une seule fois l'empreinte de chaque fichier texte prsent 
+                    celle du fichier compil dans le paquet, et garde la date et la taille
+                    des fichiers inchangs: charger un niveau ne consulte ensuite que la
+                    date et la taille de son fichier (stat), sans le relire.
+    Paramtre(s):   aucun
+    Retour:         1 en cas de succs, 0 si la mmoire manque
+*/
+static int verifier_sources()
+{
+    char nom_source[MAX_CHAR];
+    t_version_fichier version;
+    int i;
+
+    tab_sources=(t_source_niveau*)malloc((nb_niveaux_paquet>0?nb_niveaux_paquet:1)*sizeof(t_source_niveau));
+    if (tab_sources==NULL) return 0;
+    for (i=0;i<nb_niveaux_paquet;i++){
+        nom_fichier_niveau(tab_index[i].niveau,FIN_NOM_FICHIER_NIVEAU,nom_source);
+        // version connue: celle du fichier compil (le contenu est toujours compar)
+        version.connue=1;
+        version.empreinte=tab_index[i].empreinte;
+        switch (fichier_modifie(nom_source,&version,1)){
+            case 0:
+                tab_sources[i].etat=SOURCE_A_JOUR;
+                tab_sources[i].date_modification=version.date_modification;
+                tab_sources[i].taille=version.taille;
+                break;
+            case 1:
+                tab_sources[i].etat=SOURCE_PERIMEE;
+                break;
+            default:
+                tab_sources[i].etat=SOURCE_ABSENTE;
+                break;
+        }
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: ouvrir_paquet_niveaux
+    Description:    projette le paquet de niveaux en mmoire (lecture seule) et vrifie son
+                    en-tte. Si la projection est impossible, le paquet est lu d'un bloc.
+                    Un paquet dj ouvert est d'abord ferm. Les fichiers texte des
+                    niveaux prsents sont relus une fois pour savoir s'ils ont t modifis
+                    depuis la compilation du paquet (voir charger_niveau_paquet).
+    Note:            appeler avant de lancer les fils d'excution qui chargent des niveaux
+    Paramtre(s):   nom_fichier     fichier du paquet
+    Retour:         le nb de niveaux du paquet, -1 si le paquet est absent ou invalide (les
+                    niveaux seront alors lus dans le dossier DOSSIER_NIVEAU)
+    Ex. d'utilisation:
+                    if (ouvrir_paquet_niveaux(FICHIER_PAQUET_NIVEAUX)<0) printf("niveaux lus un par un");
+*/
+int ouvrir_paquet_niveaux(const char* nom_fichier)
+{
+    FILE* fp;
+    long taille;
+    uintptr_t adresse;
+#if defined(_WIN32)
+    LARGE_INTEGER taille_fichier;
+#elif defined(PAQUET_MMAP)
+    struct stat infos;
+    void* projection;
+    int fd;
+#endif
+
+    fermer_paquet_niveaux();
+
+#if defined(_WIN32)
+    fichier_paquet=CreateFileA(nom_fichier,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+    if (fichier_paquet!=INVALID_HANDLE_VALUE && GetFileSizeEx(fichier_paquet,&taille_fichier) && taille_fichier.QuadPart>0){
+        projection_paquet=CreateFileMappingA(fichier_paquet,NULL,PAGE_READONLY,0,0,NULL);
+        if (projection_paquet!=NULL){
+            paquet=(const char*)MapViewOfFile(projection_paquet,FILE_MAP_READ,0,0,0);
+            taille_paquet=(size_t)taille_fichier.QuadPart;
+        }
+    }
+#elif defined(PAQUET_MMAP)
+    fd=open(nom_fichier,O_RDONLY);
+    if (fd>=0){
+        if (fstat(fd,&infos)==0 && infos.st_size>0){
+            projection=mmap(NULL,(size_t)infos.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+            if (projection!=MAP_FAILED){
+                paquet=(const char*)projection;
+                taille_paquet=(size_t)infos.st_size;
+            }
+        }
+        // la projection reste valide aprs la fermeture du fichier
+        close(fd);
+    }
+#endif
+
+    // sans projection: lire le paquet d'un bloc (align comme dans le fichier)
+    if (paquet==NULL){
+        fp=fopen(nom_fichier,"rb");
+        if (fp==NULL) return -1;
+        taille=-1;
+        if (fseek(fp,0,SEEK_END)==0) taille=ftell(fp);
+        if (taille>0 && fseek(fp,0,SEEK_SET)==0) memoire_paquet=malloc(taille+PAQUET_ALIGNEMENT);
+        if (memoire_paquet!=NULL){
+            adresse=((uintptr_t)memoire_paquet+PAQUET_ALIGNEMENT-1)&~(uintptr_t)(PAQUET_ALIGNEMENT-1);
+            if (fread((void*)adresse,1,taille,fp)==(size_t)taille){
+                paquet=(const char*)adresse;
+                taille_paquet=(size_t)taille;
+            }
+        }
+        fclose(fp);
+    }
+
+    if (paquet==NULL || !paquet_valide() || !verifier_sources()){
+        fermer_paquet_niveaux();
+        return -1;
+    }
+    return nb_niveaux_paquet;
+}
+
+// ---------------------------------------------
+/* fonction: paquet_niveaux_ouvert
+    Description:    indique si les niveaux sont chargs du paquet
+    Paramtre(s):   aucun
+    Retour:         1 si un paquet de niveaux est ouvert, 0 sinon
+*/
+int paquet_niveaux_ouvert()
+{
+    return paquet!=NULL;
+}
+
+// ---------------------------------------------
+/* fonction: charger_niveau_paquet
+    Description:    charge un niveau du paquet ouvert, sans dcodage: les segments, murs
+                    compils, lanceur et cible sont recopis dans niv et l'arbre des murs
+                    et les murs rangs par coordonne pointent dans le paquet (lecture
+                    seule, voir modifier_murs_niveau). La grille des murs est construite si
+                    niv->index_murs la demande.
+                    Si le fichier texte du niveau avait,  l'ouverture du paquet, une autre
+                    empreinte que le fichier compil, ou si sa date ou sa taille a chang
+                    depuis (niveau modifi), le niveau du paquet est prim et n'est pas
+                    charg. Le fichier n'est jamais relu ici: une rcriture de mme taille
+                    dans la seconde de l'ouverture n'est donc pas dtecte.
+    Paramtre(s):   niveau      # du niveau
+                    niv         niveau  remplir (ses donnes prcdentes sont libres)
+    Retour:         le nombre de segments de murs, ou -1 si le niveau n'est pas dans le
+                    paquet ou y est prim (ou si aucun paquet n'est ouvert)
+    Ex. d'utilisation:
+                    if (charger_niveau_paquet(3,&niv)<0) charger_niveau(3,&niv);
+*/
+int charger_niveau_paquet(int niveau, t_niveau* niv)
+{
+    const t_index_paquet* e=NULL;
+    const t_source_niveau* source=NULL;
+    t_bvh* bvh;
+    t_murs_simd* murs;
+    char nom_source[MAX_CHAR];
+    struct stat infos;
+    int i;
+
+    for (i=0;i<nb_niveaux_paquet && e==NULL;i++){
+        if (tab_index[i].niveau==niveau){
+            e=&tab_index[i];
+            source=&tab_sources[i];
+        }
+    }
+    if (e==NULL) return -1;
+
+    // niveau modifi depuis la compilation du paquet: le lire dans son fichier
+    if (source->etat==SOURCE_PERIMEE) return -1;
+    if (source->etat==SOURCE_A_JOUR){
+        nom_fichier_niveau(niveau,FIN_NOM_FICHIER_NIVEAU,nom_source);
+        if (stat(nom_source,&infos)==0 &&
+            (infos.st_mtime!=source->date_modification || (long)infos.st_size!=source->taille)) return -1;
+    }
+
+    // index des murs emprunts au paquet
+    bvh=(t_bvh*)calloc(1,sizeof(t_bvh));
+    murs=(niv->index_murs==INDEX_MURS_AUCUN)?(t_murs_simd*)calloc(1,sizeof(t_murs_simd)):NULL;
+    if (bvh==NULL || (niv->index_murs==INDEX_MURS_AUCUN && murs==NULL)){
+        free(bvh);
+        free(murs);
+        return -1;
+    }
+    bvh->nb_noeuds=e->nb_noeuds;
+    bvh->tab_noeuds=(t_noeud_bvh*)(paquet+e->decalage_noeuds);
+    bvh->nb_murs=e->nb_segments;
+    bvh->tab_murs=(int*)(paquet+e->decalage_murs_bvh);
+    bvh->emprunte=1;
+    if (murs!=NULL){
+        murs->nb_murs=e->nb_segments;
+        murs->nb_places=e->nb_places;
+        murs->tab_ax=(double*)(paquet+e->decalage_simd);
+        murs->tab_ay=murs->tab_ax+murs->nb_places;
+        murs->tab_ex=murs->tab_ay+murs->nb_places;
+        murs->tab_ey=murs->tab_ex+murs->nb_places;
+        murs->memoire=NULL;
+    }
+
+    liberer_niveau(niv);
+    if (!reserver_murs_niveau(niv,e->nb_segments)){
+        free(bvh);
+        free(murs);
+        return -1;
+    }
+    niv->nb_segments=e->nb_segments;
+    memcpy(niv->tab_segments,paquet+e->decalage_segments,e->nb_segments*sizeof(niv->tab_segments[0]));
+    memcpy(niv->tab_murs,paquet+e->decalage_murs_compiles,e->nb_segments*sizeof(t_segment_compile));
+    memcpy(niv->tab_lanceur,e->tab_lanceur,sizeof(niv->tab_lanceur));
+    memcpy(niv->tab_cible,e->tab_cible,sizeof(niv->tab_cible));
+    niv->bvh=bvh;
+    niv->murs_simd=murs;
+    if (niv->index_murs==INDEX_MURS_GRILLE) niv->grille=construire_grille(niv->tab_segments,niv->nb_segments);
+    return niv->nb_segments;
+}
+
+// ---------------------------------------------
+/* fonction: fermer_paquet_niveaux
+    Description:    ferme le paquet de niveaux; les niveaux chargs du paquet doivent tre
+                    librs avant (leurs index pointent dans le paquet)
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void fermer_paquet_niveaux()
+{
+    if (paquet!=NULL && memoire_paquet==NULL){
+#if defined(_WIN32)
+        UnmapViewOfFile(paquet);
+#elif defined(PAQUET_MMAP)
+        munmap((void*)paquet,taille_paquet);
+#endif
+    }
+#if defined(_WIN32)
+    if (projection_paquet!=NULL) CloseHandle(projection_paquet);
+    if (fichier_paquet!=INVALID_HANDLE_VALUE) CloseHandle(fichier_paquet);
+    projection_paquet=NULL;
+    fichier_paquet=INVALID_HANDLE_VALUE;
+#endif
+    free(memoire_paquet);
+    memoire_paquet=NULL;
+    free(tab_sources);
+    tab_sources=NULL;
+    paquet=NULL;
+    taille_paquet=0;
+    tab_index=NULL;
+    nb_niveaux_paquet=0;
+}
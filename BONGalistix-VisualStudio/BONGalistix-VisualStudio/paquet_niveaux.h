@@ -0,0 +1,57 @@
+#ifndef PAQUET_NIVEAUX_H
+#define PAQUET_NIVEAUX_H
+
+// -------------------------------------------
+/*
+librairie paquet_niveaux.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Paquet de niveaux compil: un seul fichier binaire contenant tous les niveaux
+             dj prpars,  dployer  la place du dossier des fichiers texte.
+             Le paquet est produit hors du jeu (outil  paquet  de BONGalistix-Outils) 
+             partir des fichiers de niveau. Il commence par un en-tte (signature, version,
+             tailles des structures) suivi d'un index d'une entre par niveau; les donnes
+             de chaque niveau sont ranges telles qu'elles sont utilises en mmoire:
+             - murs rangs par coordonne (voir murs_simd.h), complts et aligns
+             - noeuds et murs de l'arbre des murs (voir bvh.h)
+             - segments, murs compils (voir compiler_segment), lanceur et cible
+             Le jeu projette le paquet en mmoire (mmap, MapViewOfFile sous Windows) et
+             l'utilise sur place: charger un niveau ne lit ni ne dcode aucun fichier, les
+             index des murs pointent directement dans le paquet (lecture seule). Seuls les
+             segments et les murs compils sont recopis dans les tableaux du niveau.
+             Le nb de murs d'un niveau n'est pas limit.
+             Le paquet n'est valide que pour l'architecture qui l'a produit (taille des
+             structures et ordre des octets vrifis  l'ouverture); sinon les niveaux sont
+             lus dans le dossier des fichiers texte. L'ouverture vrifie aussi les indices
+             de chaque arbre des murs, qui est ensuite parcouru sans vrification.
+             L'index garde l'empreinte de chaque fichier texte compil: un niveau dont le
+             fichier a t modifi depuis est lu dans son fichier plutt que dans le
+             paquet (sans fichier texte  ct du jeu, le paquet est utilis tel quel).
+             Les fichiers texte ne sont relus qu' l'ouverture du paquet; au chargement
+             d'un niveau, seules leur date et leur taille sont compares (stat).
+Note: les implmentations des fonctions se trouvent dans le fichier paquet_niveaux.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// format du paquet
+// ---------------------------------------------
+#define FICHIER_PAQUET_NIVEAUX  "niveaux.paq"   // paquet de niveaux,  ct du dossier DOSSIER_NIVEAU
+#define PAQUET_SIGNATURE        "BONGPAQ"       // 8 premiers octets du fichier (avec le '\0')
+#define PAQUET_VERSION          4               // version du format ( changer si le format change)
+#define PAQUET_ORDRE_OCTETS     0x01020304      // valeur tmoin de l'ordre des octets
+#define PAQUET_ALIGNEMENT       32              // alignement des tableaux de chaque niveau (octets)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int compiler_paquet_niveaux(const char* nom_fichier, int premier, int dernier);
+int ouvrir_paquet_niveaux(const char* nom_fichier);
+int paquet_niveaux_ouvert();
+int charger_niveau_paquet(int niveau, t_niveau* niv);
+void fermer_paquet_niveaux();
+
+#endif // PAQUET_NIVEAUX_H
@@ -0,0 +1,178 @@
+// -------------------------------------------
+/*
+librairie prechargement.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Chargement d'un niveau  l'avance par un fil d'excution en arrire-plan.
+Note: les prototypes des fonctions se trouvent dans le fichier prechargement.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+
+// fil d'excution, smaphore et oprations atomiques de SDL
+#include <SDL_thread.h>
+#include <SDL_mutex.h>
+#include <SDL_atomic.h>
+
+#include "trace.h"
+#include "prechargement.h"
+
+#define AUCUNE_DEMANDE  (-1)
+
+// ---------------------------------------------
+// niveau prpar par le fil de prchargement
+// ---------------------------------------------
+typedef struct {
+    int niveau;         // # du niveau
+    t_niveau niv;       // niveau charg et prpar
+} t_niveau_precharge;
+
+static SDL_Thread* fil=NULL;                // fil de prchargement (NULL s'il n'est pas lanc)
+static SDL_sem* semaphore=NULL;             // rveille le fil  chaque demande
+static SDL_atomic_t demande;                // dernier niveau demand pas encore pris par le fil
+static SDL_atomic_t arret;                  // 1 pour terminer le fil
+static void* boite=NULL;                    // bote aux lettres: t_niveau_precharge prt ou NULL
+static int niveau_demande=AUCUNE_DEMANDE;   // dernier niveau demand (fil du jeu seulement)
+
+// ---------------------------------------------
+/* fonction: liberer_niveau_precharge
+    Description:    libre un niveau prpar
+    Paramtre(s):   precharge   niveau  librer (peut valoir NULL)
+    Retour:         aucun
+*/
+static void liberer_niveau_precharge(t_niveau_precharge* precharge)
+{
+    if (precharge==NULL) return;
+    liberer_niveau(&precharge->niv);
+    free(precharge);
+}
+
+// ---------------------------------------------
+/* fonction: fil_prechargement
+    Description:    fonction excute par le fil de prchargement: attend une demande,
+                    charge et prpare le niveau demand puis le dpose dans la bote aux
+                    lettres (le niveau qui s'y trouvait encore, pas pris, est libr).
+                    Si plusieurs demandes arrivent pendant un chargement, seule la
+                    dernire est traite.
+    Paramtre(s):   donnees     non utilis
+    Retour:         0
+*/
+static int fil_prechargement(void* donnees)
+{
+    t_niveau_precharge* precharge;
+    Uint64 debut;
+    int niveau;
+
+    (void)donnees;
+    trace_nommer_fil("prechargement");
+    while (1){
+        SDL_SemWait(semaphore);
+        if (SDL_AtomicGet(&arret)) break;
+        niveau=SDL_AtomicSet(&demande,AUCUNE_DEMANDE);
+        if (niveau==AUCUNE_DEMANDE) continue;
+
+        precharge=(t_niveau_precharge*)malloc(sizeof(t_niveau_precharge));
+        if (precharge==NULL) continue;
+        precharge->niveau=niveau;
+        initialiser_niveau(&precharge->niv);
+        // un chec de chargement est dpos aussi (nb_segments<0): le jeu le traitera
+        debut=trace_debut();
+        charger_niveau(niveau,&precharge->niv);
+        trace_fin("niveau","charger_niveau",debut,niveau);
+
+        liberer_niveau_precharge((t_niveau_precharge*)SDL_AtomicSetPtr(&boite,precharge));
+    }
+
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: demarrer_prechargement
+    Description:    lance le fil de prchargement
+    Paramtre(s):   aucun
+    Retour:         1 si le fil est lanc, 0 sinon (les niveaux seront alors chargs
+                    par le jeu lui-mme)
+    Ex. d'utilisation:
+                    demarrer_prechargement();
+*/
+int demarrer_prechargement()
+{
+    if (fil!=NULL) return 1;
+    semaphore=SDL_CreateSemaphore(0);
+    if (semaphore==NULL) return 0;
+    SDL_AtomicSet(&demande,AUCUNE_DEMANDE);
+    SDL_AtomicSet(&arret,0);
+    fil=SDL_CreateThread(fil_prechargement,"prechargement",NULL);
+    if (fil==NULL){
+        SDL_DestroySemaphore(semaphore);
+        semaphore=NULL;
+        return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: demander_prechargement
+    Description:    demande au fil de prchargement de charger un niveau (sans attendre).
+                    Une demande rpte du mme niveau est ignore tant que le niveau n'a
+                    pas t pris.
+    Paramtre(s):   niveau      # du niveau  charger
+    Retour:         aucun
+    Ex. d'utilisation:
+                    demander_prechargement(niveau+1);
+*/
+void demander_prechargement(int niveau)
+{
+    if (fil==NULL || niveau==niveau_demande) return;
+    niveau_demande=niveau;
+    SDL_AtomicSet(&demande,niveau);
+    SDL_SemPost(semaphore);
+}
+
+// ---------------------------------------------
+/* fonction: prendre_niveau_precharge
+    Description:    prend le niveau dpos dans la bote aux lettres s'il s'agit du niveau
+                    demand: il est chang avec le niveau donn, dont les donnes sont
+                    libres. Un autre niveau est laiss dans la bote.
+    Paramtre(s):   niveau      # du niveau voulu
+                    niv         niveau  remplacer
+    Retour:         1 si le niveau prcharg a t pris, 0 s'il n'est pas (encore) prt
+    Ex. d'utilisation:
+                    if (!prendre_niveau_precharge(niveau,&niv)) charger_niveau(niveau,&niv);
+*/
+int prendre_niveau_precharge(int niveau, t_niveau* niv)
+{
+    t_niveau_precharge* precharge=(t_niveau_precharge*)SDL_AtomicSetPtr(&boite,NULL);
+
+    if (precharge==NULL) return 0;
+    if (precharge->niveau!=niveau){
+        // le remettre, sauf si le fil en a dpos un plus rcent entre-temps
+        if (!SDL_AtomicCASPtr(&boite,NULL,precharge)) liberer_niveau_precharge(precharge);
+        return 0;
+    }
+    echanger_niveaux(niv,&precharge->niv);
+    liberer_niveau_precharge(precharge);
+    niveau_demande=AUCUNE_DEMANDE;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: arreter_prechargement
+    Description:    termine le fil de prchargement (aprs le chargement en cours) et
+                    libre le niveau qui n'a pas t pris
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void arreter_prechargement()
+{
+    if (fil==NULL) return;
+    SDL_AtomicSet(&arret,1);
+    SDL_SemPost(semaphore);
+    SDL_WaitThread(fil,NULL);
+    fil=NULL;
+    SDL_DestroySemaphore(semaphore);
+    semaphore=NULL;
+    liberer_niveau_precharge((t_niveau_precharge*)SDL_AtomicSetPtr(&boite,NULL));
+    niveau_demande=AUCUNE_DEMANDE;
+}
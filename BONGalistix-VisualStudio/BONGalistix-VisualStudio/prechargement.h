@@ -0,0 +1,34 @@
+#ifndef PRECHARGEMENT_H
+#define PRECHARGEMENT_H
+
+// -------------------------------------------
+/*
+librairie prechargement.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Chargement d'un niveau  l'avance par un fil d'excution en arrire-plan.
+             Le jeu demande le niveau qui suivra ds le dbut d'un niveau; le fil lit
+             le fichier et prpare le niveau (murs compils et index des
+             collisions, voir preparer_niveau) pendant la partie. Le niveau prt est
+             dpos dans une bote aux lettres  une seule place (un pointeur chang
+             de faon atomique, sans verrou): au changement de niveau, le jeu n'a qu'
+             changer son niveau avec celui de la bote.
+             Le dessin des murs (calque) reste fait par le fil de l'affichage: les
+             textures SDL ne peuvent tre cres que par le fil du renderer.
+             Le fil de prchargement est unique (variables de la librairie).
+Note: les implmentations des fonctions se trouvent dans le fichier prechargement.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int demarrer_prechargement();
+void demander_prechargement(int niveau);
+int prendre_niveau_precharge(int niveau, t_niveau* niv);
+void arreter_prechargement();
+
+#endif // PRECHARGEMENT_H
@@ -0,0 +1,217 @@
+// -------------------------------------------
+/*
+librairie profil.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Mesure du temps de chaque phase des images de la boucle de jeu.
+Note: les prototypes des fonctions se trouvent dans le fichier profil.h
+*/
+// -------------------------------------------
+
+#include <math.h>
+#include <SDL_timer.h>
+#include "profil.h"
+
+// temps processeur du processus
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define PROFIL_NB_SERIES    (PROFIL_NB_PHASES+1)    // les phases et l'image complte
+#define SERIE_IMAGE         PROFIL_NB_PHASES
+
+// ---------------------------------------------
+// histogramme glissant d'une srie de mesures
+// ---------------------------------------------
+typedef struct {
+    double tab_mesures[PROFIL_NB_IMAGES];   // dernires mesures (us), tableau circulaire
+    int tab_cases[PROFIL_NB_CASES];         // nb de mesures dans chaque case
+} t_serie_profil;
+
+static t_serie_profil tab_series[PROFIL_NB_SERIES];     // phases et image complte
+static Uint64 tab_debuts[PROFIL_NB_PHASES];     // compteur au dbut de la phase en cours
+static Uint64 tab_cumuls[PROFIL_NB_PHASES];     // temps cumul de chaque phase dans l'image en cours
+static Uint64 debut_image=0;                    // compteur  la fin de l'image prcdente
+static long nb_images=0;                        // nb d'images mesures depuis le dbut
+static Uint64 debut_profil=0;                   // compteur  la premire image
+static double processeur_debut=0;               // temps processeur (s)  la premire image
+
+// ---------------------------------------------
+/* fonction: temps_processeur
+    Description:    temps processeur utilis par le processus depuis son dmarrage (tous
+                    les fils d'excution, mode utilisateur et systme)
+    Paramtre(s):   aucun
+    Retour:         le temps processeur (s), 0 s'il n'est pas disponible
+*/
+static double temps_processeur()
+{
+#ifdef _WIN32
+    FILETIME creation,fin,systeme,utilisateur;
+
+    if (!GetProcessTimes(GetCurrentProcess(),&creation,&fin,&systeme,&utilisateur)) return 0;
+    // units de 100 ns
+    return ((((Uint64)systeme.dwHighDateTime<<32)|systeme.dwLowDateTime)+
+            (((Uint64)utilisateur.dwHighDateTime<<32)|utilisateur.dwLowDateTime))*1e-7;
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF,&usage)!=0) return 0;
+    return usage.ru_utime.tv_sec+usage.ru_utime.tv_usec*1e-6+
+           usage.ru_stime.tv_sec+usage.ru_stime.tv_usec*1e-6;
+#endif
+}
+
+// ---------------------------------------------
+/* fonction: case_profil
+    Description:    case de l'histogramme d'une mesure: PROFIL_CASES_OCTAVE cases par
+                    doublement  partir de 1 us (les extrmes vont dans la premire et
+                    la dernire case)
+    Paramtre(s):   us  mesure (us)
+    Retour:         l'indice de la case
+*/
+static int case_profil(double us)
+{
+    int c;
+
+    if (us<=1) return 0;
+    c=(int)(log2(us)*PROFIL_CASES_OCTAVE);
+    return (c<PROFIL_NB_CASES)?c:PROFIL_NB_CASES-1;
+}
+
+// ---------------------------------------------
+/* fonction: ajouter_mesure
+    Description:    ajoute une mesure  une srie; la mesure la plus ancienne sort de
+                    l'histogramme quand la srie contient PROFIL_NB_IMAGES mesures
+    Paramtre(s):   serie   srie de mesures
+                    us      mesure (us)
+    Retour:         aucun
+*/
+static void ajouter_mesure(t_serie_profil* serie, double us)
+{
+    int i=(int)(nb_images%PROFIL_NB_IMAGES);
+
+    if (nb_images>=PROFIL_NB_IMAGES) serie->tab_cases[case_profil(serie->tab_mesures[i])]--;
+    serie->tab_mesures[i]=us;
+    serie->tab_cases[case_profil(us)]++;
+}
+
+// ---------------------------------------------
+/* fonction: percentile_profil
+    Description:    percentile d'une srie, lu dans l'histogramme: limite suprieure de
+                    la case qui contient la mesure de ce rang
+    Paramtre(s):   serie   srie de mesures
+                    nb      nb de mesures dans la srie
+                    p       percentile (0  1)
+    Retour:         le percentile (us)
+*/
+static double percentile_profil(t_serie_profil* serie, int nb, double p)
+{
+    int rang=(int)ceil(p*nb),cumul=0,c;
+
+    if (rang<1) rang=1;
+    for (c=0;c<PROFIL_NB_CASES-1;c++){
+        cumul+=serie->tab_cases[c];
+        if (cumul>=rang) break;
+    }
+    return pow(2,(double)(c+1)/PROFIL_CASES_OCTAVE);
+}
+
+// ---------------------------------------------
+/* fonction: profil_debut
+    Description:    dbut d'une phase de l'image en cours
+    Paramtre(s):   phase   PROFIL_EVENEMENTS, PROFIL_LOGIQUE, PROFIL_DESSIN,
+                            PROFIL_PRESENTATION ou PROFIL_ATTENTE
+    Retour:         aucun
+    Ex. d'utilisation:
+                    profil_debut(PROFIL_PRESENTATION);
+                    graph_mise_a_jour();
+                    profil_fin(PROFIL_PRESENTATION);
+*/
+void profil_debut(int phase)
+{
+    tab_debuts[phase]=SDL_GetPerformanceCounter();
+}
+
+// ---------------------------------------------
+/* fonction: profil_fin
+    Description:    fin d'une phase: le temps coul depuis profil_debut est ajout au
+                    temps de la phase dans l'image en cours (une phase peut avoir lieu
+                    plusieurs fois par image)
+    Paramtre(s):   phase   phase termine
+    Retour:         aucun
+*/
+void profil_fin(int phase)
+{
+    tab_cumuls[phase]+=SDL_GetPerformanceCounter()-tab_debuts[phase];
+}
+
+// ---------------------------------------------
+/* fonction: profil_image
+    Description:    fin d'une image: ajoute le temps de chaque phase et le temps total de
+                    l'image (depuis l'appel prcdent) aux histogrammes
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void profil_image()
+{
+    Uint64 maintenant=SDL_GetPerformanceCounter();
+    double us_par_tic=1e6/SDL_GetPerformanceFrequency();
+    int phase;
+
+    if (debut_profil==0){
+        debut_profil=maintenant;
+        processeur_debut=temps_processeur();
+    }
+    if (debut_image!=0){
+        for (phase=0;phase<PROFIL_NB_PHASES;phase++){
+            ajouter_mesure(&tab_series[phase],tab_cumuls[phase]*us_par_tic);
+        }
+        ajouter_mesure(&tab_series[SERIE_IMAGE],(maintenant-debut_image)*us_par_tic);
+        nb_images++;
+    }
+    for (phase=0;phase<PROFIL_NB_PHASES;phase++) tab_cumuls[phase]=0;
+    debut_image=maintenant;
+}
+
+// ---------------------------------------------
+/* fonction: profil_resume
+    Description:    crit les percentiles (50, 95 et 99) et le maximum du temps de chaque
+                    phase et de l'image complte sur les dernires images (un percentile
+                    lu dans l'histogramme ne dpasse jamais le maximum mesur), puis
+                    l'utilisation moyenne du processeur depuis la premire image
+    Paramtre(s):   sortie  fichier o crire le rsum (ex: stdout)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    profil_resume(stdout);
+*/
+void profil_resume(FILE* sortie)
+{
+    const char* tab_noms[PROFIL_NB_SERIES]={"evenements","logique","dessin","presentation","attente","image"};
+    int nb=(nb_images<PROFIL_NB_IMAGES)?(int)nb_images:PROFIL_NB_IMAGES;
+    double max,duree;
+    int serie,i;
+
+    if (nb==0){
+        fprintf(sortie,"Profil: aucune image mesuree\n");
+        return;
+    }
+    fprintf(sortie,"Profil des %d dernieres images (%ld au total), temps en us:\n",nb,nb_images);
+    fprintf(sortie,"  %-12s %9s %9s %9s %9s\n","phase","p50","p95","p99","max");
+    for (serie=0;serie<PROFIL_NB_SERIES;serie++){
+        max=0;
+        for (i=0;i<nb;i++){
+            if (tab_series[serie].tab_mesures[i]>max) max=tab_series[serie].tab_mesures[i];
+        }
+        fprintf(sortie,"  %-12s %9.0lf %9.0lf %9.0lf %9.0lf\n",tab_noms[serie],
+                fmin(max,percentile_profil(&tab_series[serie],nb,0.50)),
+                fmin(max,percentile_profil(&tab_series[serie],nb,0.95)),
+                fmin(max,percentile_profil(&tab_series[serie],nb,0.99)),max);
+    }
+    duree=(double)(SDL_GetPerformanceCounter()-debut_profil)/SDL_GetPerformanceFrequency();
+    if (duree>0){
+        fprintf(sortie,"Processeur: %.1lf%% d'un coeur en moyenne sur %.1lf s\n",
+                100*(temps_processeur()-processeur_debut)/duree,duree);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef PROFIL_H
+#define PROFIL_H
+
+// -------------------------------------------
+/*
+librairie profil.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Mesure du temps de chaque phase des images de la boucle de jeu (compteur
+             haute prcision de SDL). Pendant une image, le temps pass entre
+             profil_debut et profil_fin est cumul pour chaque phase;  la fin de
+             l'image (profil_image), le temps de chaque phase et le temps total de
+             l'image sont ajouts  un histogramme glissant des PROFIL_NB_IMAGES
+             dernires images. Les cases de l'histogramme sont logarithmiques
+             (PROFIL_CASES_OCTAVE cases par doublement), d'o une prcision d'environ
+             9% sur les percentiles, obtenus sans trier les mesures.
+             Le rsum donne aussi l'utilisation du processeur par le programme (temps
+             processeur du processus sur le temps rel coul depuis la premire image).
+             Le profil est unique (variables de la librairie): une seule boucle de jeu.
+Note: les implmentations des fonctions se trouvent dans le fichier profil.c
+*/
+// -------------------------------------------
+
+#include <stdio.h>
+
+// ---------------------------------------------
+// phases d'une image
+// ---------------------------------------------
+#define PROFIL_EVENEMENTS       0   // lecture des vnements de la fentre
+#define PROFIL_LOGIQUE          1   // logique du mode de jeu et simulation du vol
+#define PROFIL_DESSIN           2   // tracs de l'affichage (afficher_elements)
+#define PROFIL_PRESENTATION     3   // mise  jour de la fentre (graph_mise_a_jour)
+#define PROFIL_ATTENTE          4   // attente des vnements quand rien ne change  l'cran
+#define PROFIL_NB_PHASES        5
+
+// ---------------------------------------------
+// paramtres des histogrammes
+// ---------------------------------------------
+#define PROFIL_NB_IMAGES        1000    // nb d'images de l'histogramme glissant
+#define PROFIL_CASES_OCTAVE     8       // nb de cases par doublement du temps
+#define PROFIL_NB_OCTAVES       24      // de 1 us  2^24 us (16 s)
+#define PROFIL_NB_CASES         (PROFIL_CASES_OCTAVE*PROFIL_NB_OCTAVES)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void profil_debut(int phase);
+void profil_fin(int phase);
+void profil_image();
+void profil_resume(FILE* sortie);
+
+#endif // PROFIL_H
@@ -0,0 +1,542 @@
+// -------------------------------------------
+/*
+librairie rechargement.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rechargement  chaud du niveau en cours par un fil d'excution en arrire-plan.
+Note: les prototypes des fonctions se trouvent dans le fichier rechargement.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// notifications de changement du systme de fichiers
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+// fil d'excution et oprations atomiques de SDL
+#include <SDL_thread.h>
+#include <SDL_timer.h>
+#include <SDL_atomic.h>
+
+#include "trace.h"
+#include "cache_niveau.h"
+#include "rechargement.h"
+
+// ---------------------------------------------
+// niveau surveill: copie des murs, du lanceur et de la cible du niveau en cours
+// (tenue  jour par le fil de rechargement  chaque modification)
+// ---------------------------------------------
+typedef struct {
+    int niveau;                                 // # du niveau
+    int generation;                             // gnration de la surveillance (voir surveiller_niveau)
+    int index_murs;                             // index spatial du niveau en cours (INDEX_MURS_...)
+    t_niveau_lu copie;                          // murs (dans l'ordre du niveau en cours), lanceur et cible
+    t_version_fichier version;                  // version du dernier fichier compar (voir fichier_modifie)
+} t_niveau_surveille;
+
+// ---------------------------------------------
+// modification  appliquer au niveau en cours
+// ---------------------------------------------
+typedef struct {
+    int generation;                             // gnration du niveau modifi
+    int complet;                                // 1 pour remplacer tout le niveau par niv
+    t_niveau niv;                               // niveau relu et prpar (modification complte)
+    int nb_murs;                                // nb de murs remplacs (modification incrmentale)
+    int* tab_indices;                           // indice de chaque mur remplac (nb_murs)
+    int (*tab_avant)[COL_TABSEG];               // segment de chaque mur remplac avant la modification
+    int (*tab_apres)[COL_TABSEG];               // segment de chaque mur remplac aprs la modification
+    int tab_lanceur[COL_TABLAN];                // lanceur relu
+    int tab_cible[COL_TABCIB];                  // cible relue
+} t_modification;
+
+// ---------------------------------------------
+// mur tri pour la comparaison de deux listes de murs
+// ---------------------------------------------
+typedef struct {
+    int seg[COL_TABSEG];    // segment du mur
+    int indice;             // indice du mur dans sa liste
+} t_mur_trie;
+
+static SDL_Thread* fil=NULL;        // fil de rechargement (NULL s'il n'est pas lanc)
+static SDL_atomic_t arret;          // 1 pour terminer le fil
+static void* boite_niveau=NULL;     // niveau  surveiller: t_niveau_surveille ou NULL (dpos par le jeu)
+static void* boite_modif=NULL;      // modification prte: t_modification ou NULL (dpose par le fil)
+static int generation=0;            // gnration du niveau surveill (fil du jeu seulement)
+
+// rsultat de l'attente d'un changement du dossier des niveaux
+#define CHANGEMENT_AUCUN    0       // dlai coul, aucun changement signal
+#define CHANGEMENT_POSSIBLE 1       // pas de notifications: le fichier doit tre vrifi
+#define CHANGEMENT_SIGNALE  2       // le systme a signal un changement dans le dossier
+
+#if defined(__linux__)
+static int surveillance=-1;         // descripteur inotify (-1 si absent)
+#elif defined(_WIN32)
+static HANDLE surveillance=INVALID_HANDLE_VALUE;    // notification de changement du dossier
+#endif
+
+// ---------------------------------------------
+/* fonction: ouvrir_surveillance
+    Description:    demande au systme d'exploitation de signaler les changements de
+                    fichiers du dossier des niveaux
+    Paramtre(s):   aucun
+    Retour:         1 si les changements seront signals, 0 sinon (le fichier du niveau
+                    sera alors vrifi  chaque RECHARGEMENT_DELAI_ATTENTE)
+*/
+static int ouvrir_surveillance()
+{
+#if defined(__linux__)
+    surveillance=inotify_init();
+    if (surveillance<0) return 0;
+    // fichier rcrit sur place ou remplac (les diteurs crivent souvent une copie puis la renomment)
+    if (inotify_add_watch(surveillance,DOSSIER_NIVEAU,IN_CLOSE_WRITE|IN_MOVED_TO|IN_CREATE)<0){
+        close(surveillance);
+        surveillance=-1;
+        return 0;
+    }
+    return 1;
+#elif defined(_WIN32)
+    surveillance=FindFirstChangeNotificationA(DOSSIER_NIVEAU,FALSE,
+                                              FILE_NOTIFY_CHANGE_LAST_WRITE|FILE_NOTIFY_CHANGE_SIZE|FILE_NOTIFY_CHANGE_FILE_NAME);
+    return surveillance!=INVALID_HANDLE_VALUE;
+#else
+    return 0;
+#endif
+}
+
+// ---------------------------------------------
+/* fonction: attendre_changement
+    Description:    attend un changement dans le dossier des niveaux, au plus
+                    RECHARGEMENT_DELAI_ATTENTE ms
+    Paramtre(s):   aucun
+    Retour:         CHANGEMENT_SIGNALE si le systme a signal un changement,
+                    CHANGEMENT_POSSIBLE sans notifications (aprs le dlai), CHANGEMENT_AUCUN
+                    si le dlai est coul sans changement
+*/
+static int attendre_changement()
+{
+#if defined(__linux__)
+    struct pollfd attente;
+    char tampon[4096];
+
+    if (surveillance>=0){
+        attente.fd=surveillance;
+        attente.events=POLLIN;
+        attente.revents=0;
+        if (poll(&attente,1,RECHARGEMENT_DELAI_ATTENTE)<=0) return CHANGEMENT_AUCUN;
+        // vider les vnements: le fichier du niveau est vrifi dans tous les cas
+        return (read(surveillance,tampon,sizeof(tampon))>0)?CHANGEMENT_SIGNALE:CHANGEMENT_AUCUN;
+    }
+#elif defined(_WIN32)
+    if (surveillance!=INVALID_HANDLE_VALUE){
+        if (WaitForSingleObject(surveillance,RECHARGEMENT_DELAI_ATTENTE)!=WAIT_OBJECT_0) return CHANGEMENT_AUCUN;
+        FindNextChangeNotification(surveillance);
+        return CHANGEMENT_SIGNALE;
+    }
+#endif
+    SDL_Delay(RECHARGEMENT_DELAI_ATTENTE);
+    return CHANGEMENT_POSSIBLE;
+}
+
+// ---------------------------------------------
+/* fonction: fermer_surveillance
+    Description:    arrte la surveillance du dossier des niveaux
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+static void fermer_surveillance()
+{
+#if defined(__linux__)
+    if (surveillance>=0) close(surveillance);
+    surveillance=-1;
+#elif defined(_WIN32)
+    if (surveillance!=INVALID_HANDLE_VALUE) FindCloseChangeNotification(surveillance);
+    surveillance=INVALID_HANDLE_VALUE;
+#endif
+}
+
+// ---------------------------------------------
+/* fonction: comparer_murs
+    Description:    ordre des murs pour qsort (coordonnes X0, Y0, X1 puis Y1)
+    Paramtre(s):   a,b     adresses de deux t_mur_trie
+    Retour:         <0, 0 ou >0 selon que a vient avant, avec ou aprs b
+*/
+static int comparer_murs(const void* a, const void* b)
+{
+    const int* seg_a=((const t_mur_trie*)a)->seg;
+    const int* seg_b=((const t_mur_trie*)b)->seg;
+    int i;
+
+    for (i=0;i<COL_TABSEG;i++){
+        if (seg_a[i]!=seg_b[i]) return (seg_a[i]<seg_b[i])?-1:1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: trier_murs
+    Description:    copie une liste de murs avec leurs indices et la trie
+    Paramtre(s):   tab_segments    segments de murs
+                    nb_segments     nb de segments
+                    tab_tries       tableau  remplir avec les murs tris
+    Retour:         aucun
+*/
+static void trier_murs(int tab_segments[][COL_TABSEG], int nb_segments, t_mur_trie tab_tries[])
+{
+    int i;
+
+    for (i=0;i<nb_segments;i++){
+        memcpy(tab_tries[i].seg,tab_segments[i],sizeof(tab_tries[i].seg));
+        tab_tries[i].indice=i;
+    }
+    qsort(tab_tries,nb_segments,sizeof(t_mur_trie),comparer_murs);
+}
+
+// ---------------------------------------------
+/* fonction: liberer_modification
+    Description:    libre une modification
+    Paramtre(s):   modif   modification  librer (peut valoir NULL)
+    Retour:         aucun
+*/
+static void liberer_modification(t_modification* modif)
+{
+    if (modif==NULL) return;
+    free(modif->tab_indices);
+    free(modif->tab_avant);
+    free(modif->tab_apres);
+    liberer_niveau(&modif->niv);
+    free(modif);
+}
+
+// ---------------------------------------------
+/* fonction: liberer_surveille
+    Description:    libre un niveau surveill
+    Paramtre(s):   base    niveau surveill  librer (peut valoir NULL)
+    Retour:         aucun
+*/
+static void liberer_surveille(t_niveau_surveille* base)
+{
+    if (base==NULL) return;
+    liberer_niveau_lu(&base->copie);
+    free(base);
+}
+
+// ---------------------------------------------
+/* fonction: preparer_modification
+    Description:    prpare la modification qui rend le niveau en cours identique au
+                    niveau relu et met  jour la copie surveille en consquence: chaque mur
+                    retir est remplac par un mur ajout si leurs nombres sont gaux, sinon
+                    tout le niveau relu est prpar ici plutt que dans le fil du jeu
+    Paramtre(s):   base            niveau surveill
+                    lu              niveau relu (ses murs passent au niveau prpar si tout
+                                    le niveau est remplac)
+                    tab_retires     indices (dans la copie surveille) des murs retirs
+                    nb_retires      nb de murs retirs
+                    tab_ajoutes     indices (dans lu) des murs ajouts
+                    nb_ajoutes      nb de murs ajouts
+    Retour:         la modification, ou NULL en cas d'erreur d'allocation (la copie
+                    surveille est alors inchange)
+*/
+static t_modification* preparer_modification(t_niveau_surveille* base, t_niveau_lu* lu,
+                                             int tab_retires[], int nb_retires,
+                                             int tab_ajoutes[], int nb_ajoutes)
+{
+    t_niveau_lu* copie=&base->copie;
+    t_modification* modif;
+    int k;
+
+    modif=(t_modification*)calloc(1,sizeof(t_modification));
+    if (modif==NULL) return NULL;
+    modif->generation=base->generation;
+    memcpy(modif->tab_lanceur,lu->tab_lanceur,sizeof(modif->tab_lanceur));
+    memcpy(modif->tab_cible,lu->tab_cible,sizeof(modif->tab_cible));
+    initialiser_niveau(&modif->niv);
+
+    if (nb_retires==nb_ajoutes){
+        // mme nb de murs: remplacer chaque mur retir par un mur ajout
+        modif->complet=0;
+        modif->tab_indices=(int*)malloc((nb_retires+1)*sizeof(int));
+        modif->tab_avant=(int (*)[COL_TABSEG])malloc((nb_retires+1)*sizeof(modif->tab_avant[0]));
+        modif->tab_apres=(int (*)[COL_TABSEG])malloc((nb_retires+1)*sizeof(modif->tab_apres[0]));
+        if (modif->tab_indices==NULL || modif->tab_avant==NULL || modif->tab_apres==NULL){
+            liberer_modification(modif);
+            return NULL;
+        }
+        for (k=0;k<nb_retires;k++){
+            modif->tab_indices[k]=tab_retires[k];
+            memcpy(modif->tab_avant[k],copie->tab_segments[tab_retires[k]],sizeof(modif->tab_avant[k]));
+            memcpy(modif->tab_apres[k],lu->tab_segments[tab_ajoutes[k]],sizeof(modif->tab_apres[k]));
+            memcpy(copie->tab_segments[tab_retires[k]],lu->tab_segments[tab_ajoutes[k]],sizeof(copie->tab_segments[0]));
+        }
+        modif->nb_murs=nb_retires;
+    }
+    else{
+        // nb de murs diffrent: prparer tout le niveau (la copie est agrandie avant, pour
+        // ne la modifier qu'une fois le niveau prpar)
+        modif->complet=1;
+        modif->niv.index_murs=base->index_murs;
+        if (!reserver_niveau_lu(copie,lu->nb_segments) || installer_niveau_lu(&modif->niv,lu)<0 ||
+            !preparer_niveau(&modif->niv)){
+            liberer_modification(modif);
+            return NULL;
+        }
+        copie->nb_segments=modif->niv.nb_segments;
+        memcpy(copie->tab_segments,modif->niv.tab_segments,copie->nb_segments*sizeof(copie->tab_segments[0]));
+    }
+    memcpy(copie->tab_lanceur,modif->tab_lanceur,sizeof(copie->tab_lanceur));
+    memcpy(copie->tab_cible,modif->tab_cible,sizeof(copie->tab_cible));
+    return modif;
+}
+
+// ---------------------------------------------
+/* fonction: comparer_niveau
+    Description:    relit le fichier du niveau surveill s'il a chang depuis la dernire
+                    comparaison, prpare la modification qui rend le niveau en cours
+                    identique au fichier et met  jour la copie surveille en consquence
+                    (voir preparer_modification). Les tableaux de travail sont allous  la
+                    taille des deux niveaux compars.
+    Note:           les murs inchangs sont trouvs en parcourant ensemble les deux listes
+                    tries; les murs retirs sont remplacs par les murs ajouts dans l'ordre
+    Paramtre(s):   base                niveau surveill
+                    verifier_contenu    1 pour comparer l'empreinte du contenu du fichier mme
+                                        si sa date et sa taille n'ont pas chang (changement
+                                        signal: une criture dans la mme seconde garde la date)
+    Retour:         la modification  dposer, ou NULL si le niveau n'a pas chang (ou si
+                    le fichier ne peut tre lu pour l'instant)
+*/
+static t_modification* comparer_niveau(t_niveau_surveille* base, int verifier_contenu)
+{
+    char nom_fichier[MAX_CHAR];
+    t_niveau_lu lu;                     // niveau relu
+    t_niveau_lu* copie=&base->copie;    // copie surveille du niveau en cours
+    t_mur_trie* tab_anciens;            // murs de la copie, tris
+    t_mur_trie* tab_nouveaux;           // murs relus, tris
+    int* tab_retires;                   // indices (dans la copie) des murs retirs
+    int* tab_ajoutes;                   // indices (dans le fichier) des murs ajouts
+    int nb_retires=0,nb_ajoutes=0;
+    int nb,i,j,ordre;
+    t_modification* modif=NULL;
+    Uint64 debut;
+
+    nom_fichier_niveau(base->niveau,FIN_NOM_FICHIER_NIVEAU,nom_fichier);
+    // la version est mise  jour avant la lecture: un fichier illisible (ex: en cours
+    // d'criture) n'est relu qu'au prochain changement
+    if (fichier_modifie(nom_fichier,&base->version,verifier_contenu)!=1) return NULL;
+
+    debut=trace_debut();
+    initialiser_niveau_lu(&lu);
+    nb=lire_niveau_cache(base->niveau,&lu);
+    if (nb<0){
+        liberer_niveau_lu(&lu);
+        trace_fin("niveau","relire_niveau",debut,base->niveau);
+        return NULL;
+    }
+
+    tab_anciens=(t_mur_trie*)malloc((copie->nb_segments+1)*sizeof(t_mur_trie));
+    tab_nouveaux=(t_mur_trie*)malloc((nb+1)*sizeof(t_mur_trie));
+    tab_retires=(int*)malloc((copie->nb_segments+1)*sizeof(int));
+    tab_ajoutes=(int*)malloc((nb+1)*sizeof(int));
+    if (tab_anciens!=NULL && tab_nouveaux!=NULL && tab_retires!=NULL && tab_ajoutes!=NULL){
+        // murs retirs et ajouts
+        trier_murs(copie->tab_segments,copie->nb_segments,tab_anciens);
+        trier_murs(lu.tab_segments,nb,tab_nouveaux);
+        i=j=0;
+        while (i<copie->nb_segments || j<nb){
+            if (i==copie->nb_segments) ordre=1;
+            else if (j==nb) ordre=-1;
+            else ordre=comparer_murs(&tab_anciens[i],&tab_nouveaux[j]);
+            if (ordre<0) tab_retires[nb_retires++]=tab_anciens[i++].indice;
+            else if (ordre>0) tab_ajoutes[nb_ajoutes++]=tab_nouveaux[j++].indice;
+            else{
+                i++;
+                j++;
+            }
+        }
+        if (nb_retires!=0 || nb_ajoutes!=0 ||
+            memcmp(lu.tab_lanceur,copie->tab_lanceur,sizeof(lu.tab_lanceur))!=0 ||
+            memcmp(lu.tab_cible,copie->tab_cible,sizeof(lu.tab_cible))!=0){
+            modif=preparer_modification(base,&lu,tab_retires,nb_retires,tab_ajoutes,nb_ajoutes);
+        }
+    }
+    free(tab_anciens);
+    free(tab_nouveaux);
+    free(tab_retires);
+    free(tab_ajoutes);
+    liberer_niveau_lu(&lu);
+    trace_fin("niveau","relire_niveau",debut,base->niveau);
+    return modif;
+}
+
+// ---------------------------------------------
+/* fonction: fil_rechargement
+    Description:    fonction excute par le fil de rechargement: attend un changement du
+                    dossier des niveaux ou un nouveau niveau  surveiller, puis compare le
+                    fichier du niveau surveill. Une modification n'est dpose que si la
+                    bote aux lettres est vide: les modifications sont ainsi appliques dans
+                    l'ordre o elles ont t prpares (sinon la comparaison est reporte).
+    Paramtre(s):   donnees     non utilis
+    Retour:         0
+*/
+static int fil_rechargement(void* donnees)
+{
+    t_niveau_surveille* base=NULL;      // niveau surveill (NULL: aucun)
+    t_niveau_surveille* nouveau;
+    t_modification* modif;
+    int a_comparer=0;                   // 1 si le fichier doit tre compar
+    int signale=0;                      // 1 si un changement a t signal depuis la dernire comparaison
+    int changement;
+
+    (void)donnees;
+    trace_nommer_fil("rechargement");
+    while (!SDL_AtomicGet(&arret)){
+        changement=attendre_changement();
+        if (changement!=CHANGEMENT_AUCUN) a_comparer=1;
+        if (changement==CHANGEMENT_SIGNALE) signale=1;
+        nouveau=(t_niveau_surveille*)SDL_AtomicSetPtr(&boite_niveau,NULL);
+        if (nouveau!=NULL){
+            liberer_surveille(base);
+            base=nouveau;
+            a_comparer=1;
+        }
+        if (base==NULL || !a_comparer || SDL_AtomicGetPtr(&boite_modif)!=NULL) continue;
+
+        a_comparer=0;
+        modif=comparer_niveau(base,signale);
+        signale=0;
+        if (modif!=NULL && !SDL_AtomicCASPtr(&boite_modif,NULL,modif)) liberer_modification(modif);
+    }
+    liberer_surveille(base);
+
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: demarrer_rechargement
+    Description:    lance le fil de rechargement  chaud
+    Paramtre(s):   aucun
+    Retour:         1 si le fil est lanc, 0 sinon (les niveaux ne seront pas rechargs)
+    Ex. d'utilisation:
+                    demarrer_rechargement();
+*/
+int demarrer_rechargement()
+{
+    if (fil!=NULL) return 1;
+    ouvrir_surveillance();
+    SDL_AtomicSet(&arret,0);
+    fil=SDL_CreateThread(fil_rechargement,"rechargement",NULL);
+    if (fil==NULL){
+        fermer_surveillance();
+        return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: surveiller_niveau
+    Description:    indique au fil de rechargement le niveau qui vient d'tre charg: une
+                    copie de ses murs, de son lanceur et de sa cible sert de rfrence aux
+                    comparaisons. Les modifications prpares pour le niveau prcdent
+                    seront ignores.
+    Note:            appeler juste aprs le chargement, avant que le lanceur suive la souris
+    Paramtre(s):   niveau      # du niveau charg
+                    niv         niveau charg et prpar
+    Retour:         aucun
+    Ex. d'utilisation:
+                    if (charger_niveau(niveau,&niv)>=0) surveiller_niveau(niveau,&niv);
+*/
+void surveiller_niveau(int niveau, t_niveau* niv)
+{
+    t_niveau_surveille* base;
+
+    generation++;
+    if (fil==NULL) return;
+    base=(t_niveau_surveille*)malloc(sizeof(t_niveau_surveille));
+    if (base==NULL) return;
+    base->niveau=niveau;
+    base->generation=generation;
+    base->index_murs=niv->index_murs;
+    initialiser_niveau_lu(&base->copie);
+    if (!reserver_niveau_lu(&base->copie,niv->nb_segments)){
+        liberer_surveille(base);
+        return;
+    }
+    base->copie.nb_segments=niv->nb_segments;
+    memcpy(base->copie.tab_segments,niv->tab_segments,niv->nb_segments*sizeof(niv->tab_segments[0]));
+    memcpy(base->copie.tab_lanceur,niv->tab_lanceur,sizeof(base->copie.tab_lanceur));
+    memcpy(base->copie.tab_cible,niv->tab_cible,sizeof(base->copie.tab_cible));
+    // le fichier peut avoir chang depuis le chargement (ex: niveau prcharg): le comparer une fois
+    base->version.connue=0;
+    liberer_surveille((t_niveau_surveille*)SDL_AtomicSetPtr(&boite_niveau,base));
+}
+
+// ---------------------------------------------
+/* fonction: appliquer_rechargement
+    Description:    applique au niveau en cours la modification prpare par le fil de
+                    rechargement, s'il y en a une
+    Paramtre(s):   niv         niveau en cours (celui pass au dernier surveiller_niveau)
+                    complet     adresse o placer 1 si tout le niveau a t remplac, 0 si
+                                seuls des murs, le lanceur ou la cible ont chang
+                    tab_zone    tableau  remplir avec le rectangle englobant les murs
+                                remplacs, avant et aprs (x1,y1,x2,y2; x1>x2 si aucun mur)
+    Retour:         1 si le niveau a t modifi, 0 sinon
+    Ex. d'utilisation:
+                    if (appliquer_rechargement(&niv,&complet,tab_zone) && complet) calque_invalider(&calque_murs);
+*/
+int appliquer_rechargement(t_niveau* niv, int* complet, int tab_zone[4])
+{
+    t_modification* modif=(t_modification*)SDL_AtomicSetPtr(&boite_modif,NULL);
+    int i;
+
+    if (modif==NULL) return 0;
+    if (modif->generation!=generation){
+        liberer_modification(modif);
+        return 0;
+    }
+
+    tab_zone[0]=tab_zone[1]=INT_MAX;
+    tab_zone[2]=tab_zone[3]=INT_MIN;
+    *complet=modif->complet;
+    if (modif->complet) echanger_niveaux(niv,&modif->niv);
+    else{
+        for (i=0;i<modif->nb_murs;i++){
+            tab_zone[0]=SDL_min(tab_zone[0],SDL_min(SDL_min(modif->tab_avant[i][X0],modif->tab_avant[i][X1]),
+                                                    SDL_min(modif->tab_apres[i][X0],modif->tab_apres[i][X1])));
+            tab_zone[1]=SDL_min(tab_zone[1],SDL_min(SDL_min(modif->tab_avant[i][Y0],modif->tab_avant[i][Y1]),
+                                                    SDL_min(modif->tab_apres[i][Y0],modif->tab_apres[i][Y1])));
+            tab_zone[2]=SDL_max(tab_zone[2],SDL_max(SDL_max(modif->tab_avant[i][X0],modif->tab_avant[i][X1]),
+                                                    SDL_max(modif->tab_apres[i][X0],modif->tab_apres[i][X1])));
+            tab_zone[3]=SDL_max(tab_zone[3],SDL_max(SDL_max(modif->tab_avant[i][Y0],modif->tab_avant[i][Y1]),
+                                                    SDL_max(modif->tab_apres[i][Y0],modif->tab_apres[i][Y1])));
+        }
+        if (!modifier_murs_niveau(niv,modif->nb_murs,modif->tab_indices,modif->tab_apres)) preparer_niveau(niv);
+        memcpy(niv->tab_lanceur,modif->tab_lanceur,sizeof(niv->tab_lanceur));
+        memcpy(niv->tab_cible,modif->tab_cible,sizeof(niv->tab_cible));
+    }
+    liberer_modification(modif);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: arreter_rechargement
+    Description:    termine le fil de rechargement et libre la modification qui n'a pas
+                    t applique
+    Paramtre(s):   aucun
+    Retour:         aucun
+*/
+void arreter_rechargement()
+{
+    if (fil==NULL) return;
+    SDL_AtomicSet(&arret,1);
+    SDL_WaitThread(fil,NULL);
+    fil=NULL;
+    fermer_surveillance();
+    liberer_surveille((t_niveau_surveille*)SDL_AtomicSetPtr(&boite_niveau,NULL));
+    liberer_modification((t_modification*)SDL_AtomicSetPtr(&boite_modif,NULL));
+}
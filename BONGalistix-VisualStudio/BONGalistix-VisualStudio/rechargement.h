@@ -0,0 +1,47 @@
+#ifndef RECHARGEMENT_H
+#define RECHARGEMENT_H
+
+// -------------------------------------------
+/*
+librairie rechargement.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rechargement  chaud du niveau en cours: un fil d'excution surveille le
+             dossier des niveaux (inotify sous Linux, notifications de changement sous
+             Windows, sinon consultation priodique) et relit le fichier du niveau jou
+             ds qu'il est modifi, sans bloquer la partie.
+             Le fil compare les murs relus  ceux du niveau en mmoire (comparaison des
+             listes tries, l'ordre des murs dans le fichier n'a pas d'importance) et
+             prpare une modification:
+             - incrmentale si le nb de murs ne change pas: seuls les murs ajouts,
+               retirs ou dplacs sont remplacs, et les index des collisions sont mis
+                jour sans tre reconstruits (voir modifier_murs_niveau);
+             - complte sinon: le niveau relu est prpar par le fil puis chang avec
+               le niveau en cours.
+             La modification est dpose dans une bote aux lettres  une seule place
+             (pointeur chang de faon atomique); le jeu l'applique au dbut d'un tour
+             de boucle. Une modification prpare pour un niveau qui n'est plus jou est
+             ignore (chaque niveau surveill a son numro de gnration).
+             Le fil de rechargement est unique (variables de la librairie).
+Note: les implmentations des fonctions se trouvent dans le fichier rechargement.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// ---------------------------------------------
+// dlais de la surveillance
+// ---------------------------------------------
+#define RECHARGEMENT_DELAI_ATTENTE      100     // attente maximale d'une notification (ms) avant de vrifier l'arrt
+#define RECHARGEMENT_DELAI_SCRUTATION   500     // dlai entre deux vrifications du fichier sans notifications (ms)
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int demarrer_rechargement();
+void surveiller_niveau(int niveau, t_niveau* niv);
+int appliquer_rechargement(t_niveau* niv, int* complet, int tab_zone[4]);
+void arreter_rechargement();
+
+#endif // RECHARGEMENT_H
@@ -0,0 +1,236 @@
+// -------------------------------------------
+/*
+librairie redessin.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Redessin partiel de l'affichage (zones modifies).
+Note: les prototypes des fonctions se trouvent dans le fichier redessin.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include "redessin.h"
+
+// ---------------------------------------------
+/* fonction: initialiser_redessin
+    Description:    prpare le suivi des zones; le premier affichage redessine tout
+    Paramtre(s):   redessin        suivi  initialiser
+                    largeur,hauteur taille de la fentre
+    Retour:         aucun
+    Ex. d'utilisation:
+                    initialiser_redessin(&redessin,LARGEUR_FEN,HAUTEUR_FEN);
+*/
+void initialiser_redessin(t_redessin* redessin, int largeur, int hauteur)
+{
+    int i;
+
+    initialiser_calque(&redessin->scene,largeur,hauteur);
+    redessin->largeur=largeur;
+    redessin->hauteur=hauteur;
+    redessin->tout=1;
+    redessin->nb_zones=0;
+    for (i=0;i<REDESSIN_MAX_ELEMENTS;i++) redessin->tab_visibles[i]=0;
+}
+
+// ---------------------------------------------
+/* fonction: redessin_tout
+    Description:    demande de redessiner toute la scne au prochain affichage
+                    (ex: un lment fixe comme les murs a chang)
+    Paramtre(s):   redessin    suivi des zones
+    Retour:         aucun
+*/
+void redessin_tout(t_redessin* redessin)
+{
+    redessin->tout=1;
+}
+
+// ---------------------------------------------
+/* fonction: ajouter_zone
+    Description:    ajoute une zone  redessiner, agrandie de REDESSIN_MARGE et limite 
+                    la fentre. Une zone qui touche une zone existante y est fusionne
+                    (la zone fusionne peut  son tour en toucher une autre).
+    Paramtre(s):   redessin        suivi des zones
+                    tab_boite       zone  ajouter (x1,y1,x2,y2)
+    Retour:         aucun
+*/
+static void ajouter_zone(t_redessin* redessin, int tab_boite[])
+{
+    int z[4],i,fusion;
+
+    if (redessin->tout) return;
+    z[0]=SDL_max(0,tab_boite[0]-REDESSIN_MARGE);
+    z[1]=SDL_max(0,tab_boite[1]-REDESSIN_MARGE);
+    z[2]=SDL_min(redessin->largeur-1,tab_boite[2]+REDESSIN_MARGE);
+    z[3]=SDL_min(redessin->hauteur-1,tab_boite[3]+REDESSIN_MARGE);
+    if (z[0]>z[2] || z[1]>z[3]) return;     // hors de la fentre
+
+    do{
+        fusion=0;
+        for (i=0;i<redessin->nb_zones;i++){
+            if (z[0]>redessin->tab_zones[i][2]+1 || z[2]<redessin->tab_zones[i][0]-1 ||
+                z[1]>redessin->tab_zones[i][3]+1 || z[3]<redessin->tab_zones[i][1]-1) continue;
+            z[0]=SDL_min(z[0],redessin->tab_zones[i][0]);
+            z[1]=SDL_min(z[1],redessin->tab_zones[i][1]);
+            z[2]=SDL_max(z[2],redessin->tab_zones[i][2]);
+            z[3]=SDL_max(z[3],redessin->tab_zones[i][3]);
+            // retirer la zone fusionne (remplace par la dernire)
+            redessin->nb_zones--;
+            redessin->tab_zones[i][0]=redessin->tab_zones[redessin->nb_zones][0];
+            redessin->tab_zones[i][1]=redessin->tab_zones[redessin->nb_zones][1];
+            redessin->tab_zones[i][2]=redessin->tab_zones[redessin->nb_zones][2];
+            redessin->tab_zones[i][3]=redessin->tab_zones[redessin->nb_zones][3];
+            fusion=1;
+            break;
+        }
+    } while (fusion);
+
+    if (redessin->nb_zones==REDESSIN_MAX_ZONES){
+        redessin->tout=1;
+        return;
+    }
+    for (i=0;i<4;i++) redessin->tab_zones[redessin->nb_zones][i]=z[i];
+    redessin->nb_zones++;
+}
+
+// ---------------------------------------------
+/* fonction: redessin_element
+    Description:    donne l'tat d'un lment pour le prochain affichage. Si sa visibilit
+                    ou sa bote a chang depuis le dernier affichage, l'ancienne bote et la
+                    nouvelle sont  redessiner.
+    Paramtre(s):   redessin        suivi des zones
+                    element         numro de l'lment (0  REDESSIN_MAX_ELEMENTS-1)
+                    visible         1 si l'lment est affich, 0 sinon
+                    x1,y1,x2,y2     bote englobante de l'lment (coin infrieur gauche
+                                    et suprieur droit)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    redessin_element(&redessin,0,1,tab_cible[X0],tab_cible[Y0],tab_cible[X1],tab_cible[Y1]);
+*/
+void redessin_element(t_redessin* redessin, int element, int visible, int x1, int y1, int x2, int y2)
+{
+    int* tab_boite=redessin->tab_boites[element];
+    int tab_nouvelle[4];
+
+    tab_nouvelle[0]=SDL_min(x1,x2);
+    tab_nouvelle[1]=SDL_min(y1,y2);
+    tab_nouvelle[2]=SDL_max(x1,x2);
+    tab_nouvelle[3]=SDL_max(y1,y2);
+    visible=(visible!=0);
+
+    if (visible==redessin->tab_visibles[element] && (!visible ||
+        (tab_boite[0]==tab_nouvelle[0] && tab_boite[1]==tab_nouvelle[1] &&
+         tab_boite[2]==tab_nouvelle[2] && tab_boite[3]==tab_nouvelle[3]))) return;
+
+    if (redessin->tab_visibles[element]) ajouter_zone(redessin,tab_boite);
+    if (visible) ajouter_zone(redessin,tab_nouvelle);
+    redessin->tab_visibles[element]=visible;
+    tab_boite[0]=tab_nouvelle[0];
+    tab_boite[1]=tab_nouvelle[1];
+    tab_boite[2]=tab_nouvelle[2];
+    tab_boite[3]=tab_nouvelle[3];
+}
+
+// ---------------------------------------------
+/* fonction: redessin_zone_modifiee
+    Description:    ajoute une zone  redessiner au prochain affichage, pour un changement
+                     l'intrieur d'un lment dont la bote ne change pas (ex: murs
+                    modifis dans le calque des murs)
+    Paramtre(s):   redessin        suivi des zones
+                    x1,y1,x2,y2     coins infrieur gauche et suprieur droit de la zone
+    Retour:         aucun
+*/
+void redessin_zone_modifiee(t_redessin* redessin, int x1, int y1, int x2, int y2)
+{
+    int tab_boite[4];
+
+    tab_boite[0]=SDL_min(x1,x2);
+    tab_boite[1]=SDL_min(y1,y2);
+    tab_boite[2]=SDL_max(x1,x2);
+    tab_boite[3]=SDL_max(y1,y2);
+    ajouter_zone(redessin,tab_boite);
+}
+
+// ---------------------------------------------
+/* fonction: redessin_debut
+    Description:    commence le redessin des zones modifies dans la scne
+    Paramtre(s):   redessin    suivi des zones
+    Retour:         le nb de zones  redessiner (voir redessin_zone) puis terminer avec
+                    redessin_fin; 0 si rien n'a chang (ne rien dessiner ni afficher);
+                    -1 si le redessin partiel est impossible (tout dessiner dans la fentre)
+    Ex. d'utilisation:
+                    nb_zones=redessin_debut(&redessin);
+                    for (i=0;i<nb_zones;i++){
+                        redessin_zone(&redessin,i,0,0,0,255);
+                        ... tracer tous les lments ...
+                    }
+                    if (nb_zones>0) redessin_fin(&redessin);
+*/
+int redessin_debut(t_redessin* redessin)
+{
+    if (!calque_pret(&redessin->scene)) redessin->tout=1;
+
+    if (redessin->tout){
+        if (!calque_debut_dessin(&redessin->scene)) return -1;
+        redessin->nb_zones=1;
+        redessin->tab_zones[0][0]=0;
+        redessin->tab_zones[0][1]=0;
+        redessin->tab_zones[0][2]=redessin->largeur-1;
+        redessin->tab_zones[0][3]=redessin->hauteur-1;
+        redessin->tout=0;
+    }
+    else if (redessin->nb_zones==0) return 0;
+    else if (!calque_reprendre_dessin(&redessin->scene)){
+        calque_invalider(&redessin->scene);
+        return redessin_debut(redessin);
+    }
+    return redessin->nb_zones;
+}
+
+// ---------------------------------------------
+/* fonction: redessin_zone
+    Description:    limite les prochains tracs  une zone de la scne et l'efface avec
+                    la couleur de fond. Tous les lments peuvent ensuite tre tracs:
+                    seules leurs parties dans la zone sont dessines.
+    Paramtre(s):   redessin    suivi des zones
+                    zone        numro de la zone (0  nb de zones-1)
+                    r,g,b,a     couleur de fond
+    Retour:         aucun
+*/
+void redessin_zone(t_redessin* redessin, int zone, int r, int g, int b, int a)
+{
+    int* z=redessin->tab_zones[zone];
+    SDL_Rect rect={z[0],redessin->hauteur-1-z[3],z[2]-z[0]+1,z[3]-z[1]+1};
+
+    SDL_RenderSetClipRect(renderer,&rect);
+    graph_select_couleur(r,g,b,a);
+    SDL_RenderFillRect(renderer,&rect);
+}
+
+// ---------------------------------------------
+/* fonction: redessin_fin
+    Description:    termine le redessin des zones et recopie la scne dans la fentre
+    Note:           comme pour toutes les fonctions de dessin graphique, le rsultat ne sera
+                    visible qu'aprs un appel  la fonction graph_mise_a_jour();
+    Paramtre(s):   redessin    suivi des zones
+    Retour:         aucun
+*/
+void redessin_fin(t_redessin* redessin)
+{
+    SDL_RenderSetClipRect(renderer,NULL);
+    calque_fin_dessin(&redessin->scene);
+    redessin->nb_zones=0;
+    calque_afficher(&redessin->scene);
+}
+
+// ---------------------------------------------
+/* fonction: liberer_redessin
+    Description:    libre la scne (avant graph_fin, ou quand les textures du renderer
+                    sont perdues); le prochain affichage redessine tout
+    Paramtre(s):   redessin    suivi des zones
+    Retour:         aucun
+*/
+void liberer_redessin(t_redessin* redessin)
+{
+    liberer_calque(&redessin->scene);
+    redessin->tout=1;
+}
@@ -0,0 +1,59 @@
+#ifndef REDESSIN_H
+#define REDESSIN_H
+
+// -------------------------------------------
+/*
+librairie redessin.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Redessin partiel de l'affichage (zones modifies). L'image complte est
+             conserve dans un calque (la scne).  chaque affichage, le programme
+             dcrit la bote englobante de chaque lment visible; seules les zones o
+             un lment est apparu, a disparu ou a boug (ancienne et nouvelle bote)
+             sont effaces et redessines dans la scne, qui est ensuite recopie dans
+             la fentre. Si rien n'a chang, il n'y a rien  dessiner ni  afficher.
+             Toute la scne est redessine quand c'est ncessaire: premier affichage,
+             scne perdue par le renderer, trop de zones (voir redessin_tout).
+             Si le renderer ne permet pas de dessiner dans une texture, le redessin
+             partiel est impossible et le programme doit tout redessiner dans la fentre.
+             Les coordonnes sont celles du jeu (origine au coin infrieur gauche).
+Note: les implmentations des fonctions se trouvent dans le fichier redessin.c
+*/
+// -------------------------------------------
+
+#include "calque.h"
+
+// ---------------------------------------------
+// paramtres du suivi des zones modifies
+// ---------------------------------------------
+#define REDESSIN_MAX_ELEMENTS   8   // nb maximum d'lments suivis
+#define REDESSIN_MAX_ZONES      8   // nb maximum de zones, au-del toute la scne est redessine
+#define REDESSIN_MARGE          1   // pixels ajouts autour de chaque bote (arrondi du trac des lignes)
+
+// ---------------------------------------------
+// suivi des zones modifies et scne conserve
+// ---------------------------------------------
+typedef struct {
+    t_calque scene;                                 // image complte de la fentre
+    int largeur, hauteur;                           // taille de la fentre
+    int tout;                                       // 1 si toute la scne doit tre redessine
+    int nb_zones;                                   // nb de zones  redessiner
+    int tab_zones[REDESSIN_MAX_ZONES][4];           // zones  redessiner (x1,y1,x2,y2)
+    int tab_visibles[REDESSIN_MAX_ELEMENTS];        // visibilit de chaque lment au dernier affichage
+    int tab_boites[REDESSIN_MAX_ELEMENTS][4];       // bote de chaque lment au dernier affichage
+} t_redessin;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void initialiser_redessin(t_redessin* redessin, int largeur, int hauteur);
+void redessin_tout(t_redessin* redessin);
+void redessin_element(t_redessin* redessin, int element, int visible, int x1, int y1, int x2, int y2);
+void redessin_zone_modifiee(t_redessin* redessin, int x1, int y1, int x2, int y2);
+int redessin_debut(t_redessin* redessin);
+void redessin_zone(t_redessin* redessin, int zone, int r, int g, int b, int a);
+void redessin_fin(t_redessin* redessin);
+void liberer_redessin(t_redessin* redessin);
+
+#endif // REDESSIN_H
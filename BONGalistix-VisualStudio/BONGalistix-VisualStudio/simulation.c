@@ -0,0 +1,839 @@
+// -------------------------------------------
+/*
+librairie simulation.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Simulation numrique du vol du projectile (balistique et rebonds) sans
+             dpendance  la librairie SDL. Permet de simuler un tir complet aussi vite
+             que le processeur le permet (ex: valuation de tirs en lot).
+Note: les prototypes des fonctions se trouvent dans le fichier simulation.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "geometrie.h"
+#include "simulation.h"
+#include "grille.h"
+#include "bvh.h"
+#include "murs_simd.h"
+#include "vol_analytique.h"
+
+// ---------------------------------------------
+// tat du projectile pendant l'intgration numrique
+// ---------------------------------------------
+typedef struct {
+    double x,y;     // position
+    double vx,vy;   // vitesse
+} t_etat_projectile;
+
+static int integrateur_courant=INTEGRATEUR_DEFAUT;  // intgrateur utilis par mise_a_jour_ballistique
+
+// ---------------------------------------------
+/* fonction: projectile_immobile
+    Description:    Teste si le projectile est immobile en comparant l'ancienne et
+                    la nouvelle position
+    Note:           Le projectile est visuellement immobile s'il ne change pas de pixel,
+                    donc si la partie entire de ses coordonnes n'ont pas changes
+    Paramtre(s):   tab_projectile      Le tableau d'infos du projectile
+    Retour:         1 si le projectile est immobile 0 sinon
+    Ex. d'utilisation:
+                    // teste si le projectile est immobile
+                    if (projectile_immobile(tab_projectile))
+
+*/
+int projectile_immobile(double tab_projectile[][COL_TABPRO]){   //test si le projectile est immobile
+    return ((floor(tab_projectile[POSITION][X1])-floor(tab_projectile[POSITION][X0])==0)&&
+            (floor(tab_projectile[POSITION][Y1])-floor(tab_projectile[POSITION][Y0])==0));
+}
+
+// ---------------------------------------------
+/* fonction: cible_atteinte
+    Description:    Teste si la cible est atteinte par le projectile
+    Paramtre(s):   tab_projectile  tableau d'information du projectile
+                    tab_cible       tableau d'info sur la cible
+    Retour:         1 si la cible est touche, 0 sinon
+    Ex. d'utilisation:
+                    cible_atteinte(tabp,tabc);  // teste si la cible dcrite par le tableau tabc est
+                                                // touche par le projectile dcrit par le tableau tabp
+*/
+int cible_atteinte(double tab_projectile[][COL_TABPRO],int tab_cible[]){
+    
+	//si le projectile atteint la cible retourner 1, sinon retour 0.
+	if (tab_projectile[POSITION][X1] >= tab_cible[X0] && tab_projectile[POSITION][X1] <= tab_cible[X1] && tab_projectile[POSITION][Y1] <= tab_cible[Y1] && tab_projectile[POSITION][Y1] >= tab_cible[Y0])
+	{
+		return 1;
+	}
+
+	else
+	{
+		return 0;
+	}
+}
+
+// ---------------------------------------------
+/* fonction: cible_croisee
+    Description:    Teste si le dernier segment de trajectoire du projectile, de l'ancienne
+                    position (x0,y0)  la nouvelle (x1,y1), traverse le rectangle de la cible
+                    (mthode des bandes: intersection des intervalles de parcours compris
+                    entre les bords verticaux et entre les bords horizontaux)
+    Paramtre(s):   tab_projectile  tableau d'information du projectile
+                    tab_cible       tableau d'info sur la cible
+                    f               adresse o placer la fraction du segment parcourue 
+                                    l'entre dans la cible (0: dpart dans la cible)
+    Retour:         1 si le segment traverse la cible, 0 sinon
+    Ex. d'utilisation:
+                    if (cible_croisee(tabp,tabc,&f)) ...    // touche en cours de dplacement
+*/
+int cible_croisee(double tab_projectile[][COL_TABPRO],int tab_cible[],double* f)
+{
+    double x0=tab_projectile[POSITION][X0],y0=tab_projectile[POSITION][Y0];
+    double dx=tab_projectile[POSITION][X1]-x0,dy=tab_projectile[POSITION][Y1]-y0;
+    double f_min=0,f_max=1;     // intervalle du segment compris dans la cible
+    double fa,fb,tmp;
+
+    // bande entre les bords verticaux
+    if (dx==0){
+        if (x0<tab_cible[X0] || x0>tab_cible[X1]) return 0;
+    }
+    else{
+        fa=(tab_cible[X0]-x0)/dx;
+        fb=(tab_cible[X1]-x0)/dx;
+        if (fa>fb){ tmp=fa; fa=fb; fb=tmp; }
+        if (fa>f_min) f_min=fa;
+        if (fb<f_max) f_max=fb;
+    }
+
+    // bande entre les bords horizontaux
+    if (dy==0){
+        if (y0<tab_cible[Y0] || y0>tab_cible[Y1]) return 0;
+    }
+    else{
+        fa=(tab_cible[Y0]-y0)/dy;
+        fb=(tab_cible[Y1]-y0)/dy;
+        if (fa>fb){ tmp=fa; fa=fb; fb=tmp; }
+        if (fa>f_min) f_min=fa;
+        if (fb<f_max) f_max=fb;
+    }
+
+    if (f_min>f_max) return 0;
+    *f=f_min;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: premier_mur_croise
+    Description:    trouve le premier mur crois par le segment de trajectoire (x0,y0)-(x1,y1),
+                    c'est--dire le mur dont le point d'impact est le plus proche de (x0,y0).
+                    L'index spatial choisi pour le niveau (grille uniforme ou arbre des murs)
+                    limite les murs tests  ceux proches du segment. Sans index, tous les
+                    murs sont tests, plusieurs  la fois (voir murs_simd.h); le point
+                    d'impact sur le mur trouv est ensuite recalcul avec le mme test que
+                    les index pour que tous donnent exactement le mme point.
+    Paramtre(s):   niv     niveau contenant les segments de murs
+                    x0,y0   position de dpart du segment de trajectoire
+                    x1,y1   position d'arrive du segment de trajectoire
+                    xr,yr   adresses o placer le point d'impact
+    Retour:         l'indice du mur crois, -1 si aucun mur n'est crois
+    Ex. d'utilisation:
+                    mur=premier_mur_croise(&niv,x0,y0,x1,y1,&xr,&yr);
+*/
+int premier_mur_croise(t_niveau* niv, double x0, double y0, double x1, double y1,
+                       double* xr, double* yr)
+{
+    double xi,yi,d,d_min=HUGE_VAL;  // point d'intersection et distance au dpart
+    double s;                       // fraction du segment parcourue  l'impact
+    int i,mur=-1;
+
+    if (niv->index_murs==INDEX_MURS_GRILLE && niv->grille!=NULL)
+        return grille_premier_mur(niv->grille,niv->tab_murs,x0,y0,x1,y1,xr,yr);
+    if (niv->index_murs==INDEX_MURS_BVH && niv->bvh!=NULL)
+        return bvh_premier_mur(niv->bvh,niv->tab_murs,x0,y0,x1,y1,xr,yr);
+    if (niv->murs_simd!=NULL){
+        mur=murs_simd_premier_mur(niv->murs_simd,x0,y0,x1,y1,&s);
+        if (mur>=0 && !intersection_segment_compile(x0,y0,x1,y1,&niv->tab_murs[mur],xr,yr)){
+            // impact  la limite du mur (arrondi): garder le point du test vectoriel
+            *xr=x0+s*(x1-x0);
+            *yr=y0+s*(y1-y0);
+        }
+        return mur;
+    }
+
+    for (i=0;i<niv->nb_segments;i++){
+        if (intersection_segment_compile(x0,y0,x1,y1,&niv->tab_murs[i],&xi,&yi)){
+            d=(xi-x0)*(xi-x0)+(yi-y0)*(yi-y0);
+            if (d<d_min){
+                d_min=d;
+                mur=i;
+                *xr=xi;
+                *yr=yi;
+            }
+        }
+    }
+    return mur;
+}
+
+// ---------------------------------------------
+/* fonction: mur_du_coin
+    Description:    cherche un deuxime mur touch au mme point d'impact que le mur trouv,
+                    c'est--dire un coin form par un mur horizontal et un mur vertical.
+                    Seuls les murs proches du point d'impact sont tests (arbre des murs);
+                    s'ils sont plus de NB_CANDIDATS_COIN, la recherche est refaite dans un
+                    tableau allou  leur nombre.
+    Paramtre(s):   niv     niveau contenant les segments de murs
+                    mur     indice du mur touch
+                    x0,y0   position de dpart du segment de trajectoire
+                    x1,y1   position d'arrive du segment de trajectoire
+                    xr,yr   point d'impact sur le mur touch
+    Retour:         l'indice du mur formant un coin avec le mur touch, -1 s'il n'y en a pas
+*/
+static int mur_du_coin(t_niveau* niv, int mur, double x0, double y0, double x1, double y1,
+                       double xr, double yr)
+{
+    int tab_proches[NB_CANDIDATS_COIN];     // murs proches du point d'impact (cas courant)
+    int* tab_candidats=tab_proches;         // murs proches du point d'impact
+    int nb,i,j,coin=-1;
+    double xi,yi;
+
+    if (niv->tab_murs[mur].orientation==SEGMENT_OBLIQUE) return -1;
+    if (niv->bvh!=NULL){
+        nb=bvh_murs_dans_rectangle(niv->bvh,niv->tab_murs,xr-EPSILON_COIN,yr-EPSILON_COIN,
+                                   xr+EPSILON_COIN,yr+EPSILON_COIN,tab_proches,NB_CANDIDATS_COIN);
+        if (nb>NB_CANDIDATS_COIN){
+            tab_candidats=(int*)malloc(nb*sizeof(int));
+            if (tab_candidats!=NULL){
+                nb=bvh_murs_dans_rectangle(niv->bvh,niv->tab_murs,xr-EPSILON_COIN,yr-EPSILON_COIN,
+                                           xr+EPSILON_COIN,yr+EPSILON_COIN,tab_candidats,nb);
+            }
+            else{
+                tab_candidats=tab_proches;
+                nb=NB_CANDIDATS_COIN;
+            }
+        }
+    }
+    else nb=niv->nb_segments;
+
+    for (i=0;i<nb && coin<0;i++){
+        j=(niv->bvh!=NULL)?tab_candidats[i]:i;
+        if (j==mur || niv->tab_murs[j].orientation==SEGMENT_OBLIQUE ||
+            niv->tab_murs[j].orientation==niv->tab_murs[mur].orientation) continue;
+        // rejet rapide par le rectangle englobant (utile sans arbre des murs): le coin est au point d'impact
+        if (niv->tab_murs[j].x_max<xr-EPSILON_COIN || niv->tab_murs[j].x_min>xr+EPSILON_COIN ||
+            niv->tab_murs[j].y_max<yr-EPSILON_COIN || niv->tab_murs[j].y_min>yr+EPSILON_COIN) continue;
+        if (intersection_segment_compile(x0,y0,x1,y1,&niv->tab_murs[j],&xi,&yi) &&
+            fabs(xi-xr)<=EPSILON_COIN && fabs(yi-yr)<=EPSILON_COIN) coin=j;
+    }
+    if (tab_candidats!=tab_proches) free(tab_candidats);
+    return coin;
+}
+
+// ---------------------------------------------
+/* fonction: mise_a_jour_rebond
+    Description:    Mets--jour la  position et vitesse du projectile en tenant selon des
+                    ventuels rebonds.
+                    Analyse le dernier segment de trajectoire correspondant au dplacement depuis
+                    l'ancienne position (x0,y0) jusqu' la nouvelle (x1,y1) en 4 tapes:
+                    1-Dterminer le premier mur crois par le segment de trajectoire
+                    2-Calculer la distance du dernier segment et celle jusqu'au rebond (d,drf)
+                    3-Fixer la nouvelle position au point d'impact (x1,y1)
+                    4-Dterminer le temps, et la vitesse au moment de l'impact (t,dt,vx1,vy1)
+                    5.1-Inverser la vitesse horizontale ou verticale selon l'angle du mur touch
+                        (les deux dans un coin form par un mur horizontal et un mur vertical)
+                    5.2-Replacer le projectile lgrement  ct de la paroi (du bon ct)
+                    6-Rduire la vitesse pour modliser la perte d'nergie due  l'impact
+    Note:           Pour simplifier l'analyse et la mise  jour des rebonds,
+                    la fonction suppose:
+                    1-que seuls des murs horizontaux ou verticaux existent (pas de diagonale) De plus,
+                    2-que la taille du projectile est nulle. Le rebond  donc lieu quand
+                        le milieu du projectile touche la paroi. Cette simplification
+                        enlve un peu de ralisme  la simulation puisque le projectile entre
+                        un peu dans la paroi avant de rebondir.
+    Paramtre(s):   niv             niveau contenant les segments de murs
+                    tab_projectile  tableau d'information du projectile
+                    t               adresse de la variable de temps pour pouvoir la modifier
+                    dt              deltat, increment de temps de la simulation
+    Retour:         1 s'il y a eu rebond, 0 sinon. Les nouvelles valeurs calcules sont
+                    places dans le tableau tab_projectile et le temps (t) et son
+                    incrment (dt) peuvent tre modifis par la fonction
+    Ex. d'utilisation:
+                    // mettre a jour la position du projectile en fonction d'un ventuel rebond
+                    mise_a_jour_rebond(&niv,tab_projectile,&t,&dt);
+*/
+int mise_a_jour_rebond(t_niveau* niv,
+                       double tab_projectile[][COL_TABPRO],
+                       double *t,double *dt)
+{
+    double xrf,yrf;     // point d'intersection (impact) final
+    double d,drf;       // distance parcourue, distance au rebond final
+    int segf=-1;        // segment ou le rebond a finalement lieu
+    int coin=0;         // 1 si un deuxime mur est touch au mme point (coin)
+	double c;           // coefficient c de l'quation du mur touch (0: vertical)
+
+    // 1-dterminer le premier segment crois pendant le dernier segment de trajectoire
+    // mmoriser son index (segf),
+    // la position de l'impact qui est le point d'intersection (xrf,yrf),
+    // et la distance entre l'impact et la position prcdente (drf)
+
+	segf = premier_mur_croise(niv, tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], tab_projectile[POSITION][X1], tab_projectile[POSITION][Y1], &xrf, &yrf);
+	if (segf >= 0)
+	{
+		// le sens du mur (c=0: vertical, c=1: autre) vient de son quation de droite,
+		// calcule au chargement du niveau (voir compiler_segment)
+		c = niv->tab_murs[segf].c;
+		drf = longueur(tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], xrf, yrf);
+
+		// un coin renvoie le projectile dans la direction d'o il vient
+		coin = (mur_du_coin(niv, segf, tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0],
+		                    tab_projectile[POSITION][X1], tab_projectile[POSITION][Y1], xrf, yrf) >= 0);
+	}
+
+
+
+    // s'il y a rebond, ajuster la position, la vitesse du projectile, et le temps
+    // pour correspondre aux valeurs qu'elle aurait du prendre suite  l'impact
+    if(segf>=0)
+	{
+
+        // 2-calculer la distance parcourue (d) entre la position prcdente
+        // et la position actuelle du projectile (en ignorant le rebond)
+        
+		d = longueur(tab_projectile[POSITION][X0], tab_projectile[POSITION][Y0], tab_projectile[POSITION][X1], tab_projectile[POSITION][Y1]);
+
+
+        // 3-fixer la nouvelle position du projectile au point d'impact du rebond (xrf,yrf)
+        
+
+		tab_projectile[POSITION][X1] = xrf;
+		tab_projectile[POSITION][Y1] = yrf;
+
+        // 4.1-corriger le temps pour qu'il corresponde au moment de l'impact en utilisant le rapport de distance
+        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
+        
+		*t = *t - *dt + (drf / d ) * *dt;
+
+        // 4.2-ajuster le pas de temps pour qu'il corresponde  l'incrment qui mne  l'impact
+        // en utilisant le rapport de distance
+        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
+        // (cet ajustement est utile uniquement pour le ralisme de la simulation avec les delais)
+        
+		*dt *= (drf / d);
+
+        // 4.3-recalculer la vitesse au moment de l'impact par interpolation
+        // en utilisant le rapport de distance
+        // entre la longueur du segment sans rebond (d) et celle avec rebond (drf)
+        		
+		tab_projectile[VITESSE][X1] = (tab_projectile[VITESSE][X0]) + (tab_projectile[VITESSE][X1] - tab_projectile[VITESSE][X0]) * (drf / d);
+		tab_projectile[VITESSE][Y1] = (tab_projectile[VITESSE][Y0]) + (tab_projectile[VITESSE][Y1] - tab_projectile[VITESSE][Y0]) * (drf / d);
+
+        // 5.1-inverser la vitesse horizontale/verticale selon la paroi
+        // rencontre (vertical/horizontale), les deux dans un coin
+        
+		if (c == 0 || coin)
+		{
+			tab_projectile[VITESSE][X1] *= -1;
+		}
+
+		if (c == 1 || coin)
+		{
+			tab_projectile[VITESSE][Y1] *= -1;
+		}
+
+
+        // 5.2-replacer le projectile lgrement du bon ct de la paroi (DECALAGE_REBOND)
+        
+		if (c == 0 || coin)
+		{
+			if (tab_projectile[POSITION][X0] <= xrf)
+			{
+				tab_projectile[POSITION][X1] -= DECALAGE_REBOND;
+			}
+			 if (tab_projectile[POSITION][X0] >= xrf)
+			{
+				tab_projectile[POSITION][X1] += DECALAGE_REBOND;
+			}
+		}
+
+		if (c == 1 || coin)
+		{
+			if (tab_projectile[POSITION][Y0] <= yrf)
+			{
+				tab_projectile[POSITION][Y1] -= DECALAGE_REBOND;
+			}
+			else if (tab_projectile[POSITION][Y0] >= yrf)
+			{
+				tab_projectile[POSITION][Y1] += DECALAGE_REBOND;
+			}
+		}
+
+        // 6-rduire la vitesse aprs le rebond selon le coefficient de
+        // restitution de la paroi (C_RESTITUTION)
+        
+		tab_projectile[VITESSE][X1] *= C_RESTITUTION;
+
+		tab_projectile[VITESSE][Y1] *= C_RESTITUTION;
+
+        //printf(" rebond x=%lf y=%lf vx=%lf vy=%lf dt=%lf\n",*x,*y,*vx,*vy, *dt);
+    }
+
+    return (segf>=0);
+}
+// ---------------------------------------------
+/* fonction: mise_a_jour_vol
+    Description:    Avance le vol du projectile d'un pas de temps complet (dt) en dtectant
+                    les collisions en continu:
+                    1-mise  jour balistique sur le temps restant du pas
+                    2-recherche du mur le plus proche crois par le segment de trajectoire;
+                        s'il y en a un, le projectile rebondit au moment de l'impact
+                        (voir mise_a_jour_rebond)
+                    3-si la cible est traverse avant l'impact, le projectile est arrt
+                         l'entre de la cible
+                    4-le vol reprend aprs le rebond pour le temps restant du pas
+                    Un projectile rapide ne peut donc pas traverser un mur ou la cible entre
+                    deux pas, quelle que soit la longueur du pas. Au-del de MAX_REBONDS_PAS
+                    rebonds dans le mme pas (projectile coinc ou au repos contre un mur),
+                    le temps restant du pas est abandonn.
+    Paramtre(s):   niv             niveau contenant les segments de murs et la cible
+                    tab_projectile  tableau d'information du projectile
+                    t               adresse de la variable de temps pour pouvoir la modifier
+                    dt              dure du pas de simulation
+    Retour:         le nombre de rebonds pendant le pas. Les nouvelles valeurs sont places
+                    dans tab_projectile; l'ancienne position est celle du dbut du pas
+    Ex. d'utilisation:
+                    nb_rebonds+=mise_a_jour_vol(&niv,tab_projectile,&t,DELTAT);
+*/
+int mise_a_jour_vol(t_niveau* niv, double tab_projectile[][COL_TABPRO], double *t, double dt)
+{
+    double x_debut=tab_projectile[POSITION][X1];    // position au dbut du pas
+    double y_debut=tab_projectile[POSITION][Y1];
+    double reste=dt;        // temps du pas qui reste  simuler
+    double dt_impact;       // temps jusqu'au rebond
+    double f;               // fraction du segment parcourue  l'entre dans la cible
+    int nb_rebonds=0,rebond;
+
+    do{
+        mise_a_jour_ballistique(tab_projectile,t,reste);
+        dt_impact=reste;
+        rebond=mise_a_jour_rebond(niv,tab_projectile,t,&dt_impact);
+
+        // la cible traverse avant l'impact arrte le projectile
+        if (cible_croisee(tab_projectile,niv->tab_cible,&f)){
+            tab_projectile[POSITION][X1]=tab_projectile[POSITION][X0]+f*(tab_projectile[POSITION][X1]-tab_projectile[POSITION][X0]);
+            tab_projectile[POSITION][Y1]=tab_projectile[POSITION][Y0]+f*(tab_projectile[POSITION][Y1]-tab_projectile[POSITION][Y0]);
+            // l'arrondi ne doit pas laisser le point d'entre hors de la cible
+            tab_projectile[POSITION][X1]=fmin(fmax(tab_projectile[POSITION][X1],niv->tab_cible[X0]),niv->tab_cible[X1]);
+            tab_projectile[POSITION][Y1]=fmin(fmax(tab_projectile[POSITION][Y1],niv->tab_cible[Y0]),niv->tab_cible[Y1]);
+            *t-=(1-f)*dt_impact;
+            rebond=0;
+        }
+        else if (rebond){
+            nb_rebonds++;
+            reste-=dt_impact;
+        }
+    } while (rebond && nb_rebonds<MAX_REBONDS_PAS && reste>0);
+
+    tab_projectile[POSITION][X0]=x_debut;
+    tab_projectile[POSITION][Y0]=y_debut;
+
+    return nb_rebonds;
+}
+
+// ---------------------------------------------
+/* fonction: acceleration_projectile
+    Description:    acclration du projectile selon sa vitesse: frottement de l'air sur
+                    chaque axe (proportionnel au carr de la vitesse et toujours oppos 
+                    celle-ci) et gravit sur l'axe vertical
+    Paramtre(s):   vx,vy   vitesse du projectile
+                    ax,ay   adresses o placer l'acclration
+    Retour:         aucun
+*/
+static void acceleration_projectile(double vx, double vy, double* ax, double* ay)
+{
+    *ax=-(C_FROTTEMENT/MASSE)*vx*fabs(vx);
+    *ay=-(C_FROTTEMENT/MASSE)*vy*fabs(vy)-GRAVITE;
+}
+
+// ---------------------------------------------
+/* fonction: pas_euler
+    Description:    un pas d'Euler semi-implicite (ordre 1): la vitesse est mise  jour
+                    avec l'acclration au dbut du pas, puis la position avec la nouvelle
+                    vitesse
+    Paramtre(s):   e   tat du projectile  faire avancer
+                    h   dure du pas
+    Retour:         aucun
+*/
+static void pas_euler(t_etat_projectile* e, double h)
+{
+    double ax,ay;
+
+    acceleration_projectile(e->vx,e->vy,&ax,&ay);
+    e->vx+=ax*h;
+    e->vy+=ay*h;
+    e->x+=e->vx*h;
+    e->y+=e->vy*h;
+}
+
+// ---------------------------------------------
+/* fonction: pas_verlet
+    Description:    un pas de Verlet vitesse (ordre 2): demi-pas de vitesse, pas complet
+                    de position avec la vitesse du milieu du pas, puis deuxime demi-pas de
+                    vitesse avec l'acclration du milieu du pas (le frottement dpend de la
+                    vitesse et non de la position)
+    Paramtre(s):   e   tat du projectile  faire avancer
+                    h   dure du pas
+    Retour:         aucun
+*/
+static void pas_verlet(t_etat_projectile* e, double h)
+{
+    double ax,ay;
+
+    acceleration_projectile(e->vx,e->vy,&ax,&ay);
+    e->vx+=ax*h/2;
+    e->vy+=ay*h/2;
+    e->x+=e->vx*h;
+    e->y+=e->vy*h;
+    acceleration_projectile(e->vx,e->vy,&ax,&ay);
+    e->vx+=ax*h/2;
+    e->vy+=ay*h/2;
+}
+
+// ---------------------------------------------
+/* fonction: pas_rk4
+    Description:    un pas de Runge-Kutta classique (ordre 4)
+    Paramtre(s):   e   tat du projectile  faire avancer
+                    h   dure du pas
+    Retour:         aucun
+*/
+static void pas_rk4(t_etat_projectile* e, double h)
+{
+    double ax1,ay1,ax2,ay2,ax3,ay3,ax4,ay4;
+    double vx2,vy2,vx3,vy3,vx4,vy4;
+
+    acceleration_projectile(e->vx,e->vy,&ax1,&ay1);
+    vx2=e->vx+ax1*h/2; vy2=e->vy+ay1*h/2;
+    acceleration_projectile(vx2,vy2,&ax2,&ay2);
+    vx3=e->vx+ax2*h/2; vy3=e->vy+ay2*h/2;
+    acceleration_projectile(vx3,vy3,&ax3,&ay3);
+    vx4=e->vx+ax3*h; vy4=e->vy+ay3*h;
+    acceleration_projectile(vx4,vy4,&ax4,&ay4);
+
+    e->x+=h/6*(e->vx+2*vx2+2*vx3+vx4);
+    e->y+=h/6*(e->vy+2*vy2+2*vy3+vy4);
+    e->vx+=h/6*(ax1+2*ax2+2*ax3+ax4);
+    e->vy+=h/6*(ay1+2*ay2+2*ay3+ay4);
+}
+
+// ---------------------------------------------
+/* fonction: pas_rk45
+    Description:    un pas de Runge-Kutta-Dormand-Prince: solution d'ordre 5 et estimation
+                    de son erreur par l'cart avec la solution d'ordre 4 calcule avec les
+                    mmes valuations de l'acclration
+    Paramtre(s):   e       tat du projectile au dbut du pas
+                    h       dure du pas
+                    r       adresse o placer l'tat  la fin du pas (ordre 5)
+    Retour:         l'erreur estime (plus grand cart sur la position ou la vitesse)
+*/
+static double pas_rk45(t_etat_projectile* e, double h, t_etat_projectile* r)
+{
+    // coefficients de Dormand et Prince
+    static const double a21=1.0/5;
+    static const double a31=3.0/40,a32=9.0/40;
+    static const double a41=44.0/45,a42=-56.0/15,a43=32.0/9;
+    static const double a51=19372.0/6561,a52=-25360.0/2187,a53=64448.0/6561,a54=-212.0/729;
+    static const double a61=9017.0/3168,a62=-355.0/33,a63=46732.0/5247,a64=49.0/176,a65=-5103.0/18656;
+    static const double b1=35.0/384,b3=500.0/1113,b4=125.0/192,b5=-2187.0/6784,b6=11.0/84;
+    static const double tab_e[7]={71.0/57600,0,-71.0/16695,71.0/1920,-17253.0/339200,22.0/525,-1.0/40};   // ordre 5 - ordre 4
+    double tab_vx[7],tab_vy[7],tab_ax[7],tab_ay[7];   // vitesse et acclration de chaque tape
+    double ex,ey,evx,evy;
+    int i;
+
+    tab_vx[0]=e->vx; tab_vy[0]=e->vy;
+    acceleration_projectile(tab_vx[0],tab_vy[0],&tab_ax[0],&tab_ay[0]);
+    tab_vx[1]=e->vx+h*(a21*tab_ax[0]);
+    tab_vy[1]=e->vy+h*(a21*tab_ay[0]);
+    acceleration_projectile(tab_vx[1],tab_vy[1],&tab_ax[1],&tab_ay[1]);
+    tab_vx[2]=e->vx+h*(a31*tab_ax[0]+a32*tab_ax[1]);
+    tab_vy[2]=e->vy+h*(a31*tab_ay[0]+a32*tab_ay[1]);
+    acceleration_projectile(tab_vx[2],tab_vy[2],&tab_ax[2],&tab_ay[2]);
+    tab_vx[3]=e->vx+h*(a41*tab_ax[0]+a42*tab_ax[1]+a43*tab_ax[2]);
+    tab_vy[3]=e->vy+h*(a41*tab_ay[0]+a42*tab_ay[1]+a43*tab_ay[2]);
+    acceleration_projectile(tab_vx[3],tab_vy[3],&tab_ax[3],&tab_ay[3]);
+    tab_vx[4]=e->vx+h*(a51*tab_ax[0]+a52*tab_ax[1]+a53*tab_ax[2]+a54*tab_ax[3]);
+    tab_vy[4]=e->vy+h*(a51*tab_ay[0]+a52*tab_ay[1]+a53*tab_ay[2]+a54*tab_ay[3]);
+    acceleration_projectile(tab_vx[4],tab_vy[4],&tab_ax[4],&tab_ay[4]);
+    tab_vx[5]=e->vx+h*(a61*tab_ax[0]+a62*tab_ax[1]+a63*tab_ax[2]+a64*tab_ax[3]+a65*tab_ax[4]);
+    tab_vy[5]=e->vy+h*(a61*tab_ay[0]+a62*tab_ay[1]+a63*tab_ay[2]+a64*tab_ay[3]+a65*tab_ay[4]);
+    acceleration_projectile(tab_vx[5],tab_vy[5],&tab_ax[5],&tab_ay[5]);
+
+    // solution d'ordre 5 (la position avance avec la vitesse de chaque tape)
+    r->vx=e->vx+h*(b1*tab_ax[0]+b3*tab_ax[2]+b4*tab_ax[3]+b5*tab_ax[4]+b6*tab_ax[5]);
+    r->vy=e->vy+h*(b1*tab_ay[0]+b3*tab_ay[2]+b4*tab_ay[3]+b5*tab_ay[4]+b6*tab_ay[5]);
+    r->x=e->x+h*(b1*tab_vx[0]+b3*tab_vx[2]+b4*tab_vx[3]+b5*tab_vx[4]+b6*tab_vx[5]);
+    r->y=e->y+h*(b1*tab_vy[0]+b3*tab_vy[2]+b4*tab_vy[3]+b5*tab_vy[4]+b6*tab_vy[5]);
+
+    // septime tape (dbut du pas suivant) pour l'estimation de l'erreur
+    tab_vx[6]=r->vx;
+    tab_vy[6]=r->vy;
+    acceleration_projectile(tab_vx[6],tab_vy[6],&tab_ax[6],&tab_ay[6]);
+
+    ex=ey=evx=evy=0;
+    for (i=0;i<7;i++){
+        ex+=tab_e[i]*tab_vx[i];
+        ey+=tab_e[i]*tab_vy[i];
+        evx+=tab_e[i]*tab_ax[i];
+        evy+=tab_e[i]*tab_ay[i];
+    }
+    return h*fmax(fmax(fabs(ex),fabs(ey)),fmax(fabs(evx),fabs(evy)));
+}
+
+// ---------------------------------------------
+/* fonction: integrer_rk45
+    Description:    fait avancer l'tat du projectile d'une dure h en sous-pas de
+                    Runge-Kutta-Dormand-Prince dont la dure s'adapte pour que l'erreur
+                    estime de chaque sous-pas ne dpasse pas TOLERANCE_RK45. Un sous-pas
+                    est accept malgr l'erreur aprs MAX_SOUS_PAS_RK45 essais refuss ou
+                    s'il ne dure plus que PAS_MIN_RK45: le nb de sous-pas reste born.
+    Paramtre(s):   e   tat du projectile  faire avancer
+                    h   dure totale
+    Retour:         aucun
+*/
+static void integrer_rk45(t_etat_projectile* e, double h)
+{
+    t_etat_projectile r;
+    double reste=h,h_essai=h,erreur,facteur;
+    int nb_essais=0;    // essais refuss du sous-pas en cours
+
+    while (reste>0){
+        if (h_essai>reste) h_essai=reste;
+        erreur=pas_rk45(e,h_essai,&r);
+
+        // le sous-pas est accept si l'erreur est tolre, ou malgr l'erreur
+        // aprs MAX_SOUS_PAS_RK45 essais refuss ou  la dure minimum
+        if (erreur<=TOLERANCE_RK45 || nb_essais+1>=MAX_SOUS_PAS_RK45 || h_essai<=PAS_MIN_RK45){
+            *e=r;
+            reste-=h_essai;
+            nb_essais=0;
+        }
+        else nb_essais++;
+
+        // nouvelle dure selon l'erreur (ordre 5), borne pour rester stable
+        facteur=(erreur>0)?0.9*pow(TOLERANCE_RK45/erreur,0.2):5;
+        h_essai=fmax(PAS_MIN_RK45,h_essai*fmin(5,fmax(0.2,facteur)));
+    }
+}
+
+// ---------------------------------------------
+/* fonction: choisir_integrateur
+    Description:    choisit la mthode d'intgration numrique utilise par
+                    mise_a_jour_ballistique pour toutes les simulations de vol
+    Note:           l'intgrateur change l'issue des tirs: il fait partie de l'en-tte
+                    des tables de tirs sauvegardes (voir solveur.h)
+    Paramtre(s):   integrateur     INTEGRATEUR_EULER, INTEGRATEUR_VERLET, INTEGRATEUR_RK4,
+                                    INTEGRATEUR_RK45 ou INTEGRATEUR_ANALYTIQUE
+    Retour:         1 si l'intgrateur est choisi, 0 s'il n'existe pas
+    Ex. d'utilisation:
+                    choisir_integrateur(INTEGRATEUR_RK4);
+*/
+int choisir_integrateur(int integrateur)
+{
+    if (integrateur<0 || integrateur>=NB_INTEGRATEURS) return 0;
+    integrateur_courant=integrateur;
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: integrateur_simulation
+    Description:    mthode d'intgration numrique utilise pour les simulations de vol
+    Paramtre(s):   aucun
+    Retour:         INTEGRATEUR_EULER, INTEGRATEUR_VERLET, INTEGRATEUR_RK4, INTEGRATEUR_RK45
+                    ou INTEGRATEUR_ANALYTIQUE
+*/
+int integrateur_simulation()
+{
+    return integrateur_courant;
+}
+
+// ---------------------------------------------
+/* fonction: mise_a_jour_ballistique
+    Description:     partir de la position et de la vitesse prcdente du projectile, calcule
+                    la nouvelle position et la nouvelle vitesse du projectile en 3 tapes:
+                    1-sauvegarder l'ancienne position/vitesse dans x0,y0,vx0,vy0
+                    2-intgrer numriquement le mouvement pendant dt avec l'intgrateur
+                        choisi (voir choisir_integrateur). L'acclration est la somme de:
+                        -l'effet du frottement de l'air sur chaque axe: -v*|v|*cf/masse
+                        o cf est le coefficient de frottement de l'air
+                        -l'effet de la gravit sur l'axe vertical: -g
+                    3-ajouter dt au temps de la simulation
+    Note:           Les murs sont compltement ignors par cette fonction. Attention,
+                    l'effet du frottement est toujours oppos  la vitesse, il est donc positif pour
+                    une vitesse ngative et ngatif quand la vitesse est positive.
+    Paramtre(s):   tab_projectile  tableau d'information du projectile
+                    t               adresse de la variable de temps pour pouvoir la modifier
+                    dt              deltat, increment de temps de la simulation
+    Retour:         Aucun, les nouvelles valeurs calcules sont places dans le tableau tab_projectile
+                    et le temps est modifi par la fonction
+    Ex. d'utilisation:
+                    mise_a_jour_ballistique(tab_projectile,&t,DELTAT);  // avancer d'un pas sans les murs
+*/
+void mise_a_jour_ballistique(double tab_projectile[][COL_TABPRO],double *t,double dt){
+    t_etat_projectile e;
+
+    //avant calculer la nouvelle position/vitesse, sauvegarder l'ancienne position dans x0,y0,vx0,vy0
+    
+	tab_projectile[POSITION][X0] = tab_projectile[POSITION][X1];
+	tab_projectile[POSITION][Y0] = tab_projectile[POSITION][Y1];
+
+	tab_projectile[VITESSE][X0] = tab_projectile[VITESSE][X1];
+	tab_projectile[VITESSE][Y0] = tab_projectile[VITESSE][Y1];
+
+    // calcul de la nouvelle vitesse et nouvelle position sans rebond
+    e.x=tab_projectile[POSITION][X0];
+    e.y=tab_projectile[POSITION][Y0];
+    e.vx=tab_projectile[VITESSE][X0];
+    e.vy=tab_projectile[VITESSE][Y0];
+    switch (integrateur_courant){
+        case INTEGRATEUR_VERLET:    pas_verlet(&e,dt); break;
+        case INTEGRATEUR_RK4:       pas_rk4(&e,dt); break;
+        case INTEGRATEUR_RK45:      integrer_rk45(&e,dt); break;
+        case INTEGRATEUR_ANALYTIQUE:vol_analytique(e.x,e.y,e.vx,e.vy,dt,&e.x,&e.y,&e.vx,&e.vy); break;
+        default:                    pas_euler(&e,dt); break;
+    }
+    tab_projectile[POSITION][X1]=e.x;
+    tab_projectile[POSITION][Y1]=e.y;
+    tab_projectile[VITESSE][X1]=e.vx;
+    tab_projectile[VITESSE][Y1]=e.vy;
+
+    // mise  jour du temps de la simulation: ajouter dt au temps
+    	
+	*t += dt;
+}
+
+// ---------------------------------------------
+/* fonction: calcule_lanceur
+    Description:    calcule les coordonnes de l'extremit mobile du lanceur
+                    en fonction des coordonnes de la souris et en prenant soin
+                    de limiter la longueur du lanceur selon la vitesse maximale
+                    spcifie.
+    Note:           La longueur du segment du lanceur correspond directement 
+                    la vitesse initiale qui sera donne au projectile. Une vitesse
+                    initiale de 10 est reprsente par un segment de 10 pixels de longueur
+    Paramtre(s):   mousex      coordonne en x de la souris
+                    mousey      coordonne en y de la souris
+                    vmax        vitesse max permise ou longueur max du lanceur
+                    tab_lanceur tableau d'info du lanceur (coordonnes des deux extrmits)
+    Retour:         Aucun, les nouvelles valeurs calcules sont places dans le tableau tab_lanceur
+    Ex. d'utilisation:
+                    calcule_lanceur(100,100,15,tab_lanceur);    // calcule l'extremit du lanceur
+                                                                // pour une position de souris de 100,100
+                                                                // et une vitesse max permise de 15 (m/s)
+*/
+void calcule_lanceur(int mousex,int mousey,int vmax,int tab_lanceur[])
+{
+
+    double l;   // longueur du segment du lanceur
+
+    // placer la fin du lanceur  la position de la souris.
+	tab_lanceur[X1] = mousex;
+	tab_lanceur[Y1] = mousey;
+
+    // calculer la longueur du segment du lanceur (l)
+
+	l = longueur(tab_lanceur[X0], tab_lanceur[Y0], tab_lanceur[X1], tab_lanceur[Y1]);
+
+
+    // si cette longueur dpasse la vitesse maximale (vmax) ajuster
+    // l'extrmit (x1,y1) en utilisant le facteur (vmax/longueur)
+	if (l > vmax)
+	{
+		tab_lanceur[X1] = ((vmax * (mousex - tab_lanceur[X0])) / l) + tab_lanceur[X0];
+		tab_lanceur[Y1] = ((vmax * (mousey - tab_lanceur[Y0])) / l) + tab_lanceur[Y0];
+	}
+}
+
+// ---------------------------------------------
+/* fonction: simuler_tir
+    Description:    Simule un tir complet  partir du lanceur du niveau, sans affichage
+                    ni dlai, en enchanant les mmes tapes que le mode SIMULATION_VOL
+                    du jeu:
+                    1-mise  jour balistique de la position/vitesse et rebonds
+                        pendant un pas complet (voir mise_a_jour_vol)
+                    2-vrification de l'atteinte de la cible
+                    3-chronomtrage du temps d'immobilit du projectile
+                    Le tir se termine quand la cible est atteinte, quand le projectile
+                    est rest immobile pendant T_IMMOBILE_MAX ou, par scurit, quand
+                    le temps de vol dpasse T_VOL_MAX.
+                    Avec INTEGRATEUR_ANALYTIQUE, le tir est plutt simul par vnements
+                    (voir simuler_tir_analytique) si le niveau n'a pas de mur oblique.
+    Paramtre(s):   niv         niveau dans lequel le tir est simul
+                    vx,vy       vitesse initiale du projectile (vecteur du lanceur)
+                    resultat    adresse de la structure o placer le rsultat du tir
+    Retour:         1 si la cible est atteinte, 0 sinon. Le dtail du tir (temps,
+                    nb de rebonds et nb de pas) est plac dans resultat
+    Ex. d'utilisation:
+                    // simuler un tir de vitesse (30,40) dans le niveau niv
+                    if (simuler_tir(&niv,30,40,&resultat)) printf("touch");
+*/
+int simuler_tir(t_niveau* niv, double vx, double vy, t_resultat_tir* resultat)
+{
+    // avec la solution exacte, les tirs passent directement d'un rebond au suivant
+    if (integrateur_courant==INTEGRATEUR_ANALYTIQUE && niveau_analytique(niv)){
+        return simuler_tir_analytique(niv,vx,vy,resultat);
+    }
+    return simuler_tir_pas(niv,vx,vy,DELTAT,resultat);
+}
+
+// ---------------------------------------------
+/* fonction: simuler_tir_pas
+    Description:    Simule un tir complet comme simuler_tir, avec un pas de simulation
+                    donn plutt que DELTAT (ex: comparaison des intgrateurs)
+    Paramtre(s):   niv         niveau dans lequel le tir est simul
+                    vx,vy       vitesse initiale du projectile (vecteur du lanceur)
+                    dt          pas de temps de la simulation
+                    resultat    adresse de la structure o placer le rsultat du tir
+    Retour:         1 si la cible est atteinte, 0 sinon
+    Ex. d'utilisation:
+                    simuler_tir_pas(&niv,30,40,0.01,&resultat);
+*/
+int simuler_tir_pas(t_niveau* niv, double vx, double vy, double dt, t_resultat_tir* resultat)
+{
+    double tab_projectile[LIG_TABPRO][COL_TABPRO]={{0}}; // position/vitesse actuelle et prcdente du projectile
+    double t=0;                 // temps coul lors de la simulation du vol du projectile
+    double chrono_immobile=0;   // chronomtre pour compter le temps d'immobilit du projectile
+    int fin=0;                  // indique la fin du tir
+
+    // position initiale au point d'origine du lanceur et vitesse initiale donne
+    tab_projectile[POSITION][X1]=niv->tab_lanceur[X0];
+    tab_projectile[POSITION][Y1]=niv->tab_lanceur[Y0];
+    tab_projectile[VITESSE][X1]=vx;
+    tab_projectile[VITESSE][Y1]=vy;
+
+    resultat->touche=0;
+    resultat->nb_rebonds=0;
+    resultat->nb_pas=0;
+
+    while (!fin){
+        // pas complet: mise  jour balistique et rebonds
+        resultat->nb_rebonds+=mise_a_jour_vol(niv,tab_projectile,&t,dt);
+        resultat->nb_pas++;
+
+        if (cible_atteinte(tab_projectile,niv->tab_cible)){
+            resultat->touche=1;
+            fin=1;
+        }
+        else{
+            // chronomtrer le temps d'immobilit du projectile
+            if (projectile_immobile(tab_projectile)){
+                chrono_immobile+=dt;
+                if (chrono_immobile>=T_IMMOBILE_MAX) fin=1;
+            }
+            else chrono_immobile=0;
+
+            // un projectile sorti de la zone de jeu ne s'immobilise jamais
+            if (t>=T_VOL_MAX) fin=1;
+        }
+    }
+
+    resultat->temps=t;
+
+    return resultat->touche;
+}
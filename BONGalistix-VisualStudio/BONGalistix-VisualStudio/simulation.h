@@ -0,0 +1,102 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// -------------------------------------------
+/*
+librairie simulation.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Simulation numrique du vol du projectile (balistique et rebonds).
+             Cette librairie n'utilise pas la librairie SDL: un tir peut tre simul
+             jusqu' sa fin sans fentre graphique et sans dlai d'affichage.
+Note: les implmentations des fonctions se trouvent dans le fichier simulation.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+
+// -------------------------------------------
+// constantes utiles aux calculs mathmatiques
+// -------------------------------------------
+#define PI 3.14159
+
+// ------------------------------------------
+// constantes utiles  la simulation numrique
+// et la modlisation du projectile
+// ------------------------------------------
+#define MASSE           2       // masse de l'objet lanc (kg)
+#define RAYON           0.05    // rayon du projectile (m)
+#define CX              0.4     // coef. de rsistance arodynamique d'une sphre
+#define RHO             1.2     // masse volumique de l'air
+#define GRAVITE         9.8     // acclration gravitationnelle m2/s
+#define C_RESTITUTION   0.95    // coefficient de restitution de vitesse de la paroi lors des rebonds
+#define C_FROTTEMENT    (0.5*CX*RHO*PI*RAYON*RAYON) // coefficient de frottement de l'air pour une sphre
+#define V_INITIALE_MAX  120     // vitesse initiale maximum (m/s)
+#define T_IMMOBILE_MAX  2       // temps d'immobilit maximum du projectile avant de dclarer la fin d'un lancer (s)
+#define DELTAT          0.5     // pas de temps de la simulation numrique du vol du projectile (s)
+#define DECALAGE_REBOND 0.05    // distance  la paroi  laquelle le projectile est replac lors des rebonds
+#define MAX_REBONDS_PAS 8       // nb maximum de rebonds rsolus pendant un mme pas de simulation
+#define EPSILON_COIN    1e-6    // cart maximum entre deux points d'impact pour qu'un coin soit touch
+#define NB_CANDIDATS_COIN   16  // nb de murs proches d'un point d'impact gards sans allocation (voir mur_du_coin)
+#define T_VOL_MAX       600     // dure maximum d'un tir simul hors du jeu (s), au-del le tir est rat
+#define VERSION_SIMULATION 4    //  incrmenter quand le modle change l'issue des tirs (invalide les tables de tirs)
+
+// ------------------------------------------
+// intgrateurs numriques du vol (voir choisir_integrateur)
+// ------------------------------------------
+#define INTEGRATEUR_EULER   0       // Euler semi-implicite (vitesse puis position), ordre 1
+#define INTEGRATEUR_VERLET  1       // Verlet vitesse, ordre 2
+#define INTEGRATEUR_RK4     2       // Runge-Kutta classique, ordre 4
+#define INTEGRATEUR_RK45    3       // Runge-Kutta-Dormand-Prince 5(4)  sous-pas adaptatifs
+#define INTEGRATEUR_ANALYTIQUE 4    // solution exacte du mouvement; les tirs sont simuls par vnements (voir vol_analytique.h)
+#define NB_INTEGRATEURS     5
+#define INTEGRATEUR_DEFAUT  INTEGRATEUR_RK4
+#define TOLERANCE_RK45      1e-6    // erreur maximum estime d'un sous-pas adaptatif (position et vitesse)
+#define MAX_SOUS_PAS_RK45   64      // nb maximum d'essais refuss d'un mme sous-pas adaptatif
+#define PAS_MIN_RK45        1e-6    // dure minimum d'un sous-pas adaptatif (s), accept quelle que soit l'erreur
+
+// ---------------------------------------------
+// dimensions du tableau d'info sur le projectile
+// ---------------------------------------------
+#define COL_TABPRO  (DIMENSION_POINT*POINT_PAR_SEGMENT)     // nb de col du tableau d'info sur le projectile
+#define LIG_TABPRO  2                                       // nb de ligne du tableau d'info sur le projectile
+
+// indices de ligne d'accs aux lments du tableau de projectile
+#define POSITION            0
+#define VITESSE             1
+
+// ---------------------------------------------
+// rsultat de la simulation complte d'un tir
+// ---------------------------------------------
+typedef struct {
+    int touche;         // 1 si la cible est atteinte, 0 si le projectile s'immobilise avant
+    double temps;       // temps de vol simul  la fin du tir (s)
+    int nb_rebonds;     // nombre de rebonds sur les murs
+    int nb_pas;         // nombre de pas de simulation effectus
+} t_resultat_tir;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void calcule_lanceur(int mousex,int mousey,int vmax,int tab_lanceur[]);
+
+int choisir_integrateur(int integrateur);
+int integrateur_simulation();
+void mise_a_jour_ballistique(double tab_projectile[][COL_TABPRO],double *t,double dt);
+int premier_mur_croise(t_niveau* niv, double x0, double y0, double x1, double y1,
+                       double* xr, double* yr);
+int mise_a_jour_rebond(t_niveau* niv,
+                       double tab_projectile[][COL_TABPRO],
+                       double *t,double *dt);
+
+int mise_a_jour_vol(t_niveau* niv, double tab_projectile[][COL_TABPRO], double *t, double dt);
+
+int cible_atteinte(double tab_projectile[][COL_TABPRO],int tab_cible[]);
+int cible_croisee(double tab_projectile[][COL_TABPRO],int tab_cible[],double* f);
+int projectile_immobile(double tab_projectile[][COL_TABPRO]);
+
+int simuler_tir(t_niveau* niv, double vx, double vy, t_resultat_tir* resultat);
+int simuler_tir_pas(t_niveau* niv, double vx, double vy, double dt, t_resultat_tir* resultat);
+
+#endif // SIMULATION_H
@@ -0,0 +1,349 @@
+// -------------------------------------------
+/*
+librairie solveur.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rsolution exhaustive d'un niveau: simulation de tous les tirs possibles
+             rpartie sur plusieurs fils d'excution, et sauvegarde/chargement des
+             tables de tirs.
+Note: les prototypes des fonctions se trouvent dans le fichier solveur.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// fils d'excution et oprations atomiques de la librairie SDL
+// (aucune fentre graphique n'est utilise)
+#include <SDL_thread.h>
+#include <SDL_atomic.h>
+#include <SDL_cpuinfo.h>
+
+#include "solveur.h"
+#include "trace.h"
+
+// ---------------------------------------------
+// en-tte d'un fichier de table de tirs
+// ---------------------------------------------
+typedef struct {
+    char signature[4];              // SIGNATURE_TABLE
+    unsigned int version;           // VERSION_TABLE
+    unsigned int version_simulation;// VERSION_SIMULATION
+    unsigned int integrateur;       // intgrateur numrique des tirs simuls (INTEGRATEUR_...)
+    unsigned int empreinte;         // empreinte du fichier de niveau rsolu
+    unsigned int v_max;             // vitesse initiale maximum
+    unsigned int nb_tirs;           // nb de tirs dans la table
+    unsigned int nb_touches;        // nb de tirs atteignant la cible
+} t_entete_table;
+
+// ---------------------------------------------
+// travail partag entre les fils d'excution du solveur
+// chaque fil prend la prochaine ligne (vy)  simuler
+// ---------------------------------------------
+typedef struct {
+    t_niveau* niv;                  // niveau  rsoudre (lecture seulement)
+    t_table_tirs* table;            // table  remplir
+    SDL_atomic_t prochaine_ligne;   // index de la prochaine ligne de tirs  simuler
+    SDL_atomic_t nb_touches;        // nb de tirs russis
+} t_travail_solveur;
+
+// ---------------------------------------------
+/* fonction: demi_largeur_ligne
+    Description:    calcule le plus grand vx entier tel que vx^2+vy^2 <= v_max^2
+    Paramtre(s):   v_max   longueur max du lanceur
+                    vy      composante verticale de la ligne de tirs
+    Retour:         la demi-largeur de la ligne (-1 si la ligne est vide)
+*/
+static int demi_largeur_ligne(int v_max, int vy)
+{
+    int reste=v_max*v_max-vy*vy;    // valeur max de vx^2
+    int w;
+
+    if (reste<0) return -1;
+    w=(int)sqrt((double)reste);
+    // corriger les ventuelles erreurs d'arrondi de sqrt
+    while ((w+1)*(w+1)<=reste) w++;
+    while (w*w>reste) w--;
+    return w;
+}
+
+// ---------------------------------------------
+/* fonction: nb_tirs_possibles
+    Description:    compte les vecteurs de lancer entiers de longueur au plus v_max
+    Paramtre(s):   v_max   longueur max du lanceur
+    Retour:         le nombre de tirs possibles
+    Ex. d'utilisation:
+                    n=nb_tirs_possibles(V_INITIALE_MAX);
+*/
+int nb_tirs_possibles(int v_max)
+{
+    int vy,n=0;
+    for (vy=-v_max;vy<=v_max;vy++) n+=2*demi_largeur_ligne(v_max,vy)+1;
+    return n;
+}
+
+// ---------------------------------------------
+/* fonction: index_tir
+    Description:    position d'un vecteur de lancer dans une table de tirs. Les tirs
+                    sont rangs par vy croissant puis par vx croissant.
+    Paramtre(s):   v_max   longueur max du lanceur
+                    vx,vy   vecteur de lancer
+    Retour:         l'index du tir dans la table, -1 si le vecteur est trop long
+    Ex. d'utilisation:
+                    issue=table.tab_issues[index_tir(table.v_max,vx,vy)];
+*/
+int index_tir(int v_max, int vx, int vy)
+{
+    int ligne,index=0,w;
+
+    if (vy<-v_max || vy>v_max) return -1;
+    w=demi_largeur_ligne(v_max,vy);
+    if (vx<-w || vx>w) return -1;
+
+    for (ligne=-v_max;ligne<vy;ligne++) index+=2*demi_largeur_ligne(v_max,ligne)+1;
+    return index+vx+w;
+}
+
+// ---------------------------------------------
+/* fonction: fil_solveur
+    Description:    fonction excute par chaque fil du solveur. Prend une ligne de tirs
+                     la fois (compteur atomique) jusqu' puisement des lignes et crit
+                    l'issue de chaque tir directement  sa place dans la table.
+    Paramtre(s):   donnees     adresse du travail partag (t_travail_solveur)
+    Retour:         0
+*/
+static int fil_solveur(void* donnees)
+{
+    t_travail_solveur* travail=(t_travail_solveur*)donnees;
+    int v_max=travail->table->v_max;
+    int ligne,vx,vy,w,debut;
+    int nb_touches=0;
+    t_resultat_tir resultat;
+    t_issue_tir* issue;
+    Uint64 debut_ligne;
+
+    while ((ligne=SDL_AtomicAdd(&travail->prochaine_ligne,1))<=2*v_max){
+        debut_ligne=trace_debut();
+        vy=ligne-v_max;
+        w=demi_largeur_ligne(v_max,vy);
+        debut=index_tir(v_max,-w,vy);
+        for (vx=-w;vx<=w;vx++){
+            simuler_tir(travail->niv,vx,vy,&resultat);
+            issue=&travail->table->tab_issues[debut+vx+w];
+            issue->touche=(unsigned char)resultat.touche;
+            issue->nb_rebonds=(unsigned char)(resultat.nb_rebonds>255?255:resultat.nb_rebonds);
+            issue->temps=(unsigned short)(resultat.temps*100>65535?65535:resultat.temps*100+0.5);
+            nb_touches+=resultat.touche;
+        }
+        trace_fin("solveur","ligne",debut_ligne,vy);
+    }
+    SDL_AtomicAdd(&travail->nb_touches,nb_touches);
+
+    return 0;
+}
+
+// ---------------------------------------------
+/* fonction: fil_solveur_supplementaire
+    Description:    fonction excute par les fils lancs par resoudre_niveau: nomme le
+                    fil dans la trace puis excute fil_solveur
+    Paramtre(s):   donnees     adresse du travail partag (t_travail_solveur)
+    Retour:         0
+*/
+static int fil_solveur_supplementaire(void* donnees)
+{
+    trace_nommer_fil("solveur");
+    return fil_solveur(donnees);
+}
+
+// ---------------------------------------------
+/* fonction: resoudre_niveau
+    Description:    simule tous les tirs possibles d'un niveau et rempli la table de tirs.
+                    Le travail est rparti sur nb_fils fils d'excution (le fil appelant
+                    en fait partie).
+    Paramtre(s):   niv         niveau  rsoudre
+                    v_max       longueur max du lanceur (V_INITIALE_MAX pour le jeu)
+                    nb_fils     nb de fils d'excution (0 pour utiliser tous les processeurs)
+                    table       table de tirs  remplir (alloue par la fonction)
+    Retour:         le nombre de tirs russis, -1 en cas d'erreur d'allocation
+    Ex. d'utilisation:
+                    nb=resoudre_niveau(&niv,V_INITIALE_MAX,0,&table);
+*/
+int resoudre_niveau(t_niveau* niv, int v_max, int nb_fils, t_table_tirs* table)
+{
+    t_travail_solveur travail;
+    SDL_Thread* tab_fils[MAX_FILS];
+    Uint64 debut=trace_debut();
+    int i;
+
+    table->v_max=v_max;
+    table->nb_tirs=nb_tirs_possibles(v_max);
+    table->nb_touches=0;
+    table->tab_issues=(t_issue_tir*)malloc(table->nb_tirs*sizeof(t_issue_tir));
+    if (table->tab_issues==NULL) return -1;
+
+    if (nb_fils<=0) nb_fils=SDL_GetCPUCount();
+    if (nb_fils>MAX_FILS) nb_fils=MAX_FILS;
+
+    travail.niv=niv;
+    travail.table=table;
+    SDL_AtomicSet(&travail.prochaine_ligne,0);
+    SDL_AtomicSet(&travail.nb_touches,0);
+
+    // lancer les fils supplmentaires puis participer au travail
+    for (i=1;i<nb_fils;i++){
+        tab_fils[i]=SDL_CreateThread(fil_solveur_supplementaire,"solveur",&travail);
+    }
+    fil_solveur(&travail);
+    for (i=1;i<nb_fils;i++){
+        if (tab_fils[i]!=NULL) SDL_WaitThread(tab_fils[i],NULL);
+    }
+
+    table->nb_touches=SDL_AtomicGet(&travail.nb_touches);
+    trace_fin("solveur","resoudre_niveau",debut,table->nb_touches);
+    return table->nb_touches;
+}
+
+// ---------------------------------------------
+/* fonction: sauver_table_tirs
+    Description:    sauvegarde une table de tirs  ct du fichier de niveau
+                    (ex: "Niveaux/niveau3.sol")
+    Paramtre(s):   niveau      # du niveau
+                    table       table de tirs  sauvegarder
+    Retour:         1 en cas de succs, 0 sinon
+*/
+int sauver_table_tirs(int niveau, t_table_tirs* table)
+{
+    char nom_fichier[MAX_CHAR];
+    t_entete_table entete;
+    FILE* fp;
+    int reussite;
+
+    memcpy(entete.signature,SIGNATURE_TABLE,4);
+    entete.version=VERSION_TABLE;
+    entete.version_simulation=VERSION_SIMULATION;
+    entete.integrateur=integrateur_simulation();
+    entete.empreinte=table->empreinte;
+    entete.v_max=table->v_max;
+    entete.nb_tirs=table->nb_tirs;
+    entete.nb_touches=table->nb_touches;
+
+    nom_fichier_niveau(niveau,FIN_NOM_FICHIER_TABLE,nom_fichier);
+    fp=fopen(nom_fichier,"wb");
+    if (fp==NULL) return 0;
+    reussite=(fwrite(&entete,sizeof(entete),1,fp)==1 &&
+              fwrite(table->tab_issues,sizeof(t_issue_tir),table->nb_tirs,fp)==(size_t)table->nb_tirs);
+    fclose(fp);
+
+    return reussite;
+}
+
+// ---------------------------------------------
+/* fonction: charger_table_tirs
+    Description:    charge la table de tirs sauvegarde d'un niveau si elle est encore
+                    valide: mme format, mme modle de simulation, mme intgrateur,
+                    mme vitesse max et mme empreinte de fichier de niveau.
+    Paramtre(s):   niveau      # du niveau
+                    empreinte   empreinte actuelle du fichier de niveau
+                    table       table de tirs  remplir (alloue par la fonction)
+    Retour:         1 si une table valide a t charge, 0 sinon
+*/
+int charger_table_tirs(int niveau, unsigned int empreinte, t_table_tirs* table)
+{
+    char nom_fichier[MAX_CHAR];
+    t_entete_table entete;
+    FILE* fp;
+    int valide=0;
+
+    table->tab_issues=NULL;
+
+    nom_fichier_niveau(niveau,FIN_NOM_FICHIER_TABLE,nom_fichier);
+    fp=fopen(nom_fichier,"rb");
+    if (fp==NULL) return 0;
+
+    if (fread(&entete,sizeof(entete),1,fp)==1 &&
+        memcmp(entete.signature,SIGNATURE_TABLE,4)==0 &&
+        entete.version==VERSION_TABLE &&
+        entete.version_simulation==VERSION_SIMULATION &&
+        entete.integrateur==(unsigned int)integrateur_simulation() &&
+        entete.empreinte==empreinte &&
+        entete.v_max==V_INITIALE_MAX &&
+        entete.nb_tirs==(unsigned int)nb_tirs_possibles(V_INITIALE_MAX)){
+
+        table->v_max=entete.v_max;
+        table->nb_tirs=entete.nb_tirs;
+        table->nb_touches=entete.nb_touches;
+        table->empreinte=entete.empreinte;
+        table->tab_issues=(t_issue_tir*)malloc(table->nb_tirs*sizeof(t_issue_tir));
+        if (table->tab_issues!=NULL &&
+            fread(table->tab_issues,sizeof(t_issue_tir),table->nb_tirs,fp)==(size_t)table->nb_tirs){
+            valide=1;
+        }
+        else liberer_table_tirs(table);
+    }
+    fclose(fp);
+
+    return valide;
+}
+
+// ---------------------------------------------
+/* fonction: obtenir_table_tirs
+    Description:    obtient la table de tirs d'un niveau: la table sauvegarde est utilise
+                    si elle correspond au fichier de niveau actuel, sinon le niveau est
+                    rsolu et la nouvelle table est sauvegarde.
+    Paramtre(s):   niveau      # du niveau
+                    nb_fils     nb de fils d'excution (0 pour utiliser tous les processeurs)
+                    recalculer  1 pour ignorer la table sauvegarde
+                    table       table de tirs  remplir
+                    en_cache    adresse o indiquer si la table sauvegarde a t utilise
+    Retour:         le nombre de tirs russis, -1 si le niveau ne peut pas tre charg
+    Ex. d'utilisation:
+                    nb=obtenir_table_tirs(3,0,0,&table,&en_cache);
+*/
+int obtenir_table_tirs(int niveau, int nb_fils, int recalculer, t_table_tirs* table, int* en_cache)
+{
+    char nom_fichier[MAX_CHAR];
+    unsigned int empreinte;
+    t_niveau niv;
+    Uint64 debut;
+    int nb_segments;
+
+    *en_cache=0;
+    nom_fichier_niveau(niveau,FIN_NOM_FICHIER_NIVEAU,nom_fichier);
+    if (!empreinte_fichier(nom_fichier,&empreinte)) return -1;
+
+    if (!recalculer && charger_table_tirs(niveau,empreinte,table)){
+        *en_cache=1;
+        return table->nb_touches;
+    }
+
+    initialiser_niveau(&niv);
+    debut=trace_debut();
+    nb_segments=charger_niveau(niveau,&niv);
+    trace_fin("niveau","charger_niveau",debut,niveau);
+    if (nb_segments<0 || resoudre_niveau(&niv,V_INITIALE_MAX,nb_fils,table)<0){
+        liberer_niveau(&niv);
+        return -1;
+    }
+    liberer_niveau(&niv);
+    table->empreinte=empreinte;
+    if (!sauver_table_tirs(niveau,table)){
+        printf("[ERR] - Sauvegarde de la table de tirs du niveau %d impossible\n",niveau);
+    }
+
+    return table->nb_touches;
+}
+
+// ---------------------------------------------
+/* fonction: liberer_table_tirs
+    Description:    libre la mmoire d'une table de tirs
+    Paramtre(s):   table       table de tirs  librer
+    Retour:         aucun
+*/
+void liberer_table_tirs(t_table_tirs* table)
+{
+    free(table->tab_issues);
+    table->tab_issues=NULL;
+    table->nb_tirs=0;
+}
@@ -0,0 +1,68 @@
+#ifndef SOLVEUR_H
+#define SOLVEUR_H
+
+// -------------------------------------------
+/*
+librairie solveur.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Rsolution exhaustive d'un niveau: simulation de tous les tirs possibles
+             et mise en mmoire de leur issue dans une table de tirs.
+             Le lanceur est reprsent par des coordonnes entires dont la longueur
+             est limite  V_INITIALE_MAX (voir calcule_lanceur). Il y a donc un nombre
+             fini de vecteurs de lancer (environ 45 000 pour V_INITIALE_MAX=120): tous
+             les vecteurs entiers (vx,vy) tels que vx^2+vy^2 <= V_INITIALE_MAX^2.
+             Les tirs sont rpartis sur plusieurs fils d'excution (threads SDL).
+             Les tables sont sauvegardes  ct du fichier de niveau (ex: niveau3.sol)
+             avec l'empreinte du fichier de niveau pour pouvoir tre invalides quand
+             celui-ci est modifi.
+Note: les implmentations des fonctions se trouvent dans le fichier solveur.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+#include "simulation.h"
+
+// ---------------------------------------------
+// constantes du solveur
+// ---------------------------------------------
+#define FIN_NOM_FICHIER_TABLE   ".sol"      // extension des fichiers de table de tirs (ex:niveau4.sol)
+#define SIGNATURE_TABLE         "BGST"      // signature au dbut d'un fichier de table de tirs
+#define VERSION_TABLE           2           // version du format des fichiers de table de tirs
+#define MAX_FILS                64          // nb maximum de fils d'excution du solveur
+
+// ---------------------------------------------
+// issue d'un tir (4 octets par tir)
+// ---------------------------------------------
+typedef struct {
+    unsigned char touche;       // 1 si la cible est atteinte, 0 sinon
+    unsigned char nb_rebonds;   // nb de rebonds (limit  255)
+    unsigned short temps;       // temps de vol en centimes de seconde (limit  65535)
+} t_issue_tir;
+
+// ---------------------------------------------
+// table des issues de tous les tirs d'un niveau
+// les tirs sont rangs par vy croissant puis par vx croissant
+// ---------------------------------------------
+typedef struct {
+    int v_max;                  // vitesse initiale maximum utilise (longueur max du lanceur)
+    int nb_tirs;                // nb de tirs dans la table
+    int nb_touches;             // nb de tirs atteignant la cible
+    unsigned int empreinte;     // empreinte du fichier de niveau rsolu
+    t_issue_tir* tab_issues;    // issues des tirs (nb_tirs lments)
+} t_table_tirs;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int nb_tirs_possibles(int v_max);
+int index_tir(int v_max, int vx, int vy);
+
+int resoudre_niveau(t_niveau* niv, int v_max, int nb_fils, t_table_tirs* table);
+int sauver_table_tirs(int niveau, t_table_tirs* table);
+int charger_table_tirs(int niveau, unsigned int empreinte, t_table_tirs* table);
+int obtenir_table_tirs(int niveau, int nb_fils, int recalculer, t_table_tirs* table, int* en_cache);
+void liberer_table_tirs(t_table_tirs* table);
+
+#endif // SOLVEUR_H
@@ -0,0 +1,300 @@
+// -------------------------------------------
+/*
+librairie trace.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Trace chronologique en format JSON  Chrome trace , un tampon par fil
+             d'excution.
+Note: les prototypes des fonctions se trouvent dans le fichier trace.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// fils d'excution, stockage propre  chaque fil et compteur haute prcision de SDL
+#include <SDL_thread.h>
+#include <SDL_atomic.h>
+#include <SDL_timer.h>
+#include <SDL_assert.h>
+
+#include "trace.h"
+
+// ---------------------------------------------
+// vnement enregistr
+// ---------------------------------------------
+typedef struct {
+    const char* categorie;  // catgorie (chane constante)
+    const char* nom;        // nom de l'intervalle (chane constante)
+    Uint64 debut;           // compteur haute prcision au dbut de l'intervalle
+    Uint64 duree;           // dure de l'intervalle (tics du compteur)
+    int valeur;             // argument de l'vnement (TRACE_SANS_VALEUR si aucun)
+} t_evenement_trace;
+
+// ---------------------------------------------
+// tampon circulaire d'un fil d'excution
+// ---------------------------------------------
+typedef struct s_tampon_trace {
+    SDL_threadID fil;                   // identifiant du fil propritaire
+    int generation;                     // trace pour laquelle le tableau d'vnements a t cr
+    SDL_atomic_t fil_termine;           // 1 quand le fil propritaire est termin
+    const char* nom_fil;                // nom affich du fil (NULL si aucun)
+    long nb_evenements;                 // nb d'vnements enregistrs depuis le dbut
+    long capacite;                      // taille du tableau d'vnements
+    t_evenement_trace* tab_evenements;  // vnements (tableau circulaire  TRACE_MAX_EVENEMENTS, NULL entre deux traces)
+    struct s_tampon_trace* suivant;     // tampon du fil suivant
+} t_tampon_trace;
+
+static SDL_atomic_t active;             // 1 entre trace_demarrer et trace_arreter
+static SDL_atomic_t nb_enregistrements; // nb de trace_fin en cours (doit tre 0  l'arrt)
+static int generation=0;                // numro de la trace en cours (incrment  chaque arrt)
+static char nom_fichier_trace[FILENAME_MAX];    // fichier JSON  crire
+static Uint64 debut_trace;              // compteur au dmarrage (instant 0 de la trace)
+static SDL_TLSID cle_tampon=0;          // cl du tampon propre  chaque fil
+static SDL_SpinLock verrou_tampons=0;   // protge la liste des tampons (cration et arrt seulement)
+static t_tampon_trace* premier_tampon=NULL;     // liste des tampons de tous les fils
+
+// ---------------------------------------------
+/* fonction: fil_termine
+    Description:    destructeur du stockage propre au fil: marque le tampon du fil
+                    termin pour que trace_arreter le libre
+    Paramtre(s):   donnee      tampon du fil qui se termine
+    Retour:         aucun
+*/
+static void fil_termine(void* donnee)
+{
+    SDL_AtomicSet(&((t_tampon_trace*)donnee)->fil_termine,1);
+}
+
+// ---------------------------------------------
+/* fonction: tampon_du_fil
+    Description:    tampon du fil d'excution appelant, cr et ajout  la liste au
+                    premier vnement du fil (seul moment o un verrou est pris).
+                    Le tampon d'une trace prcdente (autre gnration) reste attach
+                    au fil mais son tableau d'vnements a t libr par trace_arreter:
+                    un nouveau tableau est allou pour la trace en cours.
+    Paramtre(s):   aucun
+    Retour:         le tampon, NULL si la mmoire manque
+*/
+static t_tampon_trace* tampon_du_fil()
+{
+    t_tampon_trace* tampon=(t_tampon_trace*)SDL_TLSGet(cle_tampon);
+    t_evenement_trace* tab_evenements;
+
+    if (tampon!=NULL && tampon->generation==generation) return tampon;
+    tab_evenements=(t_evenement_trace*)malloc(TRACE_EVENEMENTS_INITIAL*sizeof(t_evenement_trace));
+    if (tab_evenements==NULL) return NULL;
+    // tampon d'une trace prcdente: il est encore dans la liste, seul le tableau est recr
+    if (tampon!=NULL){
+        SDL_AtomicLock(&verrou_tampons);
+        tampon->tab_evenements=tab_evenements;
+        tampon->nom_fil=NULL;
+        tampon->nb_evenements=0;
+        tampon->capacite=TRACE_EVENEMENTS_INITIAL;
+        tampon->generation=generation;
+        SDL_AtomicUnlock(&verrou_tampons);
+        return tampon;
+    }
+    tampon=(t_tampon_trace*)malloc(sizeof(t_tampon_trace));
+    if (tampon==NULL){
+        free(tab_evenements);
+        return NULL;
+    }
+    tampon->tab_evenements=tab_evenements;
+    tampon->fil=SDL_ThreadID();
+    tampon->generation=generation;
+    SDL_AtomicSet(&tampon->fil_termine,0);
+    tampon->nom_fil=NULL;
+    tampon->nb_evenements=0;
+    tampon->capacite=TRACE_EVENEMENTS_INITIAL;
+    SDL_TLSSet(cle_tampon,tampon,fil_termine);
+
+    SDL_AtomicLock(&verrou_tampons);
+    tampon->suivant=premier_tampon;
+    premier_tampon=tampon;
+    SDL_AtomicUnlock(&verrou_tampons);
+    return tampon;
+}
+
+// ---------------------------------------------
+/* fonction: trace_demarrer
+    Description:    dmarre l'enregistrement de la trace
+    Paramtre(s):   nom_fichier     fichier JSON crit par trace_arreter
+    Retour:         1 si la trace est dmarre, 0 sinon
+    Ex. d'utilisation:
+                    trace_demarrer("bongalistix.json");
+*/
+int trace_demarrer(const char* nom_fichier)
+{
+    if (SDL_AtomicGet(&active)) return 0;
+    if (cle_tampon==0) cle_tampon=SDL_TLSCreate();
+    if (cle_tampon==0) return 0;
+    snprintf(nom_fichier_trace,sizeof(nom_fichier_trace),"%s",nom_fichier);
+    debut_trace=SDL_GetPerformanceCounter();
+    SDL_AtomicSet(&active,1);
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: trace_active
+    Description:    indique si la trace est en cours d'enregistrement
+    Paramtre(s):   aucun
+    Retour:         1 si la trace est active, 0 sinon
+*/
+int trace_active()
+{
+    return SDL_AtomicGet(&active);
+}
+
+// ---------------------------------------------
+/* fonction: trace_debut
+    Description:    dbut d'un intervalle  mesurer
+    Paramtre(s):   aucun
+    Retour:         le compteur haute prcision  passer  trace_fin (0 si la trace
+                    n'est pas active: trace_fin n'enregistrera rien)
+    Ex. d'utilisation:
+                    Uint64 debut=trace_debut();
+                    charger_niveau(niveau,&niv);
+                    trace_fin("niveau","charger_niveau",debut,niveau);
+*/
+Uint64 trace_debut()
+{
+    return SDL_AtomicGet(&active)?SDL_GetPerformanceCounter():0;
+}
+
+// ---------------------------------------------
+/* fonction: trace_fin
+    Description:    fin d'un intervalle: l'vnement est ajout au tampon du fil appelant
+    Paramtre(s):   categorie   catgorie de l'vnement (chane constante)
+                    nom         nom de l'vnement (chane constante)
+                    debut       valeur renvoye par trace_debut
+                    valeur      argument de l'vnement (TRACE_SANS_VALEUR si aucun)
+    Retour:         aucun
+*/
+void trace_fin(const char* categorie, const char* nom, Uint64 debut, int valeur)
+{
+    t_tampon_trace* tampon;
+    t_evenement_trace* evenement;
+    t_evenement_trace* tab_agrandi;
+
+    if (debut==0) return;
+    // compt avant de vrifier la trace active: trace_arreter dtecte un enregistrement en cours
+    SDL_AtomicIncRef(&nb_enregistrements);
+    if (!SDL_AtomicGet(&active) || (tampon=tampon_du_fil())==NULL){
+        SDL_AtomicAdd(&nb_enregistrements,-1);
+        return;
+    }
+    // tampon plein: le doubler tant que la taille max n'est pas atteinte
+    // (seul le fil propritaire accde  son tampon pendant l'enregistrement)
+    if (tampon->nb_evenements==tampon->capacite && tampon->capacite<TRACE_MAX_EVENEMENTS){
+        tab_agrandi=(t_evenement_trace*)realloc(tampon->tab_evenements,2*tampon->capacite*sizeof(t_evenement_trace));
+        if (tab_agrandi==NULL){
+            SDL_AtomicAdd(&nb_enregistrements,-1);
+            return;
+        }
+        tampon->tab_evenements=tab_agrandi;
+        tampon->capacite*=2;
+    }
+    evenement=&tampon->tab_evenements[tampon->nb_evenements%tampon->capacite];
+    evenement->categorie=categorie;
+    evenement->nom=nom;
+    evenement->debut=debut;
+    evenement->duree=SDL_GetPerformanceCounter()-debut;
+    evenement->valeur=valeur;
+    tampon->nb_evenements++;
+    SDL_AtomicAdd(&nb_enregistrements,-1);
+}
+
+// ---------------------------------------------
+/* fonction: trace_nommer_fil
+    Description:    donne un nom au fil d'excution appelant dans la trace
+    Paramtre(s):   nom     nom du fil (chane constante)
+    Retour:         aucun
+    Ex. d'utilisation:
+                    trace_nommer_fil("solveur");
+*/
+void trace_nommer_fil(const char* nom)
+{
+    t_tampon_trace* tampon;
+
+    if (!SDL_AtomicGet(&active)) return;
+    tampon=tampon_du_fil();
+    if (tampon!=NULL) tampon->nom_fil=nom;
+}
+
+// ---------------------------------------------
+/* fonction: trace_arreter
+    Description:    arrte la trace, crit le fichier JSON et libre les tampons
+    Note:           les fils d'excution qui enregistrent des vnements (prchargement,
+                    rechargement, fils du solveur...) doivent tre termins ou arrts
+                    avant l'appel: leurs tampons sont lus puis librs sans verrou.
+                    Un enregistrement encore en cours dclenche une assertion.
+    Paramtre(s):   aucun
+    Retour:         le nb d'vnements crits, -1 si le fichier ne peut pas tre crit
+                    ou si la trace n'tait pas active
+*/
+int trace_arreter()
+{
+    double us_par_tic=1e6/SDL_GetPerformanceFrequency();
+    t_tampon_trace* tampon;
+    t_tampon_trace* suivant;
+    t_tampon_trace** lien;
+    t_evenement_trace* evenement;
+    FILE* fichier;
+    long i,premier;
+    int nb_ecrits=0,separateur=0;
+
+    if (!SDL_AtomicGet(&active)) return -1;
+    SDL_AtomicSet(&active,0);
+    SDL_assert(SDL_AtomicGet(&nb_enregistrements)==0);
+
+    fichier=fopen(nom_fichier_trace,"w");
+    if (fichier!=NULL){
+        fprintf(fichier,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        for (tampon=premier_tampon;tampon!=NULL;tampon=tampon->suivant){
+            // tampon d'un fil qui n'a rien enregistr depuis une trace prcdente
+            if (tampon->generation!=generation) continue;
+            if (tampon->nom_fil!=NULL){
+                fprintf(fichier,"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+                        "\"args\":{\"name\":\"%s\"}}",separateur?",\n":"",(unsigned long)tampon->fil,tampon->nom_fil);
+                separateur=1;
+            }
+            // seuls les derniers vnements du fil sont conservs (tableau circulaire)
+            premier=(tampon->nb_evenements>tampon->capacite)?tampon->nb_evenements-tampon->capacite:0;
+            for (i=premier;i<tampon->nb_evenements;i++){
+                evenement=&tampon->tab_evenements[i%tampon->capacite];
+                fprintf(fichier,"%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,"
+                        "\"ts\":%.3lf,\"dur\":%.3lf",separateur?",\n":"",evenement->nom,evenement->categorie,
+                        (unsigned long)tampon->fil,(double)(Sint64)(evenement->debut-debut_trace)*us_par_tic,
+                        evenement->duree*us_par_tic);
+                if (evenement->valeur!=TRACE_SANS_VALEUR) fprintf(fichier,",\"args\":{\"valeur\":%d}",evenement->valeur);
+                fprintf(fichier,"}");
+                separateur=1;
+                nb_ecrits++;
+            }
+        }
+        fprintf(fichier,"\n]}\n");
+        if (fclose(fichier)!=0) nb_ecrits=-1;
+    }
+    else nb_ecrits=-1;
+
+    // librer les vnements; les tampons des fils encore vivants restent dans leur
+    // stockage propre et dans la liste, mais la nouvelle gnration les invalide:
+    // tampon_du_fil leur recrera un tableau si la trace redmarre
+    SDL_AtomicLock(&verrou_tampons);
+    generation++;
+    lien=&premier_tampon;
+    for (tampon=premier_tampon;tampon!=NULL;tampon=suivant){
+        suivant=tampon->suivant;
+        free(tampon->tab_evenements);
+        tampon->tab_evenements=NULL;
+        if (SDL_AtomicGet(&tampon->fil_termine)){
+            *lien=suivant;
+            free(tampon);
+        }
+        else lien=&tampon->suivant;
+    }
+    SDL_AtomicUnlock(&verrou_tampons);
+    return nb_ecrits;
+}
@@ -0,0 +1,46 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// -------------------------------------------
+/*
+librairie trace.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Trace chronologique facultative du programme (modes du jeu, chargements
+             de niveau, pas de simulation, lignes du solveur...) crite en format JSON
+              Chrome trace , lisible par Perfetto (ui.perfetto.dev) ou chrome://tracing.
+             Chaque intervalle mesur est un vnement complet (dbut et dure) ajout
+              la fin de l'intervalle dans le tampon du fil d'excution qui l'a mesur:
+             l'enregistrement ne prend aucun verrou et cote deux lectures du compteur
+             haute prcision. Chaque tampon double de taille au besoin  partir de
+             TRACE_EVENEMENTS_INITIAL vnements, puis devient circulaire 
+             TRACE_MAX_EVENEMENTS: les vnements les plus anciens du fil sont alors
+             remplacs, ce qui borne la mmoire utilise pendant les longues sessions.
+             Tant que la trace n'est pas dmarre, les fonctions ne font rien.
+             Les noms et catgories doivent tre des chanes constantes (non copies)
+             sans guillemets ni barres obliques inverses.
+Note: les implmentations des fonctions se trouvent dans le fichier trace.c
+*/
+// -------------------------------------------
+
+#include <SDL_stdinc.h>
+
+// ---------------------------------------------
+// paramtres de la trace
+// ---------------------------------------------
+#define TRACE_EVENEMENTS_INITIAL 256    // taille initiale du tampon d'un fil d'excution
+#define TRACE_MAX_EVENEMENTS    65536   // nb d'vnements conservs par fil d'excution
+#define TRACE_SANS_VALEUR       (-1)    // valeur d'un vnement sans argument
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+int trace_demarrer(const char* nom_fichier);
+int trace_active();
+Uint64 trace_debut();
+void trace_fin(const char* categorie, const char* nom, Uint64 debut, int valeur);
+void trace_nommer_fil(const char* nom);
+int trace_arreter();
+
+#endif // TRACE_H
@@ -0,0 +1,419 @@
+// -------------------------------------------
+/*
+librairie vol_analytique.c
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Simulation du vol du projectile par vnements (solutions exactes du
+             mouvement entre les rebonds).
+Note: les prototypes des fonctions se trouvent dans le fichier vol_analytique.h
+*/
+// -------------------------------------------
+
+#include <stdlib.h>
+#include <math.h>
+#include "geometrie.h"
+#include "vol_analytique.h"
+
+// ---------------------------------------------
+/* fonction: acosh_1p
+    Description:    acosh(1+e) calcul sans perte de prcision quand e est petit
+                    (projectile proche du sommet de sa trajectoire)
+    Paramtre(s):   e   cart  1 de l'argument (e>=0)
+    Retour:         acosh(1+e)
+*/
+static double acosh_1p(double e)
+{
+    return log1p(e+sqrt(e*(e+2)));
+}
+
+// ---------------------------------------------
+/* fonction: preparer_arc_vol
+    Description:    calcule les paramtres de la solution exacte du mouvement  partir
+                    d'une position et d'une vitesse (dbut d'un arc de vol)
+    Paramtre(s):   arc     arc de vol  prparer
+                    x0,y0   position au dbut de l'arc
+                    vx0,vy0 vitesse au dbut de l'arc
+    Retour:         aucun
+    Ex. d'utilisation:
+                    preparer_arc_vol(&arc,x,y,vx,vy);
+*/
+void preparer_arc_vol(t_arc_vol* arc, double x0, double y0, double vx0, double vy0)
+{
+    double a=VITESSE_LIMITE,w=PULSATION_CHUTE;
+    double u=-vy0;      // vitesse de chute
+    double phi;
+
+    arc->x0=x0;
+    arc->y0=y0;
+    arc->vx0=vx0;
+    arc->vy0=vy0;
+    arc->t_sommet=0;
+    arc->y_sommet=y0;
+    arc->psi=0;
+
+    if (vy0>0){
+        // monte: vy=a*tan(w*(t_sommet-t)) jusqu'au sommet
+        arc->phase=PHASE_MONTEE;
+        arc->t_sommet=atan(vy0/a)/w;
+        arc->y_sommet=y0+log1p((vy0/a)*(vy0/a))/(2*K_FROTTEMENT);
+    }
+    else if (u<a*(1-1e-12)){
+        // chute lente: mme mouvement qu'une chute partie d'un sommet virtuel antrieur
+        arc->phase=PHASE_CHUTE;
+        phi=atanh(u/a);
+        arc->t_sommet=-phi/w;
+        arc->y_sommet=y0+log(cosh(phi))/K_FROTTEMENT;
+    }
+    else if (u>a*(1+1e-12)){
+        // chute rapide: vy=-a*coth(psi+w*t), le frottement ralentit le projectile
+        arc->phase=PHASE_CHUTE_RAPIDE;
+        arc->psi=atanh(a/u);
+    }
+    else arc->phase=PHASE_LIMITE;
+}
+
+// ---------------------------------------------
+/* fonction: position_arc_vol
+    Description:    position et vitesse exactes du projectile sur un arc de vol
+    Paramtre(s):   arc     arc de vol prpar (voir preparer_arc_vol)
+                    t       temps coul depuis le dbut de l'arc (t>=0)
+                    x,y     adresses o placer la position
+                    vx,vy   adresses o placer la vitesse
+    Retour:         aucun
+    Ex. d'utilisation:
+                    position_arc_vol(&arc,0.5,&x,&y,&vx,&vy);
+*/
+void position_arc_vol(t_arc_vol* arc, double t, double* x, double* y, double* vx, double* vy)
+{
+    double a=VITESSE_LIMITE,w=PULSATION_CHUTE;
+    double d,th,tau,z;
+
+    // mouvement horizontal: frottement seul
+    if (arc->vx0==0){
+        *x=arc->x0;
+        *vx=0;
+    }
+    else{
+        d=K_FROTTEMENT*fabs(arc->vx0)*t;
+        *vx=arc->vx0/(1+d);
+        *x=arc->x0+copysign(log1p(d)/K_FROTTEMENT,arc->vx0);
+    }
+
+    // mouvement vertical: frottement et gravit
+    switch (arc->phase){
+        case PHASE_MONTEE:
+            if (t<=arc->t_sommet){
+                th=w*(arc->t_sommet-t);
+                *vy=a*tan(th);
+                *y=arc->y_sommet+log(cos(th))/K_FROTTEMENT;
+                break;
+            }
+            // aprs le sommet: chute (mme calcul que la chute lente)
+            /* fallthrough */
+        case PHASE_CHUTE:
+            tau=w*(t-arc->t_sommet);
+            *vy=-a*tanh(tau);
+            *y=arc->y_sommet-log(cosh(tau))/K_FROTTEMENT;
+            break;
+        case PHASE_CHUTE_RAPIDE:
+            z=arc->psi+w*t;
+            *vy=-a/tanh(z);
+            *y=arc->y0-log(sinh(z)/sinh(arc->psi))/K_FROTTEMENT;
+            break;
+        default:
+            *vy=-a;
+            *y=arc->y0-a*t;
+            break;
+    }
+}
+
+// ---------------------------------------------
+/* fonction: vol_analytique
+    Description:    fait avancer exactement le projectile d'une dure t, sans les murs
+                    (intgrateur INTEGRATEUR_ANALYTIQUE de la simulation par pas)
+    Paramtre(s):   x0,y0,vx0,vy0   position et vitesse de dpart
+                    t               dure du vol
+                    x,y,vx,vy       adresses o placer la position et la vitesse finales
+    Retour:         aucun
+    Ex. d'utilisation:
+                    vol_analytique(x,y,vx,vy,DELTAT,&x,&y,&vx,&vy);
+*/
+void vol_analytique(double x0, double y0, double vx0, double vy0, double t,
+                    double* x, double* y, double* vx, double* vy)
+{
+    t_arc_vol arc;
+
+    preparer_arc_vol(&arc,x0,y0,vx0,vy0);
+    position_arc_vol(&arc,t,x,y,vx,vy);
+}
+
+// ---------------------------------------------
+/* fonction: temps_abscisse
+    Description:    instant o le projectile atteint une abscisse sur un arc de vol
+                    (le mouvement horizontal est monotone: au plus un instant)
+    Paramtre(s):   arc     arc de vol
+                    xc      abscisse  atteindre
+    Retour:         l'instant (depuis le dbut de l'arc), HUGE_VAL si jamais atteinte
+*/
+static double temps_abscisse(t_arc_vol* arc, double xc)
+{
+    double d=(xc-arc->x0)*((arc->vx0>0)?1:-1);   // distance  parcourir dans le sens du mouvement
+
+    if (arc->vx0==0 || d<=0) return HUGE_VAL;
+    return expm1(K_FROTTEMENT*d)/(K_FROTTEMENT*fabs(arc->vx0));
+}
+
+// ---------------------------------------------
+/* fonction: temps_ordonnee
+    Description:    instants o le projectile atteint une ordonne sur un arc de vol
+                    (au plus deux: en montant puis en redescendant)
+    Paramtre(s):   arc     arc de vol
+                    yc      ordonne  atteindre
+                    tab_t   tableau de 2 instants  remplir, en ordre croissant
+    Retour:         le nb d'instants trouvs (0, 1 ou 2)
+*/
+static int temps_ordonnee(t_arc_vol* arc, double yc, double tab_t[])
+{
+    double a=VITESSE_LIMITE,w=PULSATION_CHUTE;
+    int nb=0;
+
+    switch (arc->phase){
+        case PHASE_MONTEE:
+            if (yc>arc->y_sommet) return 0;
+            if (yc>arc->y0){
+                // en montant: cos(w*(t_sommet-t))=exp(-k*(y_sommet-yc))
+                tab_t[nb++]=arc->t_sommet-2*asin(sqrt(-expm1(-K_FROTTEMENT*(arc->y_sommet-yc))/2))/w;
+            }
+            if (yc<arc->y_sommet){
+                // en redescendant: cosh(w*(t-t_sommet))=exp(k*(y_sommet-yc))
+                tab_t[nb++]=arc->t_sommet+acosh_1p(expm1(K_FROTTEMENT*(arc->y_sommet-yc)))/w;
+            }
+            break;
+        case PHASE_CHUTE:
+            if (yc<arc->y0) tab_t[nb++]=arc->t_sommet+acosh_1p(expm1(K_FROTTEMENT*(arc->y_sommet-yc)))/w;
+            break;
+        case PHASE_CHUTE_RAPIDE:
+            if (yc<arc->y0) tab_t[nb++]=(asinh(sinh(arc->psi)*exp(K_FROTTEMENT*(arc->y0-yc)))-arc->psi)/w;
+            break;
+        default:
+            if (yc<arc->y0) tab_t[nb++]=(arc->y0-yc)/a;
+            break;
+    }
+    return nb;
+}
+
+// ---------------------------------------------
+/* fonction: temps_mur
+    Description:    premier instant o le projectile touche un mur horizontal ou vertical
+                    sur un arc de vol
+    Paramtre(s):   arc         arc de vol
+                    mur         mur compil (SEGMENT_HORIZONTAL ou SEGMENT_VERTICAL)
+                    t_max       instant au-del duquel la recherche est inutile
+                    xr,yr       adresses o placer le point d'impact
+    Retour:         l'instant de l'impact, HUGE_VAL si le mur n'est pas touch avant t_max
+*/
+static double temps_mur(t_arc_vol* arc, const t_segment_compile* mur, double t_max,
+                        double* xr, double* yr)
+{
+    double tab_t[2],x,y,vx,vy;
+    int nb,i;
+
+    if (mur->orientation==SEGMENT_VERTICAL){
+        tab_t[0]=temps_abscisse(arc,mur->ax);
+        nb=(tab_t[0]<HUGE_VAL);
+    }
+    else nb=temps_ordonnee(arc,mur->ay,tab_t);
+
+    for (i=0;i<nb;i++){
+        if (tab_t[i]<VOL_T_MIN_EVENEMENT) continue;
+        if (tab_t[i]>=t_max) break;
+        position_arc_vol(arc,tab_t[i],&x,&y,&vx,&vy);
+        // le point d'impact est sur la droite du mur: seule l'autre coordonne est vrifie
+        if (mur->orientation==SEGMENT_VERTICAL){
+            x=mur->ax;
+            if (y<mur->y_min || y>mur->y_max) continue;
+        }
+        else{
+            y=mur->ay;
+            if (x<mur->x_min || x>mur->x_max) continue;
+        }
+        *xr=x;
+        *yr=y;
+        return tab_t[i];
+    }
+    return HUGE_VAL;
+}
+
+// ---------------------------------------------
+/* fonction: temps_cible
+    Description:    premier instant o le projectile est dans la cible sur un arc de vol.
+                    Le projectile entre dans la cible au dbut de l'arc ou quand il
+                    atteint un de ses bords: ces instants sont essays en ordre croissant.
+    Paramtre(s):   arc         arc de vol
+                    tab_cible   coordonnes de la cible
+                    t_max       instant au-del duquel la recherche est inutile
+    Retour:         l'instant d'entre dans la cible, HUGE_VAL si pas avant t_max
+*/
+static double temps_cible(t_arc_vol* arc, int tab_cible[], double t_max)
+{
+    double tab_candidats[7],tab_t[2];
+    double x,y,vx,vy,tmp,t_entree=HUGE_VAL;
+    int nb=0,i,j,k;
+
+    tab_candidats[nb++]=0;
+    tab_candidats[nb++]=temps_abscisse(arc,tab_cible[X0]);
+    tab_candidats[nb++]=temps_abscisse(arc,tab_cible[X1]);
+    k=temps_ordonnee(arc,tab_cible[Y0],tab_t);
+    for (i=0;i<k;i++) tab_candidats[nb++]=tab_t[i];
+    k=temps_ordonnee(arc,tab_cible[Y1],tab_t);
+    for (i=0;i<k;i++) tab_candidats[nb++]=tab_t[i];
+
+    // tri par insertion des instants candidats
+    for (i=1;i<nb;i++){
+        for (j=i;j>0 && tab_candidats[j]<tab_candidats[j-1];j--){
+            tmp=tab_candidats[j]; tab_candidats[j]=tab_candidats[j-1]; tab_candidats[j-1]=tmp;
+        }
+    }
+
+    for (i=0;i<nb && tab_candidats[i]<t_max;i++){
+        position_arc_vol(arc,tab_candidats[i],&x,&y,&vx,&vy);
+        if (x>=tab_cible[X0]-VOL_MARGE_CIBLE && x<=tab_cible[X1]+VOL_MARGE_CIBLE &&
+            y>=tab_cible[Y0]-VOL_MARGE_CIBLE && y<=tab_cible[Y1]+VOL_MARGE_CIBLE){
+            t_entree=tab_candidats[i];
+            break;
+        }
+    }
+    return t_entree;
+}
+
+// ---------------------------------------------
+/* fonction: niveau_analytique
+    Description:    vrifie que tous les murs du niveau sont horizontaux ou verticaux,
+                    condition pour simuler ses tirs par vnements
+    Paramtre(s):   niv     niveau charg
+    Retour:         1 si le niveau peut tre simul par vnements, 0 sinon
+*/
+int niveau_analytique(t_niveau* niv)
+{
+    int i;
+
+    for (i=0;i<niv->nb_segments;i++){
+        if (niv->tab_murs[i].orientation==SEGMENT_OBLIQUE) return 0;
+    }
+    return 1;
+}
+
+// ---------------------------------------------
+/* fonction: simuler_tir_analytique
+    Description:    Simule un tir complet de rebond en rebond avec les solutions exactes
+                    du mouvement. Pour chaque arc de vol:
+                    1-calculer l'instant o chaque mur est touch et garder le plus proche
+                      ( galit, le mur de plus petit indice)
+                    2-si la cible est atteinte avant ce mur, le tir est russi
+                    3-sinon, placer le projectile au point d'impact et appliquer les mmes
+                      rgles de rebond que la simulation par pas: inversion de la vitesse
+                      perpendiculaire au mur (les deux dans un coin), dcalage de
+                      DECALAGE_REBOND et coefficient de restitution
+                    Le tir est rat si le projectile reste dans le mme pixel pendant
+                    T_IMMOBILE_MAX (aux instants des rebonds et au sommet des arcs),
+                    aprs VOL_MAX_EVENEMENTS rebonds ou quand le temps de vol dpasse
+                    T_VOL_MAX.
+    Paramtre(s):   niv         niveau dans lequel le tir est simul (murs horizontaux
+                                et verticaux seulement, voir niveau_analytique)
+                    vx,vy       vitesse initiale du projectile (vecteur du lanceur)
+                    resultat    adresse de la structure o placer le rsultat du tir;
+                                nb_pas est le nb d'arcs de vol calculs
+    Retour:         1 si la cible est atteinte, 0 sinon
+    Ex. d'utilisation:
+                    if (niveau_analytique(&niv)) simuler_tir_analytique(&niv,30,40,&resultat);
+*/
+int simuler_tir_analytique(t_niveau* niv, double vx, double vy, t_resultat_tir* resultat)
+{
+    t_arc_vol arc;
+    double x=niv->tab_lanceur[X0],y=niv->tab_lanceur[Y0];
+    double t=0;                     // temps de vol au dbut de l'arc
+    double t_mur,t_cible,t_max,t_j; // instants (depuis le dbut de l'arc)
+    double xr=0,yr=0,xj,yj,vx_impact,vy_impact;
+    double px_immobile,py_immobile; // pixel occup depuis t_immobile
+    double t_immobile=0;            // dbut de l'immobilit
+    int mur,i,coin,bouge;
+
+    resultat->touche=0;
+    resultat->nb_rebonds=0;
+    resultat->nb_pas=0;
+    px_immobile=floor(x);
+    py_immobile=floor(y);
+
+    while (resultat->nb_rebonds<VOL_MAX_EVENEMENTS){
+        preparer_arc_vol(&arc,x,y,vx,vy);
+        resultat->nb_pas++;
+        t_max=T_VOL_MAX-t;
+
+        // 1-mur touch le plus tt
+        mur=-1;
+        t_mur=t_max;
+        for (i=0;i<niv->nb_segments;i++){
+            t_j=temps_mur(&arc,&niv->tab_murs[i],t_mur,&xj,&yj);
+            if (t_j<t_mur){
+                t_mur=t_j;
+                mur=i;
+                xr=xj;
+                yr=yj;
+            }
+        }
+
+        // 2-cible atteinte avant le mur
+        t_cible=temps_cible(&arc,niv->tab_cible,t_mur);
+        if (t_cible<HUGE_VAL){
+            resultat->touche=1;
+            t+=t_cible;
+            break;
+        }
+        if (mur<0){
+            t=T_VOL_MAX;
+            break;
+        }
+
+        // 3-rebond au point d'impact
+        position_arc_vol(&arc,t_mur,&xj,&yj,&vx_impact,&vy_impact);
+        coin=0;
+        for (i=0;i<niv->nb_segments && !coin;i++){
+            if (i==mur || niv->tab_murs[i].orientation==niv->tab_murs[mur].orientation) continue;
+            // rejet rapide: le coin est au point d'impact
+            if (xr<niv->tab_murs[i].x_min-EPSILON_COIN || xr>niv->tab_murs[i].x_max+EPSILON_COIN ||
+                yr<niv->tab_murs[i].y_min-EPSILON_COIN || yr>niv->tab_murs[i].y_max+EPSILON_COIN) continue;
+            t_j=temps_mur(&arc,&niv->tab_murs[i],HUGE_VAL,&xj,&yj);
+            coin=(t_j<HUGE_VAL && fabs(xj-xr)<=EPSILON_COIN && fabs(yj-yr)<=EPSILON_COIN);
+        }
+
+        x=xr;
+        y=yr;
+        vx=vx_impact;
+        vy=vy_impact;
+        if (niv->tab_murs[mur].orientation==SEGMENT_VERTICAL || coin){
+            vx=-vx;
+            x+=(vx_impact>0)?-DECALAGE_REBOND:DECALAGE_REBOND;
+        }
+        if (niv->tab_murs[mur].orientation==SEGMENT_HORIZONTAL || coin){
+            vy=-vy;
+            y+=(vy_impact>0)?-DECALAGE_REBOND:DECALAGE_REBOND;
+        }
+        vx*=C_RESTITUTION;
+        vy*=C_RESTITUTION;
+        resultat->nb_rebonds++;
+        t+=t_mur;
+
+        // immobilit: mme pixel au rebond et au sommet de l'arc parcouru
+        bouge=(floor(x)!=px_immobile || floor(y)!=py_immobile);
+        if (arc.phase==PHASE_MONTEE && arc.t_sommet<t_mur && floor(arc.y_sommet)!=py_immobile) bouge=1;
+        if (bouge){
+            px_immobile=floor(x);
+            py_immobile=floor(y);
+            t_immobile=t;
+        }
+        else if (t-t_immobile>=T_IMMOBILE_MAX) break;
+    }
+
+    resultat->temps=fmin(t,T_VOL_MAX);
+    return resultat->touche;
+}
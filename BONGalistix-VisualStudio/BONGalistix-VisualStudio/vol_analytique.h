@@ -0,0 +1,76 @@
+#ifndef VOL_ANALYTIQUE_H
+#define VOL_ANALYTIQUE_H
+
+// -------------------------------------------
+/*
+librairie vol_analytique.h
+Auteurs: Karl-ric Jolicoeur et Franck-Yannick Mbiele Miengue Fosso
+Date: Automne 2021
+Description: Simulation du vol du projectile par vnements, sans pas de temps.
+             Entre deux rebonds, chaque axe du mouvement a une solution exacte:
+             - horizontal (frottement seul): vx(t)=vx0/(1+k|vx0|t)
+             - vertical (frottement et gravit): tangente pendant la monte,
+               tangente hyperbolique (ou cotangente hyperbolique au-del de la
+               vitesse limite) pendant la chute
+             Ces solutions s'inversent aussi exactement: l'instant o le projectile
+             atteint l'abscisse d'un mur vertical ou l'ordonne d'un mur horizontal
+             (ou un bord de la cible) est calcul directement. Le tir passe ainsi
+             d'un rebond au suivant en quelques calculs, sans les centaines de pas
+             de la simulation numrique.
+             Seuls les murs horizontaux et verticaux (ceux des fichiers de niveau)
+             sont pris en charge; un niveau avec un mur oblique doit tre simul
+             par pas (voir simulation.h).
+Note: les implmentations des fonctions se trouvent dans le fichier vol_analytique.c
+*/
+// -------------------------------------------
+
+#include "niveau.h"
+#include "simulation.h"
+
+// ---------------------------------------------
+// constantes du mouvement
+// ---------------------------------------------
+#define K_FROTTEMENT        (C_FROTTEMENT/MASSE)            // acclration de frottement par unit de vitesse au carr
+#define VITESSE_LIMITE      sqrt(GRAVITE/K_FROTTEMENT)      // vitesse de chute o le frottement compense la gravit
+#define PULSATION_CHUTE     sqrt(GRAVITE*K_FROTTEMENT)      // inverse du temps caractristique de la chute
+
+// ---------------------------------------------
+// phases du mouvement vertical au dbut d'un arc de vol
+// ---------------------------------------------
+#define PHASE_MONTEE        0       // le projectile monte (puis redescend aprs le sommet)
+#define PHASE_CHUTE         1       // le projectile descend moins vite que la vitesse limite
+#define PHASE_CHUTE_RAPIDE  2       // le projectile descend plus vite que la vitesse limite
+#define PHASE_LIMITE        3       // le projectile descend  la vitesse limite
+
+// ---------------------------------------------
+// paramtres de la simulation par vnements
+// ---------------------------------------------
+#define VOL_MAX_EVENEMENTS  100000  // nb maximum de rebonds d'un tir, au-del le tir est rat
+#define VOL_T_MIN_EVENEMENT 1e-9    // dure minimum entre deux vnements (s)
+#define VOL_MARGE_CIBLE     1e-7    // tolrance sur la position aux bords de la cible
+
+// ---------------------------------------------
+// arc de vol entre deux rebonds
+// ---------------------------------------------
+typedef struct {
+    double x0,y0;       // position au dbut de l'arc
+    double vx0,vy0;     // vitesse au dbut de l'arc
+    int phase;          // phase du mouvement vertical au dbut de l'arc (PHASE_...)
+    double t_sommet;    // instant du sommet (monte), ou du sommet virtuel d'o serait partie la chute
+    double y_sommet;    // hauteur du sommet rel ou virtuel
+    double psi;         // chute rapide: argument de la cotangente hyperbolique au dbut de l'arc
+} t_arc_vol;
+
+// ---------------------------------------------
+// Prototypes des fonctions de la librairie
+// ---------------------------------------------
+
+void preparer_arc_vol(t_arc_vol* arc, double x0, double y0, double vx0, double vy0);
+void position_arc_vol(t_arc_vol* arc, double t, double* x, double* y, double* vx, double* vy);
+void vol_analytique(double x0, double y0, double vx0, double vy0, double t,
+                    double* x, double* y, double* vx, double* vy);
+
+int niveau_analytique(t_niveau* niv);
+int simuler_tir_analytique(t_niveau* niv, double vx, double vy, t_resultat_tir* resultat);
+
+#endif // VOL_ANALYTIQUE_H